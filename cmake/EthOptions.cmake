@@ -4,6 +4,7 @@ macro(configure_project)
 	# features
 	eth_default_option(COVERAGE OFF)
 	eth_default_option(OSSFUZZ OFF)
+	eth_default_option(BENCHMARKS OFF)
 
 	# components
 	eth_default_option(TESTS ON)
@@ -29,6 +30,7 @@ macro(print_config NAME)
 	message("-- TARGET_PLATFORM  Target platform                          ${CMAKE_SYSTEM_NAME}")
 	message("--------------------------------------------------------------- features")
 	message("-- COVERAGE         Coverage support                         ${COVERAGE}")
+	message("-- BENCHMARKS       Build benchmark tools                    ${BENCHMARKS}")
 	message("------------------------------------------------------------- components")
 if (SUPPORT_TESTS)
 	message("-- TESTS            Build tests                              ${TESTS}")
@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file MappedFile.cpp
+ * Read-only access to the contents of a file without copying them.
+ */
+
+#include <libdevcore/MappedFile.h>
+
+#include <libdevcore/CommonIO.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace dev;
+
+MappedFile::MappedFile(string const& _path)
+{
+#if !defined(_WIN32)
+	int fd = open(_path.c_str(), O_RDONLY);
+	if (fd >= 0)
+	{
+		struct stat status;
+		// The memory after the mapped file up to the end of the page is zero-filled.
+		// If the file ends at a page boundary, there is no such memory and the file is read instead.
+		if (
+			fstat(fd, &status) == 0 &&
+			S_ISREG(status.st_mode) &&
+			status.st_size > 0 &&
+			size_t(status.st_size) % size_t(sysconf(_SC_PAGESIZE)) != 0
+		)
+		{
+			void* mapping = mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapping != MAP_FAILED)
+			{
+				m_mapping = mapping;
+				m_data = static_cast<char const*>(mapping);
+				m_size = size_t(status.st_size);
+			}
+		}
+		close(fd);
+	}
+#endif
+	if (!m_mapping)
+	{
+		m_contents = readFileAsString(_path);
+		m_data = m_contents.c_str();
+		m_size = m_contents.size();
+	}
+}
+
+MappedFile::~MappedFile()
+{
+#if !defined(_WIN32)
+	if (m_mapping)
+		munmap(m_mapping, m_size);
+#endif
+}
@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file MappedFile.h
+ * Read-only access to the contents of a file without copying them.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace dev
+{
+
+/**
+ * Read-only contents of a file, memory-mapped where possible.
+ *
+ * If the file cannot be mapped (or if the platform does not support it), it is read
+ * into memory instead. As with readFileAsString, the contents are empty if the file
+ * does not exist or is not readable.
+ *
+ * The byte after the contents is always readable and zero, so that the contents can
+ * be scanned like a null-terminated string. The file must not be truncated while
+ * it is mapped.
+ */
+class MappedFile: private boost::noncopyable
+{
+public:
+	explicit MappedFile(std::string const& _path);
+	~MappedFile();
+
+	char const* data() const { return m_data; }
+	size_t size() const { return m_size; }
+	bool mapped() const { return m_mapping != nullptr; }
+
+private:
+	void* m_mapping = nullptr;
+	/// Contents of the file if it is not mapped.
+	std::string m_contents;
+	char const* m_data = nullptr;
+	size_t m_size = 0;
+};
+
+}
@@ -0,0 +1,162 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Helper for running independent tasks on multiple threads.
+ */
+
+#include <libdevcore/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+using namespace std;
+using namespace dev;
+
+struct ThreadPool::Job
+{
+	Job(size_t _count, function<void(size_t)> const& _task): count(_count), task(_task) {}
+
+	/// Runs tasks until all indices are taken.
+	void help()
+	{
+		while (!failed)
+		{
+			size_t index = nextIndex++;
+			if (index >= count)
+				break;
+			try
+			{
+				task(index);
+			}
+			catch (...)
+			{
+				lock_guard<mutex> lock(exceptionMutex);
+				if (index < exceptionIndex)
+				{
+					exceptionIndex = index;
+					exception = current_exception();
+				}
+				failed = true;
+			}
+		}
+	}
+
+	size_t const count;
+	function<void(size_t)> const& task;
+	atomic<size_t> nextIndex{0};
+	atomic<bool> failed{false};
+	mutex exceptionMutex;
+	size_t exceptionIndex = count;
+	exception_ptr exception;
+	/// Number of other threads currently running tasks of this job, guarded by the mutex of the pool.
+	size_t helpers = 0;
+};
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_workQueued.notify_all();
+	for (auto& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::parallelFor(size_t _count, size_t _threads, function<void(size_t)> const& _task)
+{
+	_threads = min(_threads, _count);
+	if (_threads <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	Job job(_count, _task);
+	{
+		lock_guard<mutex> lock(m_mutex);
+		for (size_t i = 1; i < _threads; ++i)
+			m_queue.push_back(&job);
+		// The pool only grows to the largest number of threads requested so far. If the
+		// workers are busy, e.g. with tasks that call this function again, the calling
+		// thread runs the tasks on its own.
+		while (m_workers.size() < _threads - 1)
+			m_workers.emplace_back([this]() { work(); });
+	}
+	m_workQueued.notify_all();
+	m_helperFinished.notify_all();
+
+	job.help();
+
+	{
+		// Workers that did not start helping yet are not needed anymore. The ones
+		// that did will find no more indices once their current task is done.
+		// Until then, the calling thread runs tasks of other jobs instead of waiting.
+		unique_lock<mutex> lock(m_mutex);
+		m_queue.erase(remove(m_queue.begin(), m_queue.end(), &job), m_queue.end());
+		while (job.helpers > 0)
+		{
+			if (m_queue.empty())
+				m_helperFinished.wait(lock);
+			else
+				helpWithQueuedJob(lock);
+		}
+	}
+
+	if (job.exception)
+		rethrow_exception(job.exception);
+}
+
+ThreadPool& ThreadPool::shared()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+void ThreadPool::work()
+{
+	unique_lock<mutex> lock(m_mutex);
+	while (true)
+	{
+		m_workQueued.wait(lock, [&]() { return m_stopping || !m_queue.empty(); });
+		if (m_queue.empty())
+			return;
+		helpWithQueuedJob(lock);
+	}
+}
+
+void ThreadPool::helpWithQueuedJob(unique_lock<mutex>& _lock)
+{
+	Job* job = m_queue.front();
+	m_queue.pop_front();
+	++job->helpers;
+
+	_lock.unlock();
+	job->help();
+	_lock.lock();
+
+	if (--job->helpers == 0)
+		m_helperFinished.notify_all();
+}
+
+void dev::parallelFor(size_t _count, size_t _threads, function<void(size_t)> const& _task)
+{
+	ThreadPool::shared().parallelFor(_count, _threads, _task);
+}
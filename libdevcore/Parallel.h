@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Helper for running independent tasks on multiple threads.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Set of worker threads that stay alive between calls to @a parallelFor, so that
+ * threads are not created for each call and thread-local caches are kept.
+ * Calls may be nested and may come from several threads at the same time.
+ */
+class ThreadPool
+{
+public:
+	ThreadPool() = default;
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+	/// Waits for the workers to finish. No call to @a parallelFor may be running.
+	~ThreadPool();
+
+	/// Calls @a _task for all indices from zero to @a _count - 1 on the calling thread and up to
+	/// @a _threads - 1 workers of the pool. Workers are started when they are first needed, the
+	/// pool never has more than the largest @a _threads - 1 requested. Idle threads always pick
+	/// the next index that is not yet taken, so long tasks do not block the remaining ones.
+	/// Runs everything on the calling thread if @a _threads is at most one. While the calling
+	/// thread waits for workers to finish their tasks, it runs queued tasks of other calls.
+	/// If tasks throw, the remaining indices are skipped and the exception of the task
+	/// with the smallest index is rethrown once all threads have finished.
+	void parallelFor(size_t _count, size_t _threads, std::function<void(size_t)> const& _task);
+
+	/// @returns the pool used by the free function @a parallelFor.
+	static ThreadPool& shared();
+
+private:
+	struct Job;
+
+	void work();
+	/// Takes the first job from the queue and runs its tasks. @a _lock is released meanwhile.
+	void helpWithQueuedJob(std::unique_lock<std::mutex>& _lock);
+
+	std::mutex m_mutex;
+	/// Notified when work is queued or the pool shuts down.
+	std::condition_variable m_workQueued;
+	/// Notified when a thread stops helping with a job or work is queued.
+	std::condition_variable m_helperFinished;
+	/// One entry for every worker requested by a job that has not yet started helping.
+	std::deque<Job*> m_queue;
+	bool m_stopping = false;
+	std::vector<std::thread> m_workers;
+};
+
+/// Runs @a ThreadPool::parallelFor on the shared pool.
+void parallelFor(size_t _count, size_t _threads, std::function<void(size_t)> const& _task);
+
+}
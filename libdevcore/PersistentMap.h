@@ -0,0 +1,316 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Map whose copies share their structure.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Map implemented as a hash array mapped trie whose nodes are shared between copies.
+ *
+ * Copying a map takes constant time. A modification copies only the nodes on the path
+ * to the modified entry that are shared with other maps, so that maps derived from the
+ * same map keep sharing everything they did not modify. Merging such maps skips the
+ * shared parts.
+ *
+ * @a Hash has to return 64-bit hashes. The entries are visited in the order of their
+ * hashes and entries with equal hashes in the order of their keys.
+ */
+template <class K, class V, class Hash>
+class PersistentMap
+{
+public:
+	bool empty() const { return !m_root; }
+	void clear() { m_root.reset(); }
+
+	/// @returns the value of @a _key or nullptr if there is none.
+	V const* find(K const& _key) const
+	{
+		std::uint64_t const hash = Hash{}(_key);
+		Node const* node = m_root.get();
+		for (unsigned level = 0; node; ++level)
+		{
+			if (node->isLeaf())
+			{
+				if (node->hash != hash)
+					return nullptr;
+				auto it = node->findEntry(_key);
+				return it == node->entries.end() ? nullptr : &it->second;
+			}
+			unsigned const slot = slotOf(hash, level);
+			if (!node->hasChild(slot))
+				return nullptr;
+			node = node->child(slot).get();
+		}
+		return nullptr;
+	}
+
+	/// @returns the value of @a _key, which is default-constructed first if there is none.
+	/// The reference is invalidated by copying or modifying the map.
+	V& operator[](K const& _key)
+	{
+		std::uint64_t const hash = Hash{}(_key);
+		if (!m_root)
+			m_root = std::make_shared<Node>();
+		NodePtr* current = &m_root;
+		for (unsigned level = 0; ; ++level)
+		{
+			Node& node = unshare(*current);
+			unsigned const slot = slotOf(hash, level);
+			if (!node.hasChild(slot))
+			{
+				auto leaf = std::make_shared<Node>();
+				leaf->hash = hash;
+				leaf->entries.emplace_back(_key, V{});
+				node.insertChild(slot, leaf);
+				return leaf->entries.front().second;
+			}
+			NodePtr& child = node.child(slot);
+			if (child->isLeaf())
+			{
+				if (child->hash == hash)
+				{
+					Node& leaf = unshare(child);
+					auto it = leaf.findEntry(_key);
+					if (it == leaf.entries.end())
+						it = leaf.entries.emplace(
+							std::upper_bound(
+								leaf.entries.begin(),
+								leaf.entries.end(),
+								_key,
+								[](K const& _a, std::pair<K, V> const& _b) { return _a < _b.first; }
+							),
+							_key,
+							V{}
+						);
+					return it->second;
+				}
+				// Move the leaf one level down to make room for the new entry next to it.
+				child = wrap(child, level + 1);
+			}
+			current = &child;
+		}
+	}
+
+	void erase(K const& _key)
+	{
+		if (find(_key))
+		{
+			eraseFrom(m_root, Hash{}(_key), _key, 0);
+			if (m_root->children.empty())
+				m_root.reset();
+		}
+	}
+
+	/// Calls @a _visitor with the key and value of every entry.
+	template <class F>
+	void forEach(F&& _visitor) const
+	{
+		if (m_root)
+			forEachIn(*m_root, _visitor);
+	}
+
+	/// Adds the entries of @a _other whose keys are not in this map and calls
+	/// @a _join(ownValue, otherValue) for the keys that are in both maps.
+	/// Parts of the maps that are shared are not visited, so @a _join has to leave the value
+	/// unchanged if both values are equal.
+	template <class F>
+	void merge(PersistentMap const& _other, F&& _join)
+	{
+		if (!m_root)
+			m_root = _other.m_root;
+		else if (_other.m_root)
+			mergeInto(m_root, _other.m_root, 0, _join);
+	}
+
+private:
+	static constexpr unsigned c_bitsPerLevel = 4;
+	static constexpr std::uint64_t c_slotMask = (1 << c_bitsPerLevel) - 1;
+
+	struct Node;
+	using NodePtr = std::shared_ptr<Node>;
+
+	/// A leaf holds the entries whose keys have the same hash, an inner node the children
+	/// for the next c_bitsPerLevel bits of the hash that occur.
+	struct Node
+	{
+		std::uint64_t hash = 0;
+		/// Entries of a leaf, ordered by key.
+		std::vector<std::pair<K, V>> entries;
+		/// Bit i is set if there is a child for the value i of the bits of this level.
+		std::uint32_t childSlots = 0;
+		std::vector<NodePtr> children;
+
+		bool isLeaf() const { return !entries.empty(); }
+		bool hasChild(unsigned _slot) const { return childSlots & (1u << _slot); }
+		size_t position(unsigned _slot) const
+		{
+			return std::bitset<32>(childSlots & ((1u << _slot) - 1)).count();
+		}
+		NodePtr const& child(unsigned _slot) const { return children[position(_slot)]; }
+		NodePtr& child(unsigned _slot) { return children[position(_slot)]; }
+		void insertChild(unsigned _slot, NodePtr _child)
+		{
+			children.insert(children.begin() + position(_slot), std::move(_child));
+			childSlots |= 1u << _slot;
+		}
+		void eraseChild(unsigned _slot)
+		{
+			children.erase(children.begin() + position(_slot));
+			childSlots &= ~(1u << _slot);
+		}
+		typename std::vector<std::pair<K, V>>::const_iterator findEntry(K const& _key) const
+		{
+			return std::find_if(entries.begin(), entries.end(), [&](std::pair<K, V> const& _entry) {
+				return !(_entry.first < _key) && !(_key < _entry.first);
+			});
+		}
+		typename std::vector<std::pair<K, V>>::iterator findEntry(K const& _key)
+		{
+			return std::find_if(entries.begin(), entries.end(), [&](std::pair<K, V> const& _entry) {
+				return !(_entry.first < _key) && !(_key < _entry.first);
+			});
+		}
+	};
+
+	static unsigned slotOf(std::uint64_t _hash, unsigned _level)
+	{
+		return unsigned((_hash >> (64 - c_bitsPerLevel * (_level + 1))) & c_slotMask);
+	}
+
+	/// Replaces @a _node by a copy if it is shared with other maps.
+	/// @returns the node that can be modified.
+	static Node& unshare(NodePtr& _node)
+	{
+		if (_node.use_count() != 1)
+			_node = std::make_shared<Node>(*_node);
+		return *_node;
+	}
+
+	/// @returns an inner node at @a _level that contains only @a _leaf.
+	static NodePtr wrap(NodePtr _leaf, unsigned _level)
+	{
+		auto node = std::make_shared<Node>();
+		unsigned const slot = slotOf(_leaf->hash, _level);
+		node->insertChild(slot, std::move(_leaf));
+		return node;
+	}
+
+	static void eraseFrom(NodePtr& _node, std::uint64_t _hash, K const& _key, unsigned _level)
+	{
+		Node& node = unshare(_node);
+		unsigned const slot = slotOf(_hash, _level);
+		NodePtr& child = node.child(slot);
+		if (child->isLeaf())
+		{
+			if (child->entries.size() == 1)
+				node.eraseChild(slot);
+			else
+			{
+				Node& leaf = unshare(child);
+				leaf.entries.erase(leaf.findEntry(_key));
+			}
+		}
+		else
+		{
+			eraseFrom(child, _hash, _key, _level + 1);
+			if (child->children.empty())
+				node.eraseChild(slot);
+		}
+	}
+
+	template <class F>
+	static void forEachIn(Node const& _node, F& _visitor)
+	{
+		if (_node.isLeaf())
+			for (auto const& entry: _node.entries)
+				_visitor(entry.first, entry.second);
+		else
+			for (auto const& child: _node.children)
+				forEachIn(*child, _visitor);
+	}
+
+	/// Merges the inner node @a _source into the inner node @a _target, both at @a _level.
+	template <class F>
+	static void mergeInto(NodePtr& _target, NodePtr const& _source, unsigned _level, F& _join)
+	{
+		if (_target == _source)
+			return;
+		Node& target = unshare(_target);
+		for (unsigned slot = 0; slot <= c_slotMask; ++slot)
+		{
+			if (!_source->hasChild(slot))
+				continue;
+			NodePtr const& sourceChild = _source->child(slot);
+			if (!target.hasChild(slot))
+			{
+				target.insertChild(slot, sourceChild);
+				continue;
+			}
+			NodePtr& targetChild = target.child(slot);
+			if (targetChild == sourceChild)
+				continue;
+			if (targetChild->isLeaf() && sourceChild->isLeaf() && targetChild->hash == sourceChild->hash)
+			{
+				Node& leaf = unshare(targetChild);
+				for (auto const& entry: sourceChild->entries)
+				{
+					auto it = leaf.findEntry(entry.first);
+					if (it != leaf.entries.end())
+						_join(it->second, entry.second);
+					else
+						leaf.entries.insert(
+							std::upper_bound(
+								leaf.entries.begin(),
+								leaf.entries.end(),
+								entry,
+								[](std::pair<K, V> const& _a, std::pair<K, V> const& _b) { return _a.first < _b.first; }
+							),
+							entry
+						);
+				}
+			}
+			else
+			{
+				if (targetChild->isLeaf())
+					targetChild = wrap(targetChild, _level + 1);
+				mergeInto(
+					targetChild,
+					sourceChild->isLeaf() ? wrap(sourceChild, _level + 1) : sourceChild,
+					_level + 1,
+					_join
+				);
+			}
+		}
+	}
+
+	/// Root node, an inner node with at least one child or null if the map is empty.
+	NodePtr m_root;
+};
+
+}
@@ -25,11 +25,89 @@
 
 #include <libdevcore/Assertions.h>
 
-#include <boost/regex.hpp>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
 
+struct Whiskers::Parsed
+{
+	struct Part
+	{
+		enum class Kind { Text, Tag, List };
+		Kind kind;
+		/// The text or the name of the tag or list.
+		string value;
+		/// Contents of a list.
+		unique_ptr<Parsed> body;
+	};
+
+	string text;
+	vector<Part> parts;
+
+	explicit Parsed(string _text);
+};
+
+namespace
+{
+
+/// @returns the end of a tag `<name>` starting at @a _pos, where the name must not contain
+/// any of `#`, `/` and `>`, or string::npos if there is no such tag.
+size_t tagEnd(string const& _text, size_t _pos)
+{
+	size_t nameEnd = _text.find_first_of("#/>", _pos + 1);
+	if (nameEnd == string::npos || nameEnd == _pos + 1 || _text[nameEnd] != '>')
+		return string::npos;
+	return nameEnd + 1;
+}
+
+}
+
+Whiskers::Parsed::Parsed(string _text):
+	text(move(_text))
+{
+	size_t textStart = 0;
+	size_t pos = 0;
+	auto addPart = [&](Part::Kind _kind, string _value, unique_ptr<Parsed> _body, size_t _end)
+	{
+		if (pos > textStart)
+			parts.push_back(Part{Part::Kind::Text, text.substr(textStart, pos - textStart), nullptr});
+		parts.push_back(Part{_kind, move(_value), move(_body)});
+		textStart = pos = _end;
+	};
+	while ((pos = text.find('<', pos)) != string::npos)
+	{
+		size_t end = tagEnd(text, pos);
+		if (end != string::npos)
+		{
+			addPart(Part::Kind::Tag, text.substr(pos + 1, end - pos - 2), nullptr, end);
+			continue;
+		}
+		// A list `<#name>body</name>` with the shortest possible body.
+		if (pos + 1 < text.size() && text[pos + 1] == '#')
+		{
+			size_t nameEnd = text.find('>', pos + 2);
+			if (nameEnd != string::npos && nameEnd > pos + 2)
+			{
+				string name = text.substr(pos + 2, nameEnd - pos - 2);
+				size_t bodyEnd = text.find("</" + name + ">", nameEnd + 1);
+				if (bodyEnd != string::npos)
+				{
+					size_t listEnd = bodyEnd + name.size() + 3;
+					auto body = make_unique<Parsed>(text.substr(nameEnd + 1, bodyEnd - nameEnd - 1));
+					addPart(Part::Kind::List, move(name), move(body), listEnd);
+					continue;
+				}
+			}
+		}
+		pos++;
+	}
+	pos = text.size();
+	if (pos > textStart)
+		parts.push_back(Part{Part::Kind::Text, text.substr(textStart), nullptr});
+}
+
 Whiskers::Whiskers(string const& _template):
 m_template(_template)
 {
@@ -74,60 +152,87 @@ Whiskers& Whiskers::operator ()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_listParameters);
+	string result;
+	result.reserve(m_template.size());
+	render(result, *parse(m_template), m_parameters, nullptr, &m_listParameters);
+	return result;
+}
+
+shared_ptr<Whiskers::Parsed const> Whiskers::parse(string const& _template)
+{
+	// Templates are mostly string literals, so the number of distinct templates is small.
+	static size_t const maxCacheSize = 4096;
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Parsed const>> cache;
+
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		auto it = cache.find(_template);
+		if (it != cache.end())
+			return it->second;
+	}
+	auto parsed = make_shared<Parsed const>(_template);
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() >= maxCacheSize)
+		cache.clear();
+	cache.emplace(_template, parsed);
+	return parsed;
 }
 
-string Whiskers::replace(
-	string const& _template,
+void Whiskers::render(
+	string& _output,
+	Parsed const& _parsed,
 	StringMap const& _parameters,
-	map<string, vector<StringMap>> const& _listParameters
+	StringMap const* _listItem,
+	StringListMap const* _listParameters
 )
 {
-	using namespace boost;
-	static regex listOrTag("<([^#/>]+)>|<#([^>]+)>(.*?)</\\2>");
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		if (!tagName.empty())
+	for (auto const& part: _parsed.parts)
+		switch (part.kind)
+		{
+		case Parsed::Part::Kind::Text:
+			_output += part.value;
+			break;
+		case Parsed::Part::Kind::Tag:
 		{
+			if (_listItem)
+			{
+				auto it = _listItem->find(part.value);
+				if (it != _listItem->end())
+				{
+					_output += it->second;
+					break;
+				}
+			}
+			auto it = _parameters.find(part.value);
 			assertThrow(
-				_parameters.count(tagName),
+				it != _parameters.end(),
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + part.value + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_parsed.text
 			);
-			return _parameters.at(tagName);
+			_output += it->second;
+			break;
 		}
-		else
+		case Parsed::Part::Kind::List:
 		{
-			string listName(_match[2]);
-			string templ(_match[3]);
-			assertThrow(!listName.empty(), WhiskersError, "");
+			auto list = _listParameters ? _listParameters->find(part.value) : StringListMap::const_iterator{};
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				_listParameters && list != _listParameters->end(),
+				WhiskersError, "List parameter " + part.value + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters));
-			return replacement;
+			for (auto const& item: list->second)
+			{
+				for (auto const& parameter: item)
+					assertThrow(
+						!_parameters.count(parameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				render(_output, *part.body, _parameters, &item, nullptr);
+			}
+			break;
+		}
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
 }
-
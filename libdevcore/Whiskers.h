@@ -27,6 +27,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace dev
@@ -51,6 +52,8 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
 /// results in s == "HEAD\nkey1 -> value1\nkey2 -> value2\n"
 ///
 /// Note that lists cannot themselves contain lists - this would be a future feature.
+///
+/// Templates are parsed once and the parsed form is shared by all instances with the same template.
 class Whiskers
 {
 public:
@@ -70,15 +73,22 @@ public:
 	std::string render() const;
 
 private:
-	static std::string replace(
-		std::string const& _template,
+	/// Template split into literal text, tags and lists.
+	struct Parsed;
+
+	/// @returns the parsed form of @a _template, parsing it only if it was not seen before.
+	static std::shared_ptr<Parsed const> parse(std::string const& _template);
+
+	/// Appends @a _parsed to @a _output, where tags are looked up in @a _listItem (if given)
+	/// and then in @a _parameters. Lists can only be expanded if @a _listParameters is given.
+	static void render(
+		std::string& _output,
+		Parsed const& _parsed,
 		StringMap const& _parameters,
-		StringListMap const& _listParameters = StringListMap()
+		StringMap const* _listItem,
+		StringListMap const* _listParameters
 	);
 
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
 	std::string m_template;
 	StringMap m_parameters;
 	StringListMap m_listParameters;
@@ -28,6 +28,7 @@
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/SemanticInformation.h>
 
 #include <fstream>
 #include <json/json.h>
@@ -408,6 +409,10 @@ map<u256, u256> Assembly::optimiseInternal(
 	}
 
 	map<u256, u256> tagReplacements;
+	// Blocks the CSE did not improve, together with the msize setting they were analysed with.
+	// The CSE only looks at a single block, so it does not have to analyse them again.
+	set<AssemblyItems> blocksNotImprovedByCSE;
+	bool blocksAnalysedWithMSize = false;
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
 	{
@@ -423,11 +428,8 @@ map<u256, u256> Assembly::optimiseInternal(
 		if (_settings.runPeephole)
 		{
 			PeepholeOptimiser peepOpt{m_items};
-			while (peepOpt.optimise())
-			{
+			if (peepOpt.optimise())
 				count++;
-				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
-			}
 		}
 
 		// This only modifies PushTags, we have to run again to actually remove code.
@@ -464,10 +466,28 @@ map<u256, u256> Assembly::optimiseInternal(
 			AssemblyItems optimisedItems;
 
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
+			if (usesMSize != blocksAnalysedWithMSize)
+			{
+				blocksNotImprovedByCSE.clear();
+				blocksAnalysedWithMSize = usesMSize;
+			}
 
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
+				auto blockEnd = find_if(iter, m_items.end(), [&](AssemblyItem const& _item) {
+					return SemanticInformation::breaksCSEAnalysisBlock(_item, usesMSize);
+				});
+				if (blockEnd != m_items.end())
+					++blockEnd;
+				AssemblyItems block(iter, blockEnd);
+				if (blocksNotImprovedByCSE.count(block))
+				{
+					optimisedItems += block;
+					iter = blockEnd;
+					continue;
+				}
+
 				KnownState emptyState;
 				CommonSubexpressionEliminator eliminator{emptyState};
 				auto orig = iter;
@@ -496,7 +516,10 @@ map<u256, u256> Assembly::optimiseInternal(
 					optimisedItems += optimisedChunk;
 				}
 				else
+				{
 					copy(orig, iter, back_inserter(optimisedItems));
+					blocksNotImprovedByCSE.insert(std::move(block));
+				}
 			}
 			if (optimisedItems.size() < m_items.size())
 			{
@@ -517,6 +540,14 @@ map<u256, u256> Assembly::optimiseInternal(
 	return tagReplacements;
 }
 
+shared_ptr<Assembly> Assembly::deepCopy() const
+{
+	auto copy = make_shared<Assembly>(*this);
+	for (auto& sub: copy->m_subs)
+		sub = sub->deepCopy();
+	return copy;
+}
+
 LinkerObject const& Assembly::assemble() const
 {
 	if (!m_assembledObject.bytecode.empty())
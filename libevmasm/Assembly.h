@@ -99,6 +99,10 @@ public:
 	/// Assembles the assembly into bytecode. The assembly should not be modified after this call, since the assembled version is cached.
 	LinkerObject const& assemble() const;
 
+	/// @returns a copy of this assembly that refers to copies of the sub-assemblies, so that
+	/// it can be optimised without modifying this assembly. The assembled version is copied, too.
+	std::shared_ptr<Assembly> deepCopy() const;
+
 	struct OptimiserSettings
 	{
 		bool isCreation = false;
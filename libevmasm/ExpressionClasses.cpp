@@ -25,6 +25,7 @@
 #include <utility>
 #include <tuple>
 #include <functional>
+#include <boost/functional/hash.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/noncopyable.hpp>
 #include <libevmasm/Assembly.h>
@@ -36,6 +37,15 @@ using namespace dev;
 using namespace dev::eth;
 using namespace langutil;
 
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
+{
+	assertThrow(!!item && !!_other.item, OptimizerException, "");
+	return
+		*item == *_other.item &&
+		arguments == _other.arguments &&
+		sequenceNumber == _other.sequenceNumber;
+}
+
 bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression const& _other) const
 {
 	assertThrow(!!item && !!_other.item, OptimizerException, "");
@@ -55,6 +65,19 @@ bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression cons
 			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
 }
 
+size_t ExpressionClasses::ExpressionHash::operator()(Expression const& _expression) const
+{
+	assertThrow(!!_expression.item, OptimizerException, "");
+	size_t seed = size_t(_expression.item->type());
+	if (_expression.item->type() == Operation)
+		boost::hash_combine(seed, size_t(_expression.item->instruction()));
+	else
+		boost::hash_combine(seed, _expression.item->data());
+	boost::hash_range(seed, _expression.arguments.begin(), _expression.arguments.end());
+	boost::hash_combine(seed, _expression.sequenceNumber);
+	return seed;
+}
+
 ExpressionClasses::Id ExpressionClasses::find(
 	AssemblyItem const& _item,
 	Ids const& _arguments,
@@ -160,8 +183,8 @@ u256 const* ExpressionClasses::knownConstant(Id _c)
 
 AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
 {
-	m_spareAssemblyItems.push_back(make_shared<AssemblyItem>(_item));
-	return m_spareAssemblyItems.back().get();
+	m_spareAssemblyItems.push_back(_item);
+	return &m_spareAssemblyItems.back();
 }
 
 string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
@@ -183,7 +206,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules store their match groups while matching and thus cannot be shared between threads.
+	static thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
@@ -26,10 +26,13 @@
 #include <libdevcore/Common.h>
 #include <libevmasm/AssemblyItem.h>
 
+#include <boost/noncopyable.hpp>
+
+#include <deque>
 #include <vector>
 #include <map>
 #include <memory>
-#include <set>
+#include <unordered_set>
 
 namespace langutil
 {
@@ -48,7 +51,7 @@ struct ExpressionTemplate;
  * Collection of classes of equivalent expressions that can also determine the class of an expression.
  * Identifiers are contiguously assigned to new classes starting from zero.
  */
-class ExpressionClasses
+class ExpressionClasses: boost::noncopyable
 {
 public:
 	using Id = unsigned;
@@ -62,9 +65,16 @@ public:
 		/// Storage modification sequence, only used for storage and memory operations.
 		unsigned sequenceNumber = 0;
 		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
+		bool operator==(Expression const& _other) const;
 		bool operator<(Expression const& _other) const;
 	};
 
+	/// Hash function compatible with Expression::operator==.
+	struct ExpressionHash
+	{
+		std::size_t operator()(Expression const& _expression) const;
+	};
+
 	/// Retrieves the id of the expression equivalence class resulting from the given item applied to the
 	/// given classes, might also create a new one.
 	/// @param _copyItem if true, copies the assembly item to an internal storage instead of just
@@ -123,8 +133,9 @@ private:
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
-	std::set<Expression> m_expressions;
-	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
+	std::unordered_set<Expression, ExpressionHash> m_expressions;
+	/// Items copied by storeItem. A deque does not move its elements when it grows.
+	std::deque<AssemblyItem> m_spareAssemblyItems;
 };
 
 }
@@ -24,6 +24,10 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <algorithm>
+#include <array>
+#include <numeric>
+
 using namespace std;
 using namespace dev::eth;
 using namespace dev;
@@ -33,11 +37,43 @@ using namespace dev;
 namespace
 {
 
+/// Marks the end of the list of items.
+size_t constexpr c_noItem = size_t(-1);
+/// Largest number of items any of the rules apart from UnreachableCode looks at.
+size_t constexpr c_maxWindowSize = 4;
+
+/// The items being optimised, kept in a doubly linked list, so that the items matched
+/// by a rule can be replaced in place.
 struct OptimiserState
 {
-	AssemblyItems const& items;
-	size_t i;
-	std::back_insert_iterator<AssemblyItems> out;
+	/// All nodes of the list, both the original items and the ones produced by the rules.
+	AssemblyItems items;
+	std::vector<size_t> next;
+	std::vector<size_t> prev;
+	std::vector<bool> removed;
+	/// Last pass for which the node was added to the positions to look at.
+	std::vector<size_t> candidateInPass;
+	size_t first = c_noItem;
+
+	/// Nodes starting at the current position, up to c_maxWindowSize of them.
+	std::array<size_t, c_maxWindowSize> window;
+	size_t windowSize = 0;
+	/// Number of items consumed by the rule that matched and the items it produced.
+	size_t consumed = 0;
+	AssemblyItems output;
+	std::back_insert_iterator<AssemblyItems> out{output};
+
+	AssemblyItem const& windowItem(size_t _i) const { return items[window[_i]]; }
+
+	size_t append(AssemblyItem _item)
+	{
+		items.emplace_back(std::move(_item));
+		next.push_back(c_noItem);
+		prev.push_back(c_noItem);
+		removed.push_back(false);
+		candidateInPass.push_back(0);
+		return items.size() - 1;
+	}
 };
 
 template <class Method, size_t Arguments>
@@ -47,33 +83,39 @@ struct ApplyRule
 template <class Method>
 struct ApplyRule<Method, 4>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(OptimiserState& _state)
 	{
-		return Method::applySimple(_in[0], _in[1], _in[2], _in[3], _out);
+		return Method::applySimple(
+			_state.windowItem(0),
+			_state.windowItem(1),
+			_state.windowItem(2),
+			_state.windowItem(3),
+			_state.out
+		);
 	}
 };
 template <class Method>
 struct ApplyRule<Method, 3>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(OptimiserState& _state)
 	{
-		return Method::applySimple(_in[0], _in[1], _in[2], _out);
+		return Method::applySimple(_state.windowItem(0), _state.windowItem(1), _state.windowItem(2), _state.out);
 	}
 };
 template <class Method>
 struct ApplyRule<Method, 2>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(OptimiserState& _state)
 	{
-		return Method::applySimple(_in[0], _in[1], _out);
+		return Method::applySimple(_state.windowItem(0), _state.windowItem(1), _state.out);
 	}
 };
 template <class Method>
 struct ApplyRule<Method, 1>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(OptimiserState& _state)
 	{
-		return Method::applySimple(_in[0], _out);
+		return Method::applySimple(_state.windowItem(0), _state.out);
 	}
 };
 
@@ -83,11 +125,11 @@ struct SimplePeepholeOptimizerMethod
 	static bool apply(OptimiserState& _state)
 	{
 		if (
-			_state.i + WindowSize <= _state.items.size() &&
-			ApplyRule<Method, WindowSize>::applyRule(_state.items.begin() + _state.i, _state.out)
+			WindowSize <= _state.windowSize &&
+			ApplyRule<Method, WindowSize>::applyRule(_state)
 		)
 		{
-			_state.i += WindowSize;
+			_state.consumed = WindowSize;
 			return true;
 		}
 		else
@@ -95,15 +137,6 @@ struct SimplePeepholeOptimizerMethod
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
-{
-	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		*_out = _item;
-		return true;
-	}
-};
-
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
 {
 	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
@@ -303,27 +336,30 @@ struct UnreachableCode
 {
 	static bool apply(OptimiserState& _state)
 	{
-		auto it = _state.items.begin() + _state.i;
-		auto end = _state.items.end();
-		if (it == end)
+		if (_state.windowSize == 0)
 			return false;
+		AssemblyItem const& item = _state.windowItem(0);
 		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
+			item != Instruction::JUMP &&
+			item != Instruction::RETURN &&
+			item != Instruction::STOP &&
+			item != Instruction::INVALID &&
+			item != Instruction::SELFDESTRUCT &&
+			item != Instruction::REVERT
 		)
 			return false;
 
 		size_t i = 1;
-		while (it + i != end && it[i].type() != Tag)
+		for (
+			size_t node = _state.next[_state.window[0]];
+			node != c_noItem && _state.items[node].type() != Tag;
+			node = _state.next[node]
+		)
 			i++;
 		if (i > 1)
 		{
-			*_state.out = it[0];
-			_state.i += i;
+			*_state.out = item;
+			_state.consumed = i;
 			return true;
 		}
 		else
@@ -331,45 +367,161 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+bool applyMethods(OptimiserState&)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	return false;
 }
 
 template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+bool applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return Method::apply(_state) || applyMethods(_state, _other...);
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+/// Items consumed by a rule, together with their neighbours at the time they were replaced.
+struct Replacement
+{
+	size_t before;
+	size_t first;
+	size_t last;
+	size_t after;
+};
+
+void link(OptimiserState& _state, size_t _from, size_t _to)
 {
-	return std::count(_items.begin(), _items.end(), Instruction::POP);
+	if (_from == c_noItem)
+		_state.first = _to;
+	else
+		_state.next[_from] = _to;
+	if (_to != c_noItem)
+		_state.prev[_to] = _from;
 }
 
 }
 
 bool PeepholeOptimiser::optimise()
 {
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
-	if (m_optimisedItems.size() < m_items.size() || (
-		m_optimisedItems.size() == m_items.size() && (
-			eth::bytesRequired(m_optimisedItems, 3) < eth::bytesRequired(m_items, 3) ||
-			numberOfPops(m_optimisedItems) > numberOfPops(m_items)
+	size_t const numberOfItems = m_items.size();
+	OptimiserState state;
+	state.items = std::move(m_items);
+	state.next.resize(numberOfItems);
+	state.prev.resize(numberOfItems);
+	state.removed.resize(numberOfItems, false);
+	state.candidateInPass.resize(numberOfItems, 0);
+	for (size_t i = 0; i < numberOfItems; ++i)
+	{
+		state.next[i] = i + 1 < numberOfItems ? i + 1 : c_noItem;
+		state.prev[i] = i > 0 ? i - 1 : c_noItem;
+	}
+	state.first = numberOfItems > 0 ? 0 : c_noItem;
+
+	// Every pass applies the rules from left to right, consuming the matched items, and
+	// is only kept if it improves the code. Since the rules only look at the items following
+	// their position, a pass can only match at the items produced by the previous pass and
+	// at the few items in front of them, so all other positions are skipped.
+	std::vector<size_t> candidates(numberOfItems);
+	std::iota(candidates.begin(), candidates.end(), 0);
+	bool changed = false;
+	for (size_t pass = 1; !candidates.empty(); ++pass)
+	{
+		assertThrow(pass < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
+		std::vector<Replacement> replacements;
+		std::vector<size_t> nextCandidates;
+		ptrdiff_t itemsDifference = 0;
+		ptrdiff_t bytesDifference = 0;
+		ptrdiff_t popsDifference = 0;
+		auto account = [&](AssemblyItem const& _item, ptrdiff_t _sign) {
+			itemsDifference += _sign;
+			bytesDifference += _sign * ptrdiff_t(_item.bytesRequired(3));
+			if (_item == Instruction::POP)
+				popsDifference += _sign;
+		};
+		auto addCandidate = [&](size_t _node) {
+			state.candidateInPass[_node] = pass;
+			nextCandidates.push_back(_node);
+		};
+
+		for (size_t node: candidates)
+		{
+			if (state.removed[node])
+				continue;
+			state.windowSize = 0;
+			for (size_t n = node; n != c_noItem && state.windowSize < c_maxWindowSize; n = state.next[n])
+				state.window[state.windowSize++] = n;
+			state.output.clear();
+			if (!applyMethods(
+				state,
+				PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
+				IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
+				TagConjunctions(), TruthyAnd()
+			))
+				continue;
+
+			Replacement replacement{state.prev[node], node, node, c_noItem};
+			for (size_t i = 0; i < state.consumed; ++i)
+			{
+				if (i > 0)
+					replacement.last = state.next[replacement.last];
+				account(state.items[replacement.last], -1);
+				state.removed[replacement.last] = true;
+			}
+			replacement.after = state.next[replacement.last];
+			replacements.push_back(replacement);
+
+			size_t const firstProduced = state.items.size();
+			size_t previous = replacement.before;
+			for (AssemblyItem& item: state.output)
+			{
+				account(item, 1);
+				size_t produced = state.append(std::move(item));
+				link(state, previous, produced);
+				previous = produced;
+			}
+			link(state, previous, replacement.after);
+
+			size_t const firstCandidate = nextCandidates.size();
+			size_t n = replacement.before;
+			for (size_t i = 1; i < c_maxWindowSize && n != c_noItem && state.candidateInPass[n] != pass; ++i)
+			{
+				addCandidate(n);
+				n = state.prev[n];
+			}
+			std::reverse(nextCandidates.begin() + firstCandidate, nextCandidates.end());
+			for (size_t produced = firstProduced; produced < state.items.size(); ++produced)
+				addCandidate(produced);
+		}
+
+		if (
+			itemsDifference < 0 ||
+			(itemsDifference == 0 && (bytesDifference < 0 || popsDifference > 0))
 		)
-	))
+		{
+			changed = true;
+			candidates = std::move(nextCandidates);
+		}
+		else
+		{
+			for (auto it = replacements.rbegin(); it != replacements.rend(); ++it)
+			{
+				link(state, it->before, it->first);
+				link(state, it->last, it->after);
+				for (size_t n = it->first; n != it->after; n = state.next[n])
+					state.removed[n] = false;
+			}
+			break;
+		}
+	}
+
+	if (changed)
 	{
-		m_items = std::move(m_optimisedItems);
-		return true;
+		m_items.clear();
+		for (size_t n = state.first; n != c_noItem; n = state.next[n])
+			m_items.emplace_back(std::move(state.items[n]));
 	}
 	else
-		return false;
+	{
+		state.items.erase(state.items.begin() + numberOfItems, state.items.end());
+		m_items = std::move(state.items);
+	}
+	return changed;
 }
@@ -45,11 +45,12 @@ public:
 	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Applies the rules repeatedly until they do not improve the code anymore.
+	/// @returns true if the items were changed.
 	bool optimise();
 
 private:
 	AssemblyItems& m_items;
-	AssemblyItems m_optimisedItems;
 };
 
 }
@@ -0,0 +1,145 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Index that selects the simplification rules that can match an expression.
+ */
+
+#pragma once
+
+#include <libevmasm/Instruction.h>
+#include <libevmasm/SimplificationRule.h>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+
+/**
+ * Coarse shape of an operand: a specific operation, a constant or anything else.
+ * For patterns, "anything" matches all shapes.
+ */
+class OperandShape
+{
+public:
+	/// Creates the shape "anything".
+	OperandShape() = default;
+	static OperandShape any() { return OperandShape(0); }
+	static OperandShape constant() { return OperandShape(1); }
+	static OperandShape operation(Instruction _instruction) { return OperandShape(2 + uint8_t(_instruction)); }
+
+	bool operator==(OperandShape const& _other) const { return m_value == _other.m_value; }
+	bool isAny() const { return m_value == 0; }
+	/// @returns true if a pattern operand of this shape can match an expression operand of shape @a _shape.
+	bool admits(OperandShape const& _shape) const { return isAny() || *this == _shape; }
+
+private:
+	explicit OperandShape(uint16_t _value): m_value(_value) {}
+	uint16_t m_value = 0;
+};
+
+/**
+ * Simplification rules indexed by the instruction at the root of their pattern and the shapes
+ * of its operands, shared by the libevmasm and Yul simplifiers.
+ *
+ * For each root instruction, the rules are grouped by the shape of their first operand, so that
+ * only rules whose first operand can match are considered. The shapes of the remaining operands
+ * are compared before a rule is tried. The order of the rules is kept, so the first rule that
+ * matches is the same as without the index.
+ */
+template <class Pattern>
+class SimplificationRuleIndex
+{
+public:
+	static size_t constexpr c_maxOperands = 3;
+	using Rule = SimplificationRule<Pattern>;
+	using Shapes = std::array<OperandShape, c_maxOperands>;
+
+	/// Adds @a _rule, whose pattern has @a _root at the root and operands of shapes @a _operands.
+	/// Missing operands have to be "any".
+	void add(Instruction _root, Rule _rule, Shapes const& _operands)
+	{
+		RulesForInstruction& rules = m_rules[uint8_t(_root)];
+		size_t index = rules.rules.size();
+		rules.rules.emplace_back(std::move(_rule), _operands);
+		if (_operands[0].isAny())
+		{
+			rules.anyFirstOperand.push_back(index);
+			for (auto& candidates: rules.byFirstOperand)
+				candidates.second.push_back(index);
+		}
+		else
+			candidatesFor(rules, _operands[0]).push_back(index);
+	}
+
+	/// Calls @a _tryRule in order on the rules for an expression with @a _root at the root and
+	/// operands of shapes @a _operands, skipping rules whose operand shapes do not fit.
+	/// @returns the first rule for which @a _tryRule returns true or nullptr.
+	template <class TryRule>
+	Rule const* findFirst(Instruction _root, Shapes const& _operands, TryRule const& _tryRule) const
+	{
+		RulesForInstruction const& rules = m_rules[uint8_t(_root)];
+		std::vector<size_t> const* candidates = &rules.anyFirstOperand;
+		for (auto const& entry: rules.byFirstOperand)
+			if (entry.first == _operands[0])
+			{
+				candidates = &entry.second;
+				break;
+			}
+		for (size_t index: *candidates)
+		{
+			auto const& rule = rules.rules[index];
+			bool fits = true;
+			for (size_t i = 1; i < c_maxOperands && fits; ++i)
+				fits = rule.second[i].admits(_operands[i]);
+			if (fits && _tryRule(rule.first))
+				return &rule.first;
+		}
+		return nullptr;
+	}
+
+	bool hasRules(Instruction _root) const { return !m_rules[uint8_t(_root)].rules.empty(); }
+
+private:
+	struct RulesForInstruction
+	{
+		std::vector<std::pair<Rule, Shapes>> rules;
+		/// Indices of the candidate rules for each shape of the first operand that
+		/// appears in some rule.
+		std::vector<std::pair<OperandShape, std::vector<size_t>>> byFirstOperand;
+		/// Indices of the rules that accept any first operand.
+		std::vector<size_t> anyFirstOperand;
+	};
+
+	static std::vector<size_t>& candidatesFor(RulesForInstruction& _rules, OperandShape const& _shape)
+	{
+		for (auto& entry: _rules.byFirstOperand)
+			if (entry.first == _shape)
+				return entry.second;
+		_rules.byFirstOperand.emplace_back(_shape, _rules.anyFirstOperand);
+		return _rules.byFirstOperand.back().second;
+	}
+
+	RulesForInstruction m_rules[256];
+};
+
+}
+}
@@ -40,28 +40,46 @@ using namespace dev;
 using namespace dev::eth;
 using namespace langutil;
 
+namespace
+{
+
+OperandShape operandShape(AssemblyItemType _type, Instruction _instruction)
+{
+	if (_type == Push)
+		return OperandShape::constant();
+	else if (_type == Operation)
+		return OperandShape::operation(_instruction);
+	else
+		return OperandShape::any();
+}
+
+}
+
 SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	Expression const& _expr,
 	ExpressionClasses const& _classes
 )
 {
-	resetMatchGroups();
-
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+	SimplificationRuleIndex<Pattern>::Shapes operands;
+	for (size_t i = 0; i < _expr.arguments.size() && i < operands.size(); ++i)
 	{
-		if (rule.pattern.matches(_expr, _classes))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		AssemblyItem const& argument = *_classes.representative(_expr.arguments[i]).item;
+		operands[i] = operandShape(
+			argument.type(),
+			argument.type() == Operation ? argument.instruction() : Instruction::STOP
+		);
+	}
 
+	return m_rules.findFirst(_expr.item->instruction(), operands, [&](SimplificationRule<Pattern> const& _rule) {
 		resetMatchGroups();
-	}
-	return nullptr;
+		return _rule.pattern.matches(_expr, _classes) && (!_rule.feasible || _rule.feasible());
+	});
 }
 
 bool Rules::isInitialized() const
 {
-	return !m_rules[uint8_t(Instruction::ADD)].empty();
+	return m_rules.hasRules(Instruction::ADD);
 }
 
 void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
@@ -72,7 +90,15 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	SimplificationRuleIndex<Pattern>::Shapes operands;
+	vector<Pattern> arguments = _rule.pattern.arguments();
+	assertThrow(arguments.size() <= operands.size(), OptimizerException, "Too many operands in rule.");
+	for (size_t i = 0; i < arguments.size(); ++i)
+		operands[i] = operandShape(
+			arguments[i].type(),
+			arguments[i].type() == Operation ? arguments[i].instruction() : Instruction::STOP
+		);
+	m_rules.add(_rule.pattern.instruction(), _rule, operands);
 }
 
 Rules::Rules()
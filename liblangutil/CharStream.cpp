@@ -53,9 +53,31 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libdevcore/MappedFile.h>
+
+#include <algorithm>
+
 using namespace std;
 using namespace langutil;
 
+CharStream::CharStream(string _source, string _name):
+	m_name(std::move(_name))
+{
+	auto source = make_shared<string const>(std::move(_source));
+	m_data = source->c_str();
+	m_size = source->size();
+	m_buffer = std::move(source);
+}
+
+CharStream::CharStream(shared_ptr<dev::MappedFile const> _file, string _name):
+	m_name(std::move(_name))
+{
+	solAssert(_file, "");
+	m_data = _file->data();
+	m_size = _file->size();
+	m_buffer = std::move(_file);
+}
+
 char CharStream::advanceAndGet(size_t _chars)
 {
 	if (isPastEndOfInput())
@@ -63,7 +85,7 @@ char CharStream::advanceAndGet(size_t _chars)
 	m_position += _chars;
 	if (isPastEndOfInput())
 		return 0;
-	return m_source[m_position];
+	return m_data[m_position];
 }
 
 char CharStream::rollback(size_t _amount)
@@ -76,34 +98,25 @@ char CharStream::rollback(size_t _amount)
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), _position);
-	if (searchStart > 0)
+	char const* end = m_data + m_size;
+	char const* searchStart = m_data + min<size_t>(m_size, _position);
+	if (searchStart > m_data)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
+	char const* lineStart = searchStart;
+	while (lineStart > m_data && *lineStart != '\n')
+		lineStart--;
+	if (*lineStart == '\n')
 		lineStart++;
-	return m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	return string(lineStart, find(lineStart, end, '\n'));
 }
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	size_type searchPosition = min<size_type>(m_source.size(), _position);
-	int lineNumber = count(m_source.begin(), m_source.begin() + searchPosition, '\n');
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
+	size_t searchPosition = min<size_t>(m_size, _position);
+	int lineNumber = count(m_data, m_data + searchPosition, '\n');
+	size_t lineStart = searchPosition;
+	while (lineStart > 0 && m_data[lineStart - 1] != '\n')
+		lineStart--;
 	return tuple<int, int>(lineNumber, searchPosition - lineStart);
 }
 
@@ -53,9 +53,15 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tuple>
 
+namespace dev
+{
+class MappedFile;
+}
+
 namespace langutil
 {
 
@@ -63,24 +69,31 @@ namespace langutil
  * Bidirectional stream of characters.
  *
  * This CharStream is used by lexical analyzers as the source.
+ * The characters are kept in an immutable buffer that is shared between copies of the
+ * stream. The buffer is either a string or a memory-mapped file and is always followed
+ * by a zero byte.
  */
 class CharStream
 {
 public:
 	CharStream() = default;
-	explicit CharStream(std::string const& _source, std::string const& name):
-		m_source(_source), m_name(name) {}
+	explicit CharStream(std::string _source, std::string _name);
+	/// Creates a stream that reads directly from the (memory-mapped) file @a _file.
+	explicit CharStream(std::shared_ptr<dev::MappedFile const> _file, std::string _name);
 
 	int position() const { return m_position; }
-	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
+	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_size; }
 
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	char get(size_t _charsForward = 0) const { return m_data[m_position + _charsForward]; }
 	char advanceAndGet(size_t _chars = 1);
 	char rollback(size_t _amount);
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
+	/// @returns a copy of the source. Use data() and size() to access it without copying.
+	std::string source() const { return std::string(m_data, m_size); }
+	char const* data() const noexcept { return m_data; }
+	size_t size() const noexcept { return m_size; }
 	std::string const& name() const noexcept { return m_name; }
 
 	///@{
@@ -92,7 +105,10 @@ public:
 	///@}
 
 private:
-	std::string m_source;
+	/// Owner of the memory m_data points to.
+	std::shared_ptr<void const> m_buffer;
+	char const* m_data = "";
+	size_t m_size = 0;
 	std::string m_name;
 	size_t m_position{0};
 };
@@ -0,0 +1,233 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Bulk searches over runs of characters, used by the scanner to skip whitespace and
+ * comments and to copy literals without looking at each character separately.
+ */
+
+#include <liblangutil/CharacterRuns.h>
+#include <liblangutil/Common.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#define SOL_CHARACTER_RUNS_SIMD 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOL_CHARACTER_RUNS_SIMD 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace std;
+using namespace langutil;
+
+namespace
+{
+
+#if defined(SOL_CHARACTER_RUNS_SIMD)
+
+/// Thin wrapper around the vector instructions, so that the searches below are written
+/// only once for both vector widths.
+struct Simd
+{
+#if defined(__AVX2__)
+	using Vector = __m256i;
+	static size_t constexpr width = 32;
+	static uint32_t constexpr allLanes = 0xffffffff;
+	static Vector load(char const* _p) { return _mm256_loadu_si256(reinterpret_cast<Vector const*>(_p)); }
+	static Vector splat(char _c) { return _mm256_set1_epi8(_c); }
+	static Vector equal(Vector _a, Vector _b) { return _mm256_cmpeq_epi8(_a, _b); }
+	static Vector greater(Vector _a, Vector _b) { return _mm256_cmpgt_epi8(_a, _b); }
+	static Vector either(Vector _a, Vector _b) { return _mm256_or_si256(_a, _b); }
+	static Vector both(Vector _a, Vector _b) { return _mm256_and_si256(_a, _b); }
+	static uint32_t lanes(Vector _a) { return uint32_t(_mm256_movemask_epi8(_a)); }
+#else
+	using Vector = __m128i;
+	static size_t constexpr width = 16;
+	static uint32_t constexpr allLanes = 0xffff;
+	static Vector load(char const* _p) { return _mm_loadu_si128(reinterpret_cast<Vector const*>(_p)); }
+	static Vector splat(char _c) { return _mm_set1_epi8(_c); }
+	static Vector equal(Vector _a, Vector _b) { return _mm_cmpeq_epi8(_a, _b); }
+	static Vector greater(Vector _a, Vector _b) { return _mm_cmpgt_epi8(_a, _b); }
+	static Vector either(Vector _a, Vector _b) { return _mm_or_si128(_a, _b); }
+	static Vector both(Vector _a, Vector _b) { return _mm_and_si128(_a, _b); }
+	static uint32_t lanes(Vector _a) { return uint32_t(_mm_movemask_epi8(_a)); }
+#endif
+
+	static Vector equal(Vector _a, char _c) { return equal(_a, splat(_c)); }
+	/// Lanes of @a _a that are in the range [_low, _high]. Bytes above 0x7f are negative
+	/// and thus never in a range of ASCII characters.
+	static Vector inRange(Vector _a, char _low, char _high)
+	{
+		return both(greater(_a, splat(char(_low - 1))), greater(splat(char(_high + 1)), _a));
+	}
+};
+
+unsigned countTrailingZeros(uint32_t _value)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, _value);
+	return unsigned(index);
+#else
+	return unsigned(__builtin_ctz(_value));
+#endif
+}
+
+#endif
+
+/// @returns the first character in [_begin, _end) for which @a _scalar returns true.
+template <class Scalar>
+char const* findFirstScalar(char const* _begin, char const* _end, Scalar const& _scalar)
+{
+	while (_begin != _end && !_scalar(*_begin))
+		++_begin;
+	return _begin;
+}
+
+bool isLineBreakCandidate(char _c)
+{
+	return ('\n' <= _c && _c <= '\r') || uint8_t(_c) == 0xc2 || uint8_t(_c) == 0xe2;
+}
+
+#if defined(SOL_CHARACTER_RUNS_SIMD)
+
+/// Checks full vectors of characters starting at @a _begin using @a _vector, which
+/// returns the set of matching lanes.
+/// @returns the first matching character or the start of the remaining characters
+/// that do not fill a vector.
+template <class Vectorised>
+char const* findFirstVectorised(char const* _begin, char const* _end, Vectorised const& _vector)
+{
+	while (size_t(_end - _begin) >= Simd::width)
+	{
+		if (uint32_t matches = _vector(Simd::load(_begin)))
+			return _begin + countTrailingZeros(matches);
+		_begin += Simd::width;
+	}
+	return _begin;
+}
+
+Simd::Vector lineBreakCandidates(Simd::Vector _chars)
+{
+	return Simd::either(
+		Simd::inRange(_chars, '\n', '\r'),
+		Simd::either(Simd::equal(_chars, char(0xc2)), Simd::equal(_chars, char(0xe2)))
+	);
+}
+
+Simd::Vector hexDigits(Simd::Vector _chars)
+{
+	return Simd::either(
+		Simd::inRange(_chars, '0', '9'),
+		Simd::either(Simd::inRange(_chars, 'a', 'f'), Simd::inRange(_chars, 'A', 'F'))
+	);
+}
+
+#endif
+
+}
+
+char const* langutil::findEndOfWhitespace(char const* _begin, char const* _end)
+{
+#if defined(SOL_CHARACTER_RUNS_SIMD)
+	_begin = findFirstVectorised(_begin, _end, [](Simd::Vector _chars) {
+		return ~Simd::lanes(Simd::either(
+			Simd::either(Simd::equal(_chars, ' '), Simd::equal(_chars, '\n')),
+			Simd::either(Simd::equal(_chars, '\t'), Simd::equal(_chars, '\r'))
+		)) & Simd::allLanes;
+	});
+#endif
+	return findFirstScalar(_begin, _end, [](char _c) { return !isWhiteSpace(_c); });
+}
+
+char const* langutil::findEndOfIdentifier(char const* _begin, char const* _end)
+{
+#if defined(SOL_CHARACTER_RUNS_SIMD)
+	_begin = findFirstVectorised(_begin, _end, [](Simd::Vector _chars) {
+		// Setting bit 5 maps upper case letters to lower case ones and no other
+		// character to a letter.
+		Simd::Vector lowerCase = Simd::either(_chars, Simd::splat(0x20));
+		return ~Simd::lanes(Simd::either(
+			Simd::either(Simd::inRange(lowerCase, 'a', 'z'), Simd::inRange(_chars, '0', '9')),
+			Simd::either(Simd::equal(_chars, '_'), Simd::equal(_chars, '$'))
+		)) & Simd::allLanes;
+	});
+#endif
+	return findFirstScalar(_begin, _end, [](char _c) { return !isIdentifierPart(_c); });
+}
+
+char const* langutil::findEndOfHexDigits(char const* _begin, char const* _end)
+{
+#if defined(SOL_CHARACTER_RUNS_SIMD)
+	_begin = findFirstVectorised(_begin, _end, [](Simd::Vector _chars) {
+		return ~Simd::lanes(hexDigits(_chars)) & Simd::allLanes;
+	});
+#endif
+	return findFirstScalar(_begin, _end, [](char _c) { return !isHexDigit(_c); });
+}
+
+char const* langutil::findLineBreakCandidate(char const* _begin, char const* _end)
+{
+#if defined(SOL_CHARACTER_RUNS_SIMD)
+	_begin = findFirstVectorised(_begin, _end, [](Simd::Vector _chars) {
+		return Simd::lanes(lineBreakCandidates(_chars));
+	});
+#endif
+	return findFirstScalar(_begin, _end, isLineBreakCandidate);
+}
+
+char const* langutil::findStringLiteralSpecial(char const* _begin, char const* _end, char _quote)
+{
+#if defined(SOL_CHARACTER_RUNS_SIMD)
+	Simd::Vector const quote = Simd::splat(_quote);
+	_begin = findFirstVectorised(_begin, _end, [&](Simd::Vector _chars) {
+		return Simd::lanes(Simd::either(
+			lineBreakCandidates(_chars),
+			Simd::either(Simd::equal(_chars, quote), Simd::equal(_chars, '\\'))
+		));
+	});
+#endif
+	return findFirstScalar(_begin, _end, [&](char _c) {
+		return _c == _quote || _c == '\\' || isLineBreakCandidate(_c);
+	});
+}
+
+char const* langutil::findCharacter(char const* _begin, char const* _end, char _character)
+{
+	// memchr is vectorised by the C library already.
+	void const* position = memchr(_begin, _character, size_t(_end - _begin));
+	return position ? static_cast<char const*>(position) : _end;
+}
+
+char const* langutil::findEither(char const* _begin, char const* _end, char _first, char _second)
+{
+#if defined(SOL_CHARACTER_RUNS_SIMD)
+	Simd::Vector const first = Simd::splat(_first);
+	Simd::Vector const second = Simd::splat(_second);
+	_begin = findFirstVectorised(_begin, _end, [&](Simd::Vector _chars) {
+		return Simd::lanes(Simd::either(Simd::equal(_chars, first), Simd::equal(_chars, second)));
+	});
+#endif
+	return findFirstScalar(_begin, _end, [&](char _c) { return _c == _first || _c == _second; });
+}
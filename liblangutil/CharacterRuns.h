@@ -0,0 +1,49 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Bulk searches over runs of characters, used by the scanner to skip whitespace and
+ * comments and to copy literals without looking at each character separately.
+ */
+
+#pragma once
+
+namespace langutil
+{
+
+/// Each of the following functions @returns a pointer to the first character in
+/// [_begin, _end) that has the described property, or @a _end if there is none.
+/// They compare 16 or 32 characters at a time if SSE2 or AVX2 are available.
+
+/// Finds the first character that is not whitespace in the sense of isWhiteSpace.
+char const* findEndOfWhitespace(char const* _begin, char const* _end);
+/// Finds the first character that is not part of an identifier in the sense of isIdentifierPart.
+char const* findEndOfIdentifier(char const* _begin, char const* _end);
+/// Finds the first character that is not a hex digit.
+char const* findEndOfHexDigits(char const* _begin, char const* _end);
+/// Finds the first character that might start a line break in the sense of
+/// Scanner::isUnicodeLinebreak, i.e. one of '\n', '\v', '\f', '\r' or the first byte of
+/// the UTF-8 encoding of U+0085, U+2028 or U+2029.
+char const* findLineBreakCandidate(char const* _begin, char const* _end);
+/// Finds the first character that is not copied verbatim into a string literal
+/// delimited by @a _quote: the quote, a backslash or a line break candidate.
+char const* findStringLiteralSpecial(char const* _begin, char const* _end, char _quote);
+/// Finds the first occurrence of @a _character.
+char const* findCharacter(char const* _begin, char const* _end, char _character);
+/// Finds the first occurrence of @a _first or @a _second.
+char const* findEither(char const* _begin, char const* _end, char _first, char _second);
+
+}
@@ -50,6 +50,7 @@
  * Solidity scanner.
  */
 
+#include <liblangutil/CharacterRuns.h>
 #include <liblangutil/Common.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/Scanner.h>
@@ -228,8 +229,13 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 bool Scanner::skipWhitespace()
 {
 	int const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
+	// m_char is not always the character at the current position: a multi-line comment
+	// ends in an artificial space. So only continue in bulk after a single step.
+	if (isWhiteSpace(m_char))
+	{
 		advance();
+		advanceTo(findEndOfWhitespace(sourceCursor(), sourceEnd()));
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -244,8 +250,13 @@ Token Scanner::skipSingleLineComment()
 {
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
-	while (!isUnicodeLinebreak())
-		if (!advance()) break;
+	while (true)
+	{
+		advanceTo(findLineBreakCandidate(sourceCursor(), sourceEnd()));
+		if (isSourcePastEndOfInput() || isUnicodeLinebreak())
+			break;
+		advance();
+	}
 
 	return Token::Whitespace;
 }
@@ -281,6 +292,9 @@ Token Scanner::scanSingleLineDocComment()
 			break;
 		addCommentLiteralChar(m_char);
 		advance();
+		char const* end = findLineBreakCandidate(sourceCursor(), sourceEnd());
+		m_nextSkippedComment.literal.append(sourceCursor(), end);
+		advanceTo(end);
 	}
 	literal.complete();
 	return Token::CommentLiteral;
@@ -289,15 +303,17 @@ Token Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	advance();
-	while (!isSourcePastEndOfInput())
+	while (true)
 	{
-		char ch = m_char;
+		advanceTo(findCharacter(sourceCursor(), sourceEnd(), '*'));
+		if (isSourcePastEndOfInput())
+			break;
 		advance();
 
 		// If we have reached the end of the multi-line comment, we
 		// consume the '/' and insert a whitespace. This way all
 		// multi-line comments are treated as whitespace.
-		if (ch == '*' && m_char == '/')
+		if (m_char == '/')
 		{
 			m_char = ' ';
 			return Token::Whitespace;
@@ -352,6 +368,9 @@ Token Scanner::scanMultiLineDocComment()
 		addCommentLiteralChar(m_char);
 		charsAdded = true;
 		advance();
+		char const* end = findEither(sourceCursor(), sourceEnd(), '\n', '*');
+		m_nextSkippedComment.literal.append(sourceCursor(), end);
+		advanceTo(end);
 	}
 	literal.complete();
 	if (!endFound)
@@ -707,6 +726,13 @@ Token Scanner::scanString()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
 	{
+		char const* plainEnd = findStringLiteralSpecial(sourceCursor(), sourceEnd(), quote);
+		if (plainEnd != sourceCursor())
+		{
+			m_nextToken.literal.append(sourceCursor(), plainEnd);
+			advanceTo(plainEnd);
+			continue;
+		}
 		char c = m_char;
 		advance();
 		if (c == '\\')
@@ -731,6 +757,15 @@ Token Scanner::scanHexString()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	while (m_char != quote && !isSourcePastEndOfInput())
 	{
+		// Decode complete pairs of hex digits in bulk.
+		char const* digits = sourceCursor();
+		char const* digitsEnd = digits + (findEndOfHexDigits(digits, sourceEnd()) - digits) / 2 * 2;
+		for (char const* pair = digits; pair != digitsEnd; pair += 2)
+			addLiteralChar(char(hexValue(pair[0]) * 16 + hexValue(pair[1])));
+		advanceTo(digitsEnd);
+		if (m_char == quote || isSourcePastEndOfInput())
+			break;
+
 		char c = m_char;
 		if (!scanHexByte(c))
 			// can only return false if hex-byte is incomplete (only one hex digit instead of two)
@@ -858,10 +893,11 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char)) //get full literal
-		addLiteralCharAndAdvance();
+	char const* start = sourceCursor();
+	char const* end = findEndOfIdentifier(start + 1, sourceEnd());
+	m_nextToken.literal.append(start, end);
+	advanceTo(end);
 	literal.complete();
 	return TokenTraits::fromIdentifierOrKeyword(m_nextToken.literal);
 }
@@ -57,6 +57,7 @@
 #include <liblangutil/SourceLocation.h>
 #include <libdevcore/Common.h>
 #include <libdevcore/CommonData.h>
+#include <algorithm>
 #include <iosfwd>
 
 namespace langutil
@@ -93,7 +94,8 @@ public:
 	explicit Scanner(std::shared_ptr<CharStream> _source) { reset(std::move(_source)); }
 	explicit Scanner(CharStream _source = CharStream()) { reset(std::move(_source)); }
 
-	std::string const& source() const noexcept { return m_source->source(); }
+	/// @returns a copy of the source. Use charStream() to access it without copying.
+	std::string source() const { return m_source->source(); }
 
 	std::shared_ptr<CharStream> charStream() noexcept { return m_source; }
 
@@ -160,7 +162,7 @@ public:
 	{
 		solAssert(!_location.isEmpty(), "");
 		solAssert(m_source.get() == _location.source.get(), "CharStream memory locations must match.");
-		return m_source->source().substr(_location.start, _location.end - _location.start);
+		return std::string(m_source->data() + _location.start, _location.end - _location.start);
 	}
 	///@}
 
@@ -190,6 +192,9 @@ private:
 	///@}
 
 	bool advance() { m_char = m_source->advanceAndGet(); return !m_source->isPastEndOfInput(); }
+	/// Advances to @a _position, which has to be between the current position and sourceEnd().
+	/// Requires m_char to be the character at the current position.
+	void advanceTo(char const* _position) { m_char = m_source->advanceAndGet(_position - sourceCursor()); }
 	void rollback(int _amount) { m_char = m_source->rollback(_amount); }
 
 	inline Token selectErrorToken(ScannerError _err) { advance(); return setError(_err); }
@@ -231,6 +236,9 @@ private:
 
 	/// Return the current source position.
 	int sourcePos() const { return m_source->position(); }
+	/// @returns a pointer to the character at the current position.
+	char const* sourceCursor() const { return m_source->data() + std::min<size_t>(m_source->position(), m_source->size()); }
+	char const* sourceEnd() const { return m_source->data() + m_source->size(); }
 	bool isSourcePastEndOfInput() const { return m_source->isPastEndOfInput(); }
 
 	TokenDesc m_skippedComment;  // desc for current skipped comment
@@ -42,7 +42,8 @@ public:
 private:
 	static size_t& instance()
 	{
-		static IDDispenser dispenser;
+		// Per thread, so that sources parsed concurrently get the same IDs as when parsed alone.
+		static thread_local IDDispenser dispenser;
 		return dispenser.id;
 	}
 	size_t id = 0;
@@ -30,7 +30,9 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace yul
@@ -102,6 +104,25 @@ struct ContractDefinitionAnnotation: TypeDeclarationAnnotation, DocumentedAnnota
 	/// Mapping containing the nodes that define the arguments for base constructors.
 	/// These can either be inheritance specifiers or modifier invocations.
 	std::map<FunctionDefinition const*, ASTNode const*> baseConstructorArguments;
+
+	/// Library function attached to a type by a `using for` directive.
+	struct UsingForFunction
+	{
+		/// The type in the directive with storage data location, nullptr for `*`.
+		TypePointer attachedTo;
+		FunctionDefinition const* function = nullptr;
+		/// Type of the function when called as a bound member.
+		TypePointer boundType;
+	};
+	/// Functions attached by the `using for` directives of this contract and its bases, in
+	/// the order of the directives. Filled when first used for looking up members.
+	boost::optional<std::vector<UsingForFunction>> usingForFunctions;
+	/// Indices into @a usingForFunctions of the functions bound to a type in this contract,
+	/// keyed by the rich identifier of the type.
+	std::unordered_map<std::string, std::vector<size_t>> boundFunctions;
+	/// Guards @a usingForFunctions and @a boundFunctions, which are also filled while
+	/// contracts are compiled in parallel.
+	std::mutex boundFunctionsMutex;
 };
 
 struct FunctionDefinitionAnnotation: ASTAnnotation, DocumentedAnnotation
@@ -0,0 +1,129 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Provider of shared instances of the frequently used types.
+ */
+
+#include <libsolidity/ast/TypeProvider.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+TypeProvider::Scope::Scope(TypeProvider const& _provider):
+	m_previous(current())
+{
+	current() = &_provider;
+}
+
+TypeProvider::Scope::~Scope()
+{
+	current() = m_previous;
+}
+
+TypeProvider::TypeProvider():
+	m_boolean(make_shared<BoolType>()),
+	m_address(make_shared<AddressType>(StateMutability::NonPayable)),
+	m_payableAddress(make_shared<AddressType>(StateMutability::Payable)),
+	m_bytesStorage(make_shared<ArrayType>(DataLocation::Storage)),
+	m_bytesMemory(make_shared<ArrayType>(DataLocation::Memory)),
+	m_bytesCalldata(make_shared<ArrayType>(DataLocation::CallData)),
+	m_stringStorage(make_shared<ArrayType>(DataLocation::Storage, true)),
+	m_stringMemory(make_shared<ArrayType>(DataLocation::Memory, true))
+{
+	for (unsigned bytes = 1; bytes <= 32; ++bytes)
+	{
+		m_integers[bytes - 1] = make_shared<IntegerType>(bytes * 8, IntegerType::Modifier::Unsigned);
+		m_integers[bytes + 31] = make_shared<IntegerType>(bytes * 8, IntegerType::Modifier::Signed);
+		m_fixedBytes[bytes - 1] = make_shared<FixedBytesType>(bytes);
+	}
+}
+
+shared_ptr<BoolType const> TypeProvider::boolean()
+{
+	if (TypeProvider const* provider = current())
+		return provider->m_boolean;
+	return make_shared<BoolType>();
+}
+
+shared_ptr<IntegerType const> TypeProvider::integer(unsigned _bits, IntegerType::Modifier _modifier)
+{
+	solAssert(_bits > 0 && _bits <= 256 && _bits % 8 == 0, "Invalid bit number for integer type: " + dev::toString(_bits));
+	if (TypeProvider const* provider = current())
+		return provider->m_integers[_bits / 8 - 1 + (_modifier == IntegerType::Modifier::Signed ? 32 : 0)];
+	return make_shared<IntegerType>(_bits, _modifier);
+}
+
+shared_ptr<FixedBytesType const> TypeProvider::fixedBytes(unsigned _bytes)
+{
+	solAssert(_bytes > 0 && _bytes <= 32, "Invalid byte number for fixed bytes type: " + dev::toString(_bytes));
+	if (TypeProvider const* provider = current())
+		return provider->m_fixedBytes[_bytes - 1];
+	return make_shared<FixedBytesType>(_bytes);
+}
+
+shared_ptr<AddressType const> TypeProvider::address(StateMutability _stateMutability)
+{
+	solAssert(
+		_stateMutability == StateMutability::NonPayable || _stateMutability == StateMutability::Payable,
+		"Invalid state mutability for address type."
+	);
+	if (TypeProvider const* provider = current())
+		return _stateMutability == StateMutability::Payable ? provider->m_payableAddress : provider->m_address;
+	return make_shared<AddressType>(_stateMutability);
+}
+
+shared_ptr<ArrayType const> TypeProvider::bytesStorage()
+{
+	if (TypeProvider const* provider = current())
+		return provider->m_bytesStorage;
+	return make_shared<ArrayType>(DataLocation::Storage);
+}
+
+shared_ptr<ArrayType const> TypeProvider::bytesMemory()
+{
+	if (TypeProvider const* provider = current())
+		return provider->m_bytesMemory;
+	return make_shared<ArrayType>(DataLocation::Memory);
+}
+
+shared_ptr<ArrayType const> TypeProvider::bytesCalldata()
+{
+	if (TypeProvider const* provider = current())
+		return provider->m_bytesCalldata;
+	return make_shared<ArrayType>(DataLocation::CallData);
+}
+
+shared_ptr<ArrayType const> TypeProvider::stringStorage()
+{
+	if (TypeProvider const* provider = current())
+		return provider->m_stringStorage;
+	return make_shared<ArrayType>(DataLocation::Storage, true);
+}
+
+shared_ptr<ArrayType const> TypeProvider::stringMemory()
+{
+	if (TypeProvider const* provider = current())
+		return provider->m_stringMemory;
+	return make_shared<ArrayType>(DataLocation::Memory, true);
+}
+
+TypeProvider const*& TypeProvider::current()
+{
+	static thread_local TypeProvider const* provider = nullptr;
+	return provider;
+}
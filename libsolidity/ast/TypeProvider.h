@@ -0,0 +1,97 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Provider of shared instances of the frequently used types.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/Types.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <memory>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Hands out a single shared instance for each of the elementary types and the byte and string
+ * arrays, so that they are not allocated again for every expression and their member lists are
+ * only computed once per contract. Other types are not shared.
+ *
+ * The instances belong to a provider, which is owned by the compiler stack that analyses and
+ * compiles a set of sources, so that their members are never cached for contracts of other
+ * sources. The static functions return the instances of the provider that is installed for the
+ * current thread by a @a Scope, and a new type if there is none.
+ * All instances are created up front, so that a provider can be used by several threads.
+ */
+class TypeProvider: boost::noncopyable
+{
+public:
+	/// Installs a provider for the current thread while it exists. Does not take ownership.
+	class Scope: boost::noncopyable
+	{
+	public:
+		explicit Scope(TypeProvider const& _provider);
+		~Scope();
+
+	private:
+		TypeProvider const* m_previous = nullptr;
+	};
+
+	TypeProvider();
+
+	static std::shared_ptr<BoolType const> boolean();
+	static std::shared_ptr<IntegerType const> integer(
+		unsigned _bits,
+		IntegerType::Modifier _modifier = IntegerType::Modifier::Unsigned
+	);
+	static std::shared_ptr<IntegerType const> uint256() { return integer(256); }
+	static std::shared_ptr<FixedBytesType const> fixedBytes(unsigned _bytes);
+	static std::shared_ptr<AddressType const> address(StateMutability _stateMutability = StateMutability::NonPayable);
+	static std::shared_ptr<AddressType const> payableAddress() { return address(StateMutability::Payable); }
+
+	static std::shared_ptr<ArrayType const> bytesStorage();
+	static std::shared_ptr<ArrayType const> bytesMemory();
+	static std::shared_ptr<ArrayType const> bytesCalldata();
+	static std::shared_ptr<ArrayType const> stringStorage();
+	static std::shared_ptr<ArrayType const> stringMemory();
+
+private:
+	/// @returns the provider of the innermost active scope of the current thread or nullptr.
+	static TypeProvider const*& current();
+
+	std::shared_ptr<BoolType const> m_boolean;
+	/// Unsigned integers by number of bytes minus one, followed by the signed integers.
+	std::array<std::shared_ptr<IntegerType const>, 64> m_integers;
+	/// Fixed bytes types by number of bytes minus one.
+	std::array<std::shared_ptr<FixedBytesType const>, 32> m_fixedBytes;
+	std::shared_ptr<AddressType const> m_address;
+	std::shared_ptr<AddressType const> m_payableAddress;
+	std::shared_ptr<ArrayType const> m_bytesStorage;
+	std::shared_ptr<ArrayType const> m_bytesMemory;
+	std::shared_ptr<ArrayType const> m_bytesCalldata;
+	std::shared_ptr<ArrayType const> m_stringStorage;
+	std::shared_ptr<ArrayType const> m_stringMemory;
+};
+
+}
+}
@@ -23,6 +23,7 @@
 #include <libsolidity/ast/Types.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <libdevcore/Algorithms.h>
 #include <libdevcore/CommonData.h>
@@ -42,6 +43,7 @@
 #include <boost/range/algorithm/copy.hpp>
 
 #include <limits>
+#include <mutex>
 
 using namespace std;
 using namespace dev;
@@ -200,26 +202,36 @@ void MemberList::combine(MemberList const & _other)
 
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
 {
-	if (!m_storageOffsets)
-	{
-		TypePointers memberTypes;
-		memberTypes.reserve(m_memberTypes.size());
-		for (auto const& member: m_memberTypes)
-			memberTypes.push_back(member.type);
-		m_storageOffsets.reset(new StorageOffsets());
-		m_storageOffsets->computeOffsets(memberTypes);
-	}
+	StorageOffsets const& offsets = storageOffsets();
 	for (size_t index = 0; index < m_memberTypes.size(); ++index)
 		if (m_memberTypes[index].name == _name)
-			return m_storageOffsets->offset(index);
+			return offsets.offset(index);
 	return nullptr;
 }
 
 u256 const& MemberList::storageSize() const
 {
-	// trigger lazy computation
-	memberStorageOffset("");
-	return m_storageOffsets->storageSize();
+	return storageOffsets().storageSize();
+}
+
+StorageOffsets const& MemberList::storageOffsets() const
+{
+	shared_ptr<StorageOffsets const> offsets = atomic_load(&m_storageOffsets);
+	if (!offsets)
+	{
+		TypePointers memberTypes;
+		memberTypes.reserve(m_memberTypes.size());
+		for (auto const& member: m_memberTypes)
+			memberTypes.push_back(member.type);
+		auto computed = make_shared<StorageOffsets>();
+		computed->computeOffsets(memberTypes);
+		// Another thread might have been faster, in which case its offsets are used.
+		shared_ptr<StorageOffsets const> expected;
+		offsets = move(computed);
+		if (!atomic_compare_exchange_strong(&m_storageOffsets, &expected, offsets))
+			offsets = move(expected);
+	}
+	return *offsets;
 }
 
 /// Helper functions for type identifier
@@ -302,33 +314,33 @@ TypePointer Type::fromElementaryTypeName(ElementaryTypeNameToken const& _type)
 	switch (token)
 	{
 	case Token::IntM:
-		return make_shared<IntegerType>(m, IntegerType::Modifier::Signed);
+		return TypeProvider::integer(m, IntegerType::Modifier::Signed);
 	case Token::UIntM:
-		return make_shared<IntegerType>(m, IntegerType::Modifier::Unsigned);
+		return TypeProvider::integer(m, IntegerType::Modifier::Unsigned);
 	case Token::BytesM:
-		return make_shared<FixedBytesType>(m);
+		return TypeProvider::fixedBytes(m);
 	case Token::FixedMxN:
 		return make_shared<FixedPointType>(m, n, FixedPointType::Modifier::Signed);
 	case Token::UFixedMxN:
 		return make_shared<FixedPointType>(m, n, FixedPointType::Modifier::Unsigned);
 	case Token::Int:
-		return make_shared<IntegerType>(256, IntegerType::Modifier::Signed);
+		return TypeProvider::integer(256, IntegerType::Modifier::Signed);
 	case Token::UInt:
-		return make_shared<IntegerType>(256, IntegerType::Modifier::Unsigned);
+		return TypeProvider::integer(256, IntegerType::Modifier::Unsigned);
 	case Token::Fixed:
 		return make_shared<FixedPointType>(128, 18, FixedPointType::Modifier::Signed);
 	case Token::UFixed:
 		return make_shared<FixedPointType>(128, 18, FixedPointType::Modifier::Unsigned);
 	case Token::Byte:
-		return make_shared<FixedBytesType>(1);
+		return TypeProvider::fixedBytes(1);
 	case Token::Address:
-		return make_shared<AddressType>(StateMutability::NonPayable);
+		return TypeProvider::address();
 	case Token::Bool:
-		return make_shared<BoolType>();
+		return TypeProvider::boolean();
 	case Token::Bytes:
-		return make_shared<ArrayType>(DataLocation::Storage);
+		return TypeProvider::bytesStorage();
 	case Token::String:
-		return make_shared<ArrayType>(DataLocation::Storage, true);
+		return TypeProvider::stringStorage();
 	//no types found
 	default:
 		solAssert(
@@ -368,11 +380,11 @@ TypePointer Type::fromElementaryTypeName(string const& _name)
 		if (nameParts.size() == 2)
 		{
 			if (nameParts[1] == "payable")
-				return make_shared<AddressType>(StateMutability::Payable);
+				return TypeProvider::payableAddress();
 			else
 				solAssert(false, "Invalid state mutability for address type: " + nameParts[1]);
 		}
-		return make_shared<AddressType>(StateMutability::NonPayable);
+		return TypeProvider::address();
 	}
 	else
 	{
@@ -387,7 +399,7 @@ TypePointer Type::forLiteral(Literal const& _literal)
 	{
 	case Token::TrueLiteral:
 	case Token::FalseLiteral:
-		return make_shared<BoolType>();
+		return TypeProvider::boolean();
 	case Token::Number:
 		return RationalNumberType::forLiteral(_literal);
 	case Token::StringLiteral:
@@ -411,14 +423,20 @@ TypePointer Type::commonType(TypePointer const& _a, TypePointer const& _b)
 
 MemberList const& Type::members(ContractDefinition const* _currentScope) const
 {
-	if (!m_members[_currentScope])
 	{
-		MemberList::MemberMap members = nativeMembers(_currentScope);
-		if (_currentScope)
-			members += boundFunctions(*this, *_currentScope);
-		m_members[_currentScope] = unique_ptr<MemberList>(new MemberList(move(members)));
+		lock_guard<mutex> lock(m_lazyDataMutex);
+		auto it = m_members.find(_currentScope);
+		if (it != m_members.end())
+			return *it->second;
 	}
-	return *m_members[_currentScope];
+	MemberList::MemberMap members = nativeMembers(_currentScope);
+	if (_currentScope)
+		members += boundFunctions(*this, *_currentScope);
+	lock_guard<mutex> lock(m_lazyDataMutex);
+	unique_ptr<MemberList>& memberList = m_members[_currentScope];
+	if (!memberList)
+		memberList.reset(new MemberList(move(members)));
+	return *memberList;
 }
 
 TypePointer Type::fullEncodingType(bool _inLibraryCall, bool _encoderV2, bool) const
@@ -444,33 +462,73 @@ TypePointer Type::fullEncodingType(bool _inLibraryCall, bool _encoderV2, bool) c
 
 MemberList::MemberMap Type::boundFunctions(Type const& _type, ContractDefinition const& _scope)
 {
-	// Normalise data location of type.
-	TypePointer type = ReferenceType::copyForLocationIfReference(DataLocation::Storage, _type.shared_from_this());
-	set<Declaration const*> seenFunctions;
-	MemberList::MemberMap members;
-	for (ContractDefinition const* contract: _scope.annotation().linearizedBaseContracts)
-		for (UsingForDirective const* ufd: contract->usingForDirectives())
-		{
-			if (ufd->typeName() && *type != *ReferenceType::copyForLocationIfReference(
-				DataLocation::Storage,
-				ufd->typeName()->annotation().type
-			))
-				continue;
-			auto const& library = dynamic_cast<ContractDefinition const&>(
-				*ufd->libraryName().annotation().referencedDeclaration
-			);
-			for (FunctionDefinition const* function: library.definedFunctions())
+	// The lock is released while the functions are collected, the first result is kept.
+	ContractDefinitionAnnotation& annotation = _scope.annotation();
+	unique_lock<mutex> lock(annotation.boundFunctionsMutex);
+	if (!annotation.usingForFunctions)
+	{
+		lock.unlock();
+		vector<ContractDefinitionAnnotation::UsingForFunction> usingForFunctions;
+		for (ContractDefinition const* contract: annotation.linearizedBaseContracts)
+			for (UsingForDirective const* ufd: contract->usingForDirectives())
 			{
-				if (!function->isVisibleAsLibraryMember() || seenFunctions.count(function))
-					continue;
-				seenFunctions.insert(function);
-				if (function->parameters().empty())
-					continue;
-				FunctionTypePointer fun = FunctionType(*function, false).asCallableFunction(true, true);
-				if (_type.isImplicitlyConvertibleTo(*fun->selfType()))
-					members.emplace_back(function->name(), fun, function);
+				TypePointer attachedTo;
+				if (ufd->typeName())
+					attachedTo = ReferenceType::copyForLocationIfReference(
+						DataLocation::Storage,
+						ufd->typeName()->annotation().type
+					);
+				auto const& library = dynamic_cast<ContractDefinition const&>(
+					*ufd->libraryName().annotation().referencedDeclaration
+				);
+				for (FunctionDefinition const* function: library.definedFunctions())
+					if (function->isVisibleAsLibraryMember() && !function->parameters().empty())
+						usingForFunctions.push_back({
+							attachedTo,
+							function,
+							FunctionType(*function, false).asCallableFunction(true, true)
+						});
 			}
+		lock.lock();
+		if (!annotation.usingForFunctions)
+			annotation.usingForFunctions = move(usingForFunctions);
+	}
+	// The list is not changed anymore once it is set.
+	auto const& usingForFunctions = *annotation.usingForFunctions;
+
+	string identifier = _type.richIdentifier();
+	vector<size_t> bound;
+	auto indices = annotation.boundFunctions.find(identifier);
+	if (indices != annotation.boundFunctions.end())
+		bound = indices->second;
+	else
+	{
+		lock.unlock();
+		// Normalise data location of type.
+		TypePointer type = ReferenceType::copyForLocationIfReference(DataLocation::Storage, _type.shared_from_this());
+		set<Declaration const*> seenFunctions;
+		for (size_t i = 0; i < usingForFunctions.size(); ++i)
+		{
+			auto const& candidate = usingForFunctions[i];
+			if (candidate.attachedTo && *type != *candidate.attachedTo)
+				continue;
+			if (!seenFunctions.insert(candidate.function).second)
+				continue;
+			auto const& boundType = dynamic_cast<FunctionType const&>(*candidate.boundType);
+			if (_type.isImplicitlyConvertibleTo(*boundType.selfType()))
+				bound.push_back(i);
 		}
+		lock.lock();
+		annotation.boundFunctions.emplace(move(identifier), bound);
+	}
+	lock.unlock();
+
+	MemberList::MemberMap members;
+	for (size_t index: bound)
+	{
+		auto const& function = usingForFunctions[index];
+		members.emplace_back(function.function->name(), function.boundType, function.function);
+	}
 	return members;
 }
 
@@ -551,7 +609,7 @@ bool AddressType::operator==(Type const& _other) const
 MemberList::MemberMap AddressType::nativeMembers(ContractDefinition const*) const
 {
 	MemberList::MemberMap members = {
-		{"balance", make_shared<IntegerType>(256)},
+		{"balance", TypeProvider::uint256()},
 		{"call", make_shared<FunctionType>(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareCall, false, StateMutability::Payable)},
 		{"callcode", make_shared<FunctionType>(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareCallCode, false, StateMutability::Payable)},
 		{"delegatecall", make_shared<FunctionType>(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareDelegateCall, false)},
@@ -866,7 +924,7 @@ TypePointer RationalNumberType::forLiteral(Literal const& _literal)
 		{
 			size_t const digitCount = _literal.valueWithoutUnderscores().length() - 2;
 			if (digitCount % 2 == 0 && (digitCount / 2) <= 32)
-				compatibleBytesType = make_shared<FixedBytesType>(digitCount / 2);
+				compatibleBytesType = TypeProvider::fixedBytes(digitCount / 2);
 		}
 
 		return make_shared<RationalNumberType>(get<1>(validLiteral), compatibleBytesType);
@@ -1407,7 +1465,7 @@ std::string StringLiteralType::toString(bool) const
 
 TypePointer StringLiteralType::mobileType() const
 {
-	return make_shared<ArrayType>(DataLocation::Memory, true);
+	return TypeProvider::stringMemory();
 }
 
 bool StringLiteralType::isValidUTF8() const
@@ -1473,7 +1531,7 @@ TypeResult FixedBytesType::binaryOperatorResult(Token _operator, TypePointer con
 
 MemberList::MemberMap FixedBytesType::nativeMembers(ContractDefinition const*) const
 {
-	return MemberList::MemberMap{MemberList::Member{"length", make_shared<IntegerType>(8)}};
+	return MemberList::MemberMap{MemberList::Member{"length", TypeProvider::integer(8)}};
 }
 
 string FixedBytesType::richIdentifier() const
@@ -1831,12 +1889,12 @@ MemberList::MemberMap ArrayType::nativeMembers(ContractDefinition const*) const
 	MemberList::MemberMap members;
 	if (!isString())
 	{
-		members.emplace_back("length", make_shared<IntegerType>(256));
+		members.emplace_back("length", TypeProvider::uint256());
 		if (isDynamicallySized() && location() == DataLocation::Storage)
 		{
 			members.emplace_back("push", make_shared<FunctionType>(
 				TypePointers{baseType()},
-				TypePointers{make_shared<IntegerType>(256)},
+				TypePointers{TypeProvider::uint256()},
 				strings{string()},
 				strings{string()},
 				isByteArray() ? FunctionType::Kind::ByteArrayPush : FunctionType::Kind::ArrayPush
@@ -1856,7 +1914,7 @@ MemberList::MemberMap ArrayType::nativeMembers(ContractDefinition const*) const
 TypePointer ArrayType::encodingType() const
 {
 	if (location() == DataLocation::Storage)
-		return make_shared<IntegerType>(256);
+		return TypeProvider::uint256();
 	else
 		return this->copyForLocation(DataLocation::Memory, true);
 }
@@ -1864,18 +1922,21 @@ TypePointer ArrayType::encodingType() const
 TypePointer ArrayType::decodingType() const
 {
 	if (location() == DataLocation::Storage)
-		return make_shared<IntegerType>(256);
+		return TypeProvider::uint256();
 	else
 		return shared_from_this();
 }
 
 TypeResult ArrayType::interfaceType(bool _inLibrary) const
 {
-	if (_inLibrary && m_interfaceType_library.is_initialized())
-		return *m_interfaceType_library;
+	{
+		lock_guard<mutex> lock(m_lazyDataMutex);
+		if (_inLibrary && m_interfaceType_library.is_initialized())
+			return *m_interfaceType_library;
 
-	if (!_inLibrary && m_interfaceType.is_initialized())
-		return *m_interfaceType;
+		if (!_inLibrary && m_interfaceType.is_initialized())
+			return *m_interfaceType;
+	}
 
 	TypeResult result{TypePointer{}};
 	TypeResult baseInterfaceType = m_baseType->interfaceType(_inLibrary);
@@ -1894,12 +1955,11 @@ TypeResult ArrayType::interfaceType(bool _inLibrary) const
 	else
 		result = TypePointer{make_shared<ArrayType>(DataLocation::Memory, baseInterfaceType, m_length)};
 
-	if (_inLibrary)
-		m_interfaceType_library = result;
-	else
-		m_interfaceType = result;
-
-	return result;
+	lock_guard<mutex> lock(m_lazyDataMutex);
+	boost::optional<TypeResult>& cached = _inLibrary ? m_interfaceType_library : m_interfaceType;
+	if (!cached.is_initialized())
+		cached = result;
+	return *cached;
 }
 
 u256 ArrayType::memorySize() const
@@ -1995,8 +2055,15 @@ MemberList::MemberMap ContractType::nativeMembers(ContractDefinition const* _con
 
 shared_ptr<FunctionType const> const& ContractType::newExpressionType() const
 {
+	{
+		lock_guard<mutex> lock(m_lazyDataMutex);
+		if (m_constructorType)
+			return m_constructorType;
+	}
+	FunctionTypePointer constructorType = FunctionType::newExpressionType(m_contract);
+	lock_guard<mutex> lock(m_lazyDataMutex);
 	if (!m_constructorType)
-		m_constructorType = FunctionType::newExpressionType(m_contract);
+		m_constructorType = move(constructorType);
 	return m_constructorType;
 }
 
@@ -2136,15 +2203,18 @@ MemberList::MemberMap StructType::nativeMembers(ContractDefinition const*) const
 
 TypeResult StructType::interfaceType(bool _inLibrary) const
 {
-	if (_inLibrary && m_interfaceType_library.is_initialized())
-		return *m_interfaceType_library;
+	{
+		lock_guard<mutex> lock(m_lazyDataMutex);
+		if (_inLibrary && m_interfaceType_library.is_initialized())
+			return *m_interfaceType_library;
 
-	if (!_inLibrary && m_interfaceType.is_initialized())
-		return *m_interfaceType;
+		if (!_inLibrary && m_interfaceType.is_initialized())
+			return *m_interfaceType;
+	}
 
 	TypeResult result{TypePointer{}};
 
-	m_recursive = false;
+	bool isRecursive = false;
 
 	auto visitor = [&](
 		StructDefinition const& _struct,
@@ -2172,11 +2242,11 @@ TypeResult StructType::interfaceType(bool _inLibrary) const
 
 			if (StructType const* innerStruct = dynamic_cast<StructType const*>(memberType))
 				if (
-					innerStruct->m_recursive == true ||
+					innerStruct->knownRecursive() == true ||
 					_cycleDetector.run(innerStruct->structDefinition())
 				)
 				{
-					m_recursive = true;
+					isRecursive = true;
 					if (_inLibrary && location() == DataLocation::Storage)
 						continue;
 					else
@@ -2196,12 +2266,18 @@ TypeResult StructType::interfaceType(bool _inLibrary) const
 		}
 	};
 
-	m_recursive = m_recursive.get() || (CycleDetector<StructDefinition>(visitor).run(structDefinition()) != nullptr);
+	isRecursive = isRecursive || (CycleDetector<StructDefinition>(visitor).run(structDefinition()) != nullptr);
 
 	std::string const recursiveErrMsg = "Recursive type not allowed for public or external contract functions.";
 
+	lock_guard<mutex> lock(m_lazyDataMutex);
+	m_recursive = isRecursive;
+
 	if (_inLibrary)
 	{
+		if (m_interfaceType_library.is_initialized())
+			return *m_interfaceType_library;
+
 		if (!result.message().empty())
 			m_interfaceType_library = result;
 		else if (location() == DataLocation::Storage)
@@ -2209,13 +2285,16 @@ TypeResult StructType::interfaceType(bool _inLibrary) const
 		else
 			m_interfaceType_library = copyForLocation(DataLocation::Memory, true);
 
-		if (m_recursive.get())
+		if (isRecursive && !m_interfaceType.is_initialized())
 			m_interfaceType = TypeResult::err(recursiveErrMsg);
 
 		return *m_interfaceType_library;
 	}
 
-	if (m_recursive.get())
+	if (m_interfaceType.is_initialized())
+		return *m_interfaceType;
+
+	if (isRecursive)
 		m_interfaceType = TypeResult::err(recursiveErrMsg);
 	else if (!result.message().empty())
 		m_interfaceType = result;
@@ -2225,6 +2304,22 @@ TypeResult StructType::interfaceType(bool _inLibrary) const
 	return *m_interfaceType;
 }
 
+bool StructType::recursive() const
+{
+	if (boost::optional<bool> known = knownRecursive())
+		return *known;
+
+	interfaceType(false);
+
+	return *knownRecursive();
+}
+
+boost::optional<bool> StructType::knownRecursive() const
+{
+	lock_guard<mutex> lock(m_lazyDataMutex);
+	return m_recursive;
+}
+
 TypePointer StructType::copyForLocation(DataLocation _location, bool _isPointer) const
 {
 	auto copy = make_shared<StructType>(m_struct, _location);
@@ -2515,7 +2610,7 @@ FunctionType::FunctionType(VariableDeclaration const& _varDecl):
 				break;
 			returnType = arrayType->baseType();
 			m_parameterNames.emplace_back("");
-			m_parameterTypes.push_back(make_shared<IntegerType>(256));
+			m_parameterTypes.push_back(TypeProvider::uint256());
 		}
 		else
 			break;
@@ -2952,7 +3047,7 @@ MemberList::MemberMap FunctionType::nativeMembers(ContractDefinition const*) con
 	{
 		MemberList::MemberMap members;
 		if (m_kind == Kind::External)
-			members.emplace_back("selector", make_shared<FixedBytesType>(4));
+			members.emplace_back("selector", TypeProvider::fixedBytes(4));
 		if (m_kind != Kind::BareDelegateCall)
 		{
 			if (isPayable())
@@ -3508,31 +3603,31 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 	{
 	case Kind::Block:
 		return MemberList::MemberMap({
-			{"coinbase", make_shared<AddressType>(StateMutability::Payable)},
-			{"timestamp", make_shared<IntegerType>(256)},
+			{"coinbase", TypeProvider::payableAddress()},
+			{"timestamp", TypeProvider::uint256()},
 			{"blockhash", make_shared<FunctionType>(strings{"uint"}, strings{"bytes32"}, FunctionType::Kind::BlockHash, false, StateMutability::View)},
-			{"difficulty", make_shared<IntegerType>(256)},
-			{"number", make_shared<IntegerType>(256)},
-			{"gaslimit", make_shared<IntegerType>(256)}
+			{"difficulty", TypeProvider::uint256()},
+			{"number", TypeProvider::uint256()},
+			{"gaslimit", TypeProvider::uint256()}
 		});
 	case Kind::Message:
 		return MemberList::MemberMap({
-			{"sender", make_shared<AddressType>(StateMutability::Payable)},
-			{"gas", make_shared<IntegerType>(256)},
-			{"value", make_shared<IntegerType>(256)},
-			{"data", make_shared<ArrayType>(DataLocation::CallData)},
-			{"sig", make_shared<FixedBytesType>(4)}
+			{"sender", TypeProvider::payableAddress()},
+			{"gas", TypeProvider::uint256()},
+			{"value", TypeProvider::uint256()},
+			{"data", TypeProvider::bytesCalldata()},
+			{"sig", TypeProvider::fixedBytes(4)}
 		});
 	case Kind::Transaction:
 		return MemberList::MemberMap({
-			{"origin", make_shared<AddressType>(StateMutability::Payable)},
-			{"gasprice", make_shared<IntegerType>(256)}
+			{"origin", TypeProvider::payableAddress()},
+			{"gasprice", TypeProvider::uint256()}
 		});
 	case Kind::ABI:
 		return MemberList::MemberMap({
 			{"encode", make_shared<FunctionType>(
 				TypePointers(),
-				TypePointers{make_shared<ArrayType>(DataLocation::Memory)},
+				TypePointers{TypeProvider::bytesMemory()},
 				strings{},
 				strings{1, ""},
 				FunctionType::Kind::ABIEncode,
@@ -3541,7 +3636,7 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 			)},
 			{"encodePacked", make_shared<FunctionType>(
 				TypePointers(),
-				TypePointers{make_shared<ArrayType>(DataLocation::Memory)},
+				TypePointers{TypeProvider::bytesMemory()},
 				strings{},
 				strings{1, ""},
 				FunctionType::Kind::ABIEncodePacked,
@@ -3549,8 +3644,8 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 				StateMutability::Pure
 			)},
 			{"encodeWithSelector", make_shared<FunctionType>(
-				TypePointers{make_shared<FixedBytesType>(4)},
-				TypePointers{make_shared<ArrayType>(DataLocation::Memory)},
+				TypePointers{TypeProvider::fixedBytes(4)},
+				TypePointers{TypeProvider::bytesMemory()},
 				strings{1, ""},
 				strings{1, ""},
 				FunctionType::Kind::ABIEncodeWithSelector,
@@ -3558,8 +3653,8 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 				StateMutability::Pure
 			)},
 			{"encodeWithSignature", make_shared<FunctionType>(
-				TypePointers{make_shared<ArrayType>(DataLocation::Memory, true)},
-				TypePointers{make_shared<ArrayType>(DataLocation::Memory)},
+				TypePointers{TypeProvider::stringMemory()},
+				TypePointers{TypeProvider::bytesMemory()},
 				strings{1, ""},
 				strings{1, ""},
 				FunctionType::Kind::ABIEncodeWithSignature,
@@ -3585,9 +3680,9 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 		ContractDefinition const& contract = dynamic_cast<ContractType const&>(*m_typeArgument).contractDefinition();
 		if (contract.canBeDeployed())
 			return MemberList::MemberMap({
-				{"creationCode", make_shared<ArrayType>(DataLocation::Memory)},
-				{"runtimeCode", make_shared<ArrayType>(DataLocation::Memory)},
-				{"name", make_shared<ArrayType>(DataLocation::Memory, true)},
+				{"creationCode", TypeProvider::bytesMemory()},
+				{"runtimeCode", TypeProvider::bytesMemory()},
+				{"name", TypeProvider::stringMemory()},
 			});
 		else
 			return {};
@@ -37,6 +37,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -139,8 +140,12 @@ public:
 	MemberMap::const_iterator end() const { return m_memberTypes.end(); }
 
 private:
+	/// @returns the storage offsets of the members, computing them on first use.
+	StorageOffsets const& storageOffsets() const;
+
 	MemberMap m_memberTypes;
-	mutable std::unique_ptr<StorageOffsets> m_storageOffsets;
+	/// Only accessed atomically, since member lists are shared between threads.
+	mutable std::shared_ptr<StorageOffsets const> m_storageOffsets;
 };
 
 static_assert(std::is_nothrow_move_constructible<MemberList>::value, "MemberList should be noexcept move constructible");
@@ -327,6 +332,10 @@ protected:
 
 	/// List of member types (parameterised by scape), will be lazy-initialized.
 	mutable std::map<ContractDefinition const*, std::unique_ptr<MemberList>> m_members;
+	/// Guards @a m_members and the data that derived types compute on first use, since types
+	/// are shared by the threads that compile contracts in parallel. It is not held while
+	/// the data is computed, which can involve other types, and the first result is kept.
+	mutable std::mutex m_lazyDataMutex;
 };
 
 /**
@@ -857,15 +866,7 @@ public:
 	}
 	TypeResult interfaceType(bool _inLibrary) const override;
 
-	bool recursive() const
-	{
-		if (m_recursive.is_initialized())
-			return m_recursive.get();
-
-		interfaceType(false);
-
-		return m_recursive.get();
-	}
+	bool recursive() const;
 
 	TypePointer copyForLocation(DataLocation _location, bool _isPointer) const override;
 
@@ -887,6 +888,9 @@ public:
 	/// @returns the set of all members that are removed in the memory version (typically mappings).
 	std::set<std::string> membersMissingInMemory() const;
 private:
+	/// @returns whether the struct is recursive if that was already determined.
+	boost::optional<bool> knownRecursive() const;
+
 	StructDefinition const& m_struct;
 	// Caches for interfaceType(bool)
 	mutable boost::optional<TypeResult> m_interfaceType;
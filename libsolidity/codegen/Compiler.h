@@ -35,11 +35,19 @@ namespace solidity {
 class Compiler
 {
 public:
-	explicit Compiler(langutil::EVMVersion _evmVersion, OptimiserSettings _optimiserSettings):
+	/// @param _assemblyCache cache for generated inline assembly blocks, not owned and can be null.
+	explicit Compiler(
+		langutil::EVMVersion _evmVersion,
+		OptimiserSettings _optimiserSettings,
+		GeneratedAssemblyCache* _assemblyCache = nullptr
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_runtimeContext(_evmVersion),
 		m_context(_evmVersion, &m_runtimeContext)
-	{ }
+	{
+		m_runtimeContext.setGeneratedAssemblyCache(_assemblyCache);
+		m_context.setGeneratedAssemblyCache(_assemblyCache);
+	}
 
 	/// Compiles a contract.
 	/// @arg _metadata contains the to be injected metadata CBOR
@@ -25,6 +25,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/GeneratedAssemblyCache.h>
 #include <libsolidity/interface/Version.h>
 
 #include <libyul/AsmParser.h>
@@ -172,14 +173,14 @@ shared_ptr<eth::Assembly> CompilerContext::compiledContract(ContractDefinition c
 {
 	auto ret = m_otherCompilers.find(&_contract);
 	solAssert(ret != m_otherCompilers.end(), "Compiled contract not found.");
-	return ret->second->assemblyPtr();
+	return ret->second->assemblyPtr()->deepCopy();
 }
 
 shared_ptr<eth::Assembly> CompilerContext::compiledContractRuntime(ContractDefinition const& _contract) const
 {
 	auto ret = m_otherCompilers.find(&_contract);
 	solAssert(ret != m_otherCompilers.end(), "Compiled contract not found.");
-	return ret->second->runtimeAssemblyPtr();
+	return ret->second->runtimeAssemblyPtr()->deepCopy();
 }
 
 bool CompilerContext::isLocalVariable(Declaration const* _declaration) const
@@ -381,11 +382,6 @@ void CompilerContext::appendInlineAssembly(
 
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
-	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
-	auto parserResult = yul::Parser(errorReporter, yul::EVMDialect::strictAssemblyForEVM(m_evmVersion)).parse(scanner, false);
-#ifdef SOL_OUTPUT_ASM
-	cout << yul::AsmPrinter()(*parserResult) << endl;
-#endif
 
 	auto reportError = [&](string const& _context)
 	{
@@ -405,43 +401,80 @@ void CompilerContext::appendInlineAssembly(
 		solAssert(false, message);
 	};
 
-	yul::AsmAnalysisInfo analysisInfo;
-	bool analyzerResult = false;
-	if (parserResult)
-		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
-			errorReporter,
-			boost::none,
-			yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
-			identifierAccess.resolve
-		).analyze(*parserResult);
-	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
-		reportError("Invalid assembly generated by code generator.");
-
 	// Several optimizer steps cannot handle externally supplied stack variables,
 	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	bool const optimize = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+	GeneratedAssemblyCache::Key cacheKey{
+		_assembly,
+		_localVariables,
+		_externallyUsedFunctions,
+		m_evmVersion,
+		optimize,
+		optimize && _optimiserSettings.optimizeStackAllocation
+	};
+	yul::AsmAnalysisInfo analysisInfo;
+	shared_ptr<yul::Block const> code;
+	if (m_generatedAssemblyCache)
+		code = m_generatedAssemblyCache->find(cacheKey);
+	if (code)
 	{
-		yul::OptimiserSuite::run(
-			yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
-			*parserResult,
-			analysisInfo,
-			_optimiserSettings.optimizeStackAllocation,
-			externallyUsedIdentifiers
-		);
-		analysisInfo = yul::AsmAnalysisInfo{};
+		// The analysis refers to the AST nodes, so it is not cached.
 		if (!yul::AsmAnalyzer(
 			analysisInfo,
 			errorReporter,
 			boost::none,
 			yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
 			identifierAccess.resolve
-		).analyze(*parserResult))
-			reportError("Optimizer introduced error into inline assembly.");
+		).analyze(*code))
+			reportError("Failed to analyze cached inline assembly block.");
+	}
+	else
+	{
+		auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
+		auto parserResult = yul::Parser(errorReporter, yul::EVMDialect::strictAssemblyForEVM(m_evmVersion)).parse(scanner, false);
 #ifdef SOL_OUTPUT_ASM
-		cout << "After optimizer: " << endl;
 		cout << yul::AsmPrinter()(*parserResult) << endl;
 #endif
+
+		bool analyzerResult = false;
+		if (parserResult)
+			analyzerResult = yul::AsmAnalyzer(
+				analysisInfo,
+				errorReporter,
+				boost::none,
+				yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
+				identifierAccess.resolve
+			).analyze(*parserResult);
+		if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
+			reportError("Invalid assembly generated by code generator.");
+
+		if (optimize)
+		{
+			yul::OptimiserSuite::run(
+				yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
+				*parserResult,
+				analysisInfo,
+				_optimiserSettings.optimizeStackAllocation,
+				externallyUsedIdentifiers,
+				_optimiserSettings.yulOptimiserThreads
+			);
+			analysisInfo = yul::AsmAnalysisInfo{};
+			if (!yul::AsmAnalyzer(
+				analysisInfo,
+				errorReporter,
+				boost::none,
+				yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
+				identifierAccess.resolve
+			).analyze(*parserResult))
+				reportError("Optimizer introduced error into inline assembly.");
+#ifdef SOL_OUTPUT_ASM
+			cout << "After optimizer: " << endl;
+			cout << yul::AsmPrinter()(*parserResult) << endl;
+#endif
+		}
+		code = std::move(parserResult);
+		if (m_generatedAssemblyCache)
+			m_generatedAssemblyCache->store(std::move(cacheKey), code);
 	}
 
 	if (!errorReporter.errors().empty())
@@ -449,7 +482,7 @@ void CompilerContext::appendInlineAssembly(
 
 	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
 	yul::CodeGenerator::assemble(
-		*parserResult,
+		*code,
 		analysisInfo,
 		*m_asm,
 		m_evmVersion,
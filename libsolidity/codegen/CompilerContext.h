@@ -44,6 +44,7 @@ namespace dev {
 namespace solidity {
 
 class Compiler;
+class GeneratedAssemblyCache;
 
 /**
  * Context to be shared by all units that compile the same contract.
@@ -78,6 +79,8 @@ public:
 	unsigned numberOfLocalVariables() const;
 
 	void setOtherCompilers(std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers) { m_otherCompilers = _otherCompilers; }
+	/// @returns a copy of the assembly of a contract compiled before, so that optimising
+	/// this contract does not modify the assembly of the other one.
 	std::shared_ptr<eth::Assembly> compiledContract(ContractDefinition const& _contract) const;
 	std::shared_ptr<eth::Assembly> compiledContractRuntime(ContractDefinition const& _contract) const;
 
@@ -136,6 +139,10 @@ public:
 	void appendMissingLowLevelFunctions();
 	ABIFunctions& abiFunctions() { return m_abiFunctions; }
 
+	/// Sets the cache used for the inline assembly blocks generated by @a appendInlineAssembly.
+	/// No blocks are cached if it is not set.
+	void setGeneratedAssemblyCache(GeneratedAssemblyCache* _cache) { m_generatedAssemblyCache = _cache; }
+
 	ModifierDefinition const& resolveVirtualFunctionModifier(ModifierDefinition const& _modifier) const;
 	/// Returns the distance of the given local variable from the bottom of the stack (of the current function).
 	unsigned baseStackOffsetOfVariable(Declaration const& _declaration) const;
@@ -336,6 +343,8 @@ private:
 	ABIFunctions m_abiFunctions;
 	/// The queue of low-level functions to generate.
 	std::queue<std::tuple<std::string, unsigned, unsigned, std::function<void(CompilerContext&)>>> m_lowLevelFunctionGenerationQueue;
+	/// Cache for generated inline assembly blocks, not owned.
+	GeneratedAssemblyCache* m_generatedAssemblyCache = nullptr;
 };
 
 }
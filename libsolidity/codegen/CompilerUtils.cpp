@@ -23,6 +23,7 @@
 #include <libsolidity/codegen/CompilerUtils.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/ArrayUtils.h>
 #include <libsolidity/codegen/LValue.h>
@@ -89,7 +90,7 @@ void CompilerUtils::revertWithStringData(Type const& _argumentType)
 	m_context << Instruction::DUP2 << Instruction::MSTORE;
 	m_context << u256(4) << Instruction::ADD;
 	// Stack: <string data> <mem pos of encoding start>
-	abiEncode({_argumentType.shared_from_this()}, {make_shared<ArrayType>(DataLocation::Memory, true)});
+	abiEncode({_argumentType.shared_from_this()}, {TypeProvider::stringMemory()});
 	toSizeAfterFreeMemoryPointer();
 	m_context << Instruction::REVERT;
 }
@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache of the inline assembly blocks generated by the code generator.
+ */
+
+#include <libsolidity/codegen/GeneratedAssemblyCache.h>
+
+#include <libyul/AsmData.h>
+#include <libyul/YulString.h>
+
+#include <tuple>
+
+using namespace std;
+using namespace dev::solidity;
+
+bool GeneratedAssemblyCache::Key::operator<(Key const& _other) const
+{
+	return
+		tie(assembly, localVariables, externallyUsedFunctions, evmVersion, optimize, optimizeStackAllocation) <
+		tie(_other.assembly, _other.localVariables, _other.externallyUsedFunctions, _other.evmVersion, _other.optimize, _other.optimizeStackAllocation);
+}
+
+shared_ptr<yul::Block const> GeneratedAssemblyCache::find(Key const& _key)
+{
+	lock_guard<mutex> lock(m_mutex);
+	checkRepository();
+	auto it = m_blocks.find(_key);
+	if (it == m_blocks.end())
+		return nullptr;
+	m_hits++;
+	return it->second;
+}
+
+void GeneratedAssemblyCache::store(Key _key, shared_ptr<yul::Block const> _block)
+{
+	lock_guard<mutex> lock(m_mutex);
+	checkRepository();
+	m_blocks.emplace(std::move(_key), std::move(_block));
+}
+
+void GeneratedAssemblyCache::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_blocks.clear();
+	m_hits = 0;
+}
+
+size_t GeneratedAssemblyCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_blocks.size();
+}
+
+size_t GeneratedAssemblyCache::hits() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_hits;
+}
+
+void GeneratedAssemblyCache::checkRepository()
+{
+	uint64_t generation = yul::YulStringRepository::instance().generation();
+	if (generation == m_repositoryGeneration)
+		return;
+	m_blocks.clear();
+	m_hits = 0;
+	m_repositoryGeneration = generation;
+}
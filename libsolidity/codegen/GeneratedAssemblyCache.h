@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache of the inline assembly blocks generated by the code generator.
+ */
+
+#pragma once
+
+#include <liblangutil/EVMVersion.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace yul
+{
+struct Block;
+}
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Parsed and (optionally) optimised inline assembly blocks generated by the code generator,
+ * shared by the contracts compiled by one CompilerStack. The same blocks are generated for
+ * many call sites and contracts.
+ * The blocks refer to the YulString repository that was active when they were stored, so the
+ * cache is emptied when it is used with a different repository.
+ */
+class GeneratedAssemblyCache: boost::noncopyable
+{
+public:
+	struct Key
+	{
+		std::string assembly;
+		std::vector<std::string> localVariables;
+		std::set<std::string> externallyUsedFunctions;
+		langutil::EVMVersion evmVersion;
+		bool optimize;
+		bool optimizeStackAllocation;
+
+		bool operator<(Key const& _other) const;
+	};
+
+	/// @returns the block stored for @a _key or nullptr if there is none.
+	std::shared_ptr<yul::Block const> find(Key const& _key);
+	void store(Key _key, std::shared_ptr<yul::Block const> _block);
+	void clear();
+
+	/// @returns the number of stored blocks.
+	size_t size() const;
+	/// @returns the number of blocks found since the cache was last emptied.
+	size_t hits() const;
+
+private:
+	/// Empties the cache if the current YulString repository is not the one of the blocks.
+	/// Requires @a m_mutex to be locked.
+	void checkRepository();
+
+	mutable std::mutex m_mutex;
+	/// Generation of the YulString repository of the blocks, zero if there are none.
+	std::uint64_t m_repositoryGeneration = 0;
+	std::map<Key, std::shared_ptr<yul::Block const>> m_blocks;
+	size_t m_hits = 0;
+};
+
+}
+}
@@ -24,18 +24,24 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
 
-CVC4Interface::CVC4Interface():
-	m_solver(&m_context)
+CVC4Interface::CVC4Interface(unsigned _queryTimeout):
+	m_solver(&m_context),
+	m_queryTimeout(_queryTimeout)
 {
 	reset();
 }
 
+string CVC4Interface::version()
+{
+	return CVC4::Configuration::getVersionString();
+}
+
 void CVC4Interface::reset()
 {
 	m_variables.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
-	m_solver.setTimeLimit(queryTimeout);
+	m_solver.setTimeLimit(m_queryTimeout);
 }
 
 void CVC4Interface::push()
@@ -48,10 +54,11 @@ void CVC4Interface::pop()
 	m_solver.pop();
 }
 
-void CVC4Interface::declareVariable(string const& _name, Sort const& _sort)
+void CVC4Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
+	solAssert(_sort, "");
 	if (!m_variables.count(_name))
-		m_variables.insert({_name, m_context.mkVar(_name.c_str(), cvc4Sort(_sort))});
+		m_variables.insert({_name, m_context.mkVar(_name.c_str(), cvc4Sort(*_sort))});
 }
 
 void CVC4Interface::addAssertion(Expression const& _expr)
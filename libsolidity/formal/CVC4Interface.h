@@ -43,18 +43,23 @@ namespace smt
 class CVC4Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	CVC4Interface();
+	explicit CVC4Interface(unsigned _queryTimeout);
 
 	void reset() override;
 
 	void push() override;
 	void pop() override;
 
-	void declareVariable(std::string const&, Sort const&) override;
+	void declareVariable(std::string const&, SortPointer const&) override;
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	void interrupt() override { m_solver.interrupt(); }
+
+	/// @returns the version of the linked CVC4 library.
+	static std::string version();
+
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
 	CVC4::Type cvc4Sort(smt::Sort const& _sort);
@@ -63,6 +68,7 @@ private:
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
+	unsigned m_queryTimeout;
 };
 
 }
@@ -20,6 +20,7 @@
 #include <libsolidity/formal/SMTPortfolio.h>
 #include <libsolidity/formal/VariableUsage.h>
 #include <libsolidity/formal/SymbolicTypes.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <libdevcore/StringUtils.h>
 
@@ -28,13 +29,19 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/optional.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-SMTChecker::SMTChecker(ErrorReporter& _errorReporter, map<h256, string> const& _smtlib2Responses):
-	m_interface(make_shared<smt::SMTPortfolio>(_smtlib2Responses)),
+SMTChecker::SMTChecker(
+	ErrorReporter& _errorReporter,
+	map<h256, string> const& _smtlib2Responses,
+	smt::SolverSettings const& _solverSettings
+):
+	m_interface(make_shared<smt::SMTPortfolio>(_smtlib2Responses, _solverSettings)),
 	m_errorReporterReference(_errorReporter),
 	m_errorReporter(m_smtErrors)
 {
@@ -429,41 +436,54 @@ void SMTChecker::addOverflowTarget(
 
 void SMTChecker::checkUnderOverflow()
 {
+	vector<smt::SMTPortfolio::Query> queries;
+	vector<vector<string>> expressionNames;
+	for (auto const& target: m_overflowTargets)
+	{
+		auto intType = dynamic_cast<IntegerType const*>(target.intType.get());
+		if (target.type != OverflowTarget::Type::Overflow)
+		{
+			auto query = conditionQuery(target.path && target.value < minValue(*intType), "<result>", &target.value);
+			queries.emplace_back(move(query.first));
+			expressionNames.emplace_back(move(query.second));
+		}
+		if (target.type != OverflowTarget::Type::Underflow)
+		{
+			auto query = conditionQuery(target.path && target.value > maxValue(*intType), "<result>", &target.value);
+			queries.emplace_back(move(query.first));
+			expressionNames.emplace_back(move(query.second));
+		}
+	}
+	auto results = checkQueries(queries);
+
+	size_t index = 0;
 	for (auto& target: m_overflowTargets)
 	{
 		swap(m_callStack, target.callStack);
 		if (target.type != OverflowTarget::Type::Overflow)
-			checkUnderflow(target);
+		{
+			reportCondition(queries[index], expressionNames[index], results[index], target.location, underflowDescription(target));
+			++index;
+		}
 		if (target.type != OverflowTarget::Type::Underflow)
-			checkOverflow(target);
+		{
+			reportCondition(queries[index], expressionNames[index], results[index], target.location, overflowDescription(target));
+			++index;
+		}
 		swap(m_callStack, target.callStack);
 	}
 }
 
-void SMTChecker::checkUnderflow(OverflowTarget& _target)
+string SMTChecker::underflowDescription(OverflowTarget const& _target)
 {
-	solAssert(_target.type != OverflowTarget::Type::Overflow, "");
 	auto intType = dynamic_cast<IntegerType const*>(_target.intType.get());
-	checkCondition(
-		_target.path && _target.value < minValue(*intType),
-		_target.location,
-		"Underflow (resulting value less than " + formatNumberReadable(intType->minValue()) + ")",
-		"<result>",
-		&_target.value
-	);
+	return "Underflow (resulting value less than " + formatNumberReadable(intType->minValue()) + ")";
 }
 
-void SMTChecker::checkOverflow(OverflowTarget& _target)
+string SMTChecker::overflowDescription(OverflowTarget const& _target)
 {
-	solAssert(_target.type != OverflowTarget::Type::Underflow, "");
 	auto intType = dynamic_cast<IntegerType const*>(_target.intType.get());
-	checkCondition(
-		_target.path && _target.value > maxValue(*intType),
-		_target.location,
-		"Overflow (resulting value larger than " + formatNumberReadable(intType->maxValue()) + ")",
-		"<result>",
-		&_target.value
-	);
+	return "Overflow (resulting value larger than " + formatNumberReadable(intType->maxValue()) + ")";
 }
 
 void SMTChecker::endVisit(UnaryOperation const& _op)
@@ -798,7 +818,7 @@ void SMTChecker::endVisit(Literal const& _literal)
 	{
 		if (type.category() == Type::Category::StringLiteral)
 		{
-			auto stringType = make_shared<ArrayType>(DataLocation::Memory, true);
+			auto stringType = TypeProvider::stringMemory();
 			auto stringLit = dynamic_cast<StringLiteralType const*>(_literal.annotation().type.get());
 			solAssert(stringLit, "");
 			auto result = newSymbolicVariable(*stringType, stringLit->richIdentifier(), *m_interface);
@@ -1197,7 +1217,7 @@ void SMTChecker::assignment(VariableDeclaration const& _variable, smt::Expressio
 	if (type->category() == Type::Category::Integer)
 		addOverflowTarget(OverflowTarget::Type::All, type,	_value,	_location);
 	else if (type->category() == Type::Category::Address)
-		addOverflowTarget(OverflowTarget::Type::All, make_shared<IntegerType>(160), _value, _location);
+		addOverflowTarget(OverflowTarget::Type::All, TypeProvider::integer(160), _value, _location);
 	else if (type->category() == Type::Category::Mapping)
 		arrayAssignment();
 	m_interface->addAssertion(newValue(_variable) == _value);
@@ -1229,9 +1249,17 @@ void SMTChecker::checkCondition(
 	smt::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	addPathConjoinedExpression(_condition);
+	auto query = conditionQuery(_condition, _additionalValueName, _additionalValue);
+	auto results = checkQueries({query.first});
+	reportCondition(query.first, query.second, results.front(), _location, _description);
+}
 
+pair<smt::SMTPortfolio::Query, vector<string>> SMTChecker::conditionQuery(
+	smt::Expression const& _condition,
+	string const& _additionalValueName,
+	smt::Expression const* _additionalValue
+)
+{
 	vector<smt::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
 	if (m_functionPath.size())
@@ -1242,13 +1270,18 @@ void SMTChecker::checkCondition(
 			expressionsToEvaluate.emplace_back(*_additionalValue);
 			expressionNames.push_back(_additionalValueName);
 		}
+		// Sorted by ID, so that the query does not depend on the addresses of the nodes.
+		vector<VariableDeclaration const*> variables;
 		for (auto const& var: m_variables)
-		{
 			if (var.first->type()->isValueType())
-			{
-				expressionsToEvaluate.emplace_back(currentValue(*var.first));
-				expressionNames.push_back(var.first->name());
-			}
+				variables.push_back(var.first);
+		sort(variables.begin(), variables.end(), [](VariableDeclaration const* _a, VariableDeclaration const* _b) {
+			return _a->id() < _b->id();
+		});
+		for (auto const* var: variables)
+		{
+			expressionsToEvaluate.emplace_back(currentValue(*var));
+			expressionNames.push_back(var->name());
 		}
 		for (auto const& var: m_globalContext)
 		{
@@ -1262,18 +1295,35 @@ void SMTChecker::checkCondition(
 				expressionNames.push_back(var.first);
 			}
 		}
-		for (auto const& uf: m_uninterpretedTerms)
-		{
+		vector<Expression const*> uninterpretedTerms;
+		for (auto const* uf: m_uninterpretedTerms)
 			if (uf->annotation().type->isValueType())
-			{
-				expressionsToEvaluate.emplace_back(expr(*uf));
-				expressionNames.push_back(m_scanner->sourceAt(uf->location()));
-			}
+				uninterpretedTerms.push_back(uf);
+		sort(uninterpretedTerms.begin(), uninterpretedTerms.end(), [](Expression const* _a, Expression const* _b) {
+			return _a->id() < _b->id();
+		});
+		for (auto const* uf: uninterpretedTerms)
+		{
+			expressionsToEvaluate.emplace_back(expr(*uf));
+			expressionNames.push_back(m_scanner->sourceAt(uf->location()));
 		}
 	}
-	smt::CheckResult result;
-	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	return make_pair(
+		smt::SMTPortfolio::Query{currentPathConditions() && _condition, move(expressionsToEvaluate)},
+		move(expressionNames)
+	);
+}
+
+void SMTChecker::reportCondition(
+	smt::SMTPortfolio::Query const& _query,
+	vector<string> const& _expressionNames,
+	pair<smt::CheckResult, vector<string>> const& _result,
+	SourceLocation const& _location,
+	string const& _description
+)
+{
+	smt::CheckResult result = _result.first;
+	vector<string> const& values = _result.second;
 
 	string extraComment;
 	if (m_loopExecutionHappened)
@@ -1300,11 +1350,11 @@ void SMTChecker::checkCondition(
 		{
 			std::ostringstream modelMessage;
 			modelMessage << "  for:\n";
-			solAssert(values.size() == expressionNames.size(), "");
+			solAssert(values.size() == _expressionNames.size(), "");
 			map<string, string> sortedModel;
 			for (size_t i = 0; i < values.size(); ++i)
-				if (expressionsToEvaluate.at(i).name != values.at(i))
-					sortedModel[expressionNames.at(i)] = values.at(i);
+				if (_query.expressionsToEvaluate.at(i).name != values.at(i))
+					sortedModel[_expressionNames.at(i)] = values.at(i);
 
 			for (auto const& eval: sortedModel)
 				modelMessage << "  " << eval.first << " = " << eval.second << "\n";
@@ -1335,7 +1385,6 @@ void SMTChecker::checkCondition(
 		m_errorReporter.warning(_location, "Error trying to invoke SMT solver.");
 		break;
 	}
-	m_interface->pop();
 }
 
 void SMTChecker::checkBooleanNotConstant(Expression const& _condition, string const& _description)
@@ -1344,15 +1393,12 @@ void SMTChecker::checkBooleanNotConstant(Expression const& _condition, string co
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	addPathConjoinedExpression(expr(_condition));
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
-
-	m_interface->push();
-	addPathConjoinedExpression(!expr(_condition));
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	auto results = checkQueries({
+		smt::SMTPortfolio::Query{currentPathConditions() && expr(_condition), {}},
+		smt::SMTPortfolio::Query{currentPathConditions() && !expr(_condition), {}}
+	});
+	smt::CheckResult positiveResult = results[0].first;
+	smt::CheckResult negatedResult = results[1].first;
 
 	if (positiveResult == smt::CheckResult::ERROR || negatedResult == smt::CheckResult::ERROR)
 		m_errorReporter.warning(_condition.location(), "Error trying to invoke SMT solver.");
@@ -1390,14 +1436,13 @@ void SMTChecker::checkBooleanNotConstant(Expression const& _condition, string co
 	}
 }
 
-pair<smt::CheckResult, vector<string>>
-SMTChecker::checkSatisfiableAndGenerateModel(vector<smt::Expression> const& _expressionsToEvaluate)
+vector<pair<smt::CheckResult, vector<string>>>
+SMTChecker::checkQueries(vector<smt::SMTPortfolio::Query> const& _queries)
 {
-	smt::CheckResult result;
-	vector<string> values;
+	vector<pair<smt::CheckResult, vector<string>>> results;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		results = m_interface->checkIndependently(_queries);
 	}
 	catch (smt::SolverError const& _e)
 	{
@@ -1405,25 +1450,21 @@ SMTChecker::checkSatisfiableAndGenerateModel(vector<smt::Expression> const& _exp
 		if (_e.comment())
 			description += ": " + *_e.comment();
 		m_errorReporter.warning(description);
-		result = smt::CheckResult::ERROR;
+		results.assign(_queries.size(), make_pair(smt::CheckResult::ERROR, vector<string>{}));
 	}
 
-	for (string& value: values)
-	{
-		try
+	for (auto& result: results)
+		for (string& value: result.second)
 		{
-			// Parse and re-format nicely
-			value = formatNumberReadable(bigint(value));
+			try
+			{
+				// Parse and re-format nicely
+				value = formatNumberReadable(bigint(value));
+			}
+			catch (...) { }
 		}
-		catch (...) { }
-	}
 
-	return make_pair(result, values);
-}
-
-smt::CheckResult SMTChecker::checkSatisfiable()
-{
-	return checkSatisfiableAndGenerateModel({}).first;
+	return results;
 }
 
 void SMTChecker::initializeFunctionCallParameters(CallableDeclaration const& _function, vector<smt::Expression> const& _callArgs)
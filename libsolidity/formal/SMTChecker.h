@@ -18,6 +18,7 @@
 #pragma once
 
 
+#include <libsolidity/formal/SMTPortfolio.h>
 #include <libsolidity/formal/SolverInterface.h>
 #include <libsolidity/formal/SymbolicVariables.h>
 
@@ -46,7 +47,11 @@ class VariableUsage;
 class SMTChecker: private ASTConstVisitor
 {
 public:
-	SMTChecker(langutil::ErrorReporter& _errorReporter, std::map<h256, std::string> const& _smtlib2Responses);
+	SMTChecker(
+		langutil::ErrorReporter& _errorReporter,
+		std::map<h256, std::string> const& _smtlib2Responses,
+		smt::SolverSettings const& _solverSettings = smt::SolverSettings{}
+	);
 
 	void analyze(SourceUnit const& _sources, std::shared_ptr<langutil::Scanner> const& _scanner);
 
@@ -55,6 +60,9 @@ public:
 	/// the constructor.
 	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
 
+	/// @returns the statistics for each solver over all queries so far.
+	std::vector<smt::SolverStatistics> const& solverStatistics() const { return m_interface->statistics(); }
+
 	/// @return the FunctionDefinition of a called function if possible and should inline,
 	/// otherwise nullptr.
 	static FunctionDefinition const* inlinedFunctionCallToDefinition(FunctionCall const& _funCall);
@@ -153,6 +161,21 @@ private:
 		std::string const& _additionalValueName = "",
 		smt::Expression const* _additionalValue = nullptr
 	);
+	/// @returns the query that checks whether @a _condition can be satisfied on the current path
+	/// and the names of the values to evaluate for a counterexample.
+	std::pair<smt::SMTPortfolio::Query, std::vector<std::string>> conditionQuery(
+		smt::Expression const& _condition,
+		std::string const& _additionalValueName = "",
+		smt::Expression const* _additionalValue = nullptr
+	);
+	/// Reports the result of a query created by conditionQuery.
+	void reportCondition(
+		smt::SMTPortfolio::Query const& _query,
+		std::vector<std::string> const& _expressionNames,
+		std::pair<smt::CheckResult, std::vector<std::string>> const& _result,
+		langutil::SourceLocation const& _location,
+		std::string const& _description
+	);
 	/// Checks that a boolean condition is not constant. Do not warn if the expression
 	/// is a literal constant.
 	/// @param _description the warning string, $VALUE will be replaced by the constant value.
@@ -182,18 +205,18 @@ private:
 		}
 	};
 
-	/// Checks that the value is in the range given by the type.
-	void checkUnderflow(OverflowTarget& _target);
-	void checkOverflow(OverflowTarget& _target);
-	/// Calls the functions above for all elements in m_overflowTargets accordingly.
+	/// @returns the description of the underflow or overflow of @a _target.
+	static std::string underflowDescription(OverflowTarget const& _target);
+	static std::string overflowDescription(OverflowTarget const& _target);
+	/// Checks that the values of all elements in m_overflowTargets are in the range given
+	/// by their type. The queries are independent and checked together.
 	void checkUnderOverflow();
 	/// Adds an overflow target for lazy check at the end of the function.
 	void addOverflowTarget(OverflowTarget::Type _type, TypePointer _intType, smt::Expression _value, langutil::SourceLocation const& _location);
 
-	std::pair<smt::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smt::Expression> const& _expressionsToEvaluate);
-
-	smt::CheckResult checkSatisfiable();
+	/// Checks the independent @a _queries, formatting the values of the models.
+	std::vector<std::pair<smt::CheckResult, std::vector<std::string>>>
+	checkQueries(std::vector<smt::SMTPortfolio::Query> const& _queries);
 
 	void initializeLocalVariables(FunctionDefinition const& _function);
 	void initializeFunctionCallParameters(CallableDeclaration const& _function, std::vector<smt::Expression> const& _callArgs);
@@ -271,7 +294,7 @@ private:
 	/// Resets the variable indices.
 	void resetVariableIndices(VariableIndices const& _indices);
 
-	std::shared_ptr<smt::SolverInterface> m_interface;
+	std::shared_ptr<smt::SMTPortfolio> m_interface;
 	std::shared_ptr<VariableUsage> m_variableUsage;
 	bool m_loopExecutionHappened = false;
 	bool m_arrayAssignmentHappened = false;
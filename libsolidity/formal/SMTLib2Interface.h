@@ -48,13 +48,18 @@ public:
 	void push() override;
 	void pop() override;
 
-	void declareVariable(std::string const&, Sort const&) override;
+	void declareVariable(std::string const&, SortPointer const&) override;
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
+	/// @returns the SMT-LIB2 text that is sent to the solver by check(@a _expressionsToEvaluate).
+	std::string query(std::vector<Expression> const& _expressionsToEvaluate);
+	/// @returns the names of all declared variables and functions.
+	std::set<std::string> const& symbols() const { return m_variables; }
+
 private:
 	void declareFunction(std::string const&, Sort const&);
 
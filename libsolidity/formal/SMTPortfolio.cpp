@@ -24,55 +24,148 @@
 #include <libsolidity/formal/CVC4Interface.h>
 #endif
 #include <libsolidity/formal/SMTLib2Interface.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/Parallel.h>
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 using namespace dev::solidity::smt;
 
-SMTPortfolio::SMTPortfolio(map<h256, string> const& _smtlib2Responses)
+SMTPortfolio::SMTPortfolio(map<h256, string> const& _smtlib2Responses, SolverSettings const& _settings):
+	SMTPortfolio(_smtlib2Responses, _settings, builtinSolvers(_settings))
+{
+}
+
+SMTPortfolio::SMTPortfolio(
+	map<h256, string> const& _smtlib2Responses,
+	SolverSettings const& _settings,
+	vector<NamedSolver> _solvers
+):
+	m_smtlib2Responses(_smtlib2Responses),
+	m_settings(_settings)
+{
+	m_trail.push_back({m_nextFrameId++, {}});
+	_solvers.insert(_solvers.begin(), {"smtlib2", "", make_shared<smt::SMTLib2Interface>(_smtlib2Responses)});
+	string solverVersions;
+	for (auto& solver: _solvers)
+	{
+		solverVersions += solver.name + " " + solver.version + "\n";
+		m_solvers.emplace_back(move(solver.solver));
+		m_statistics.emplace_back();
+		m_statistics.back().solver = move(solver.name);
+	}
+	if (!_settings.cacheDirectory.empty())
+	{
+		m_cache = make_shared<SMTQueryCache>(_settings.cacheDirectory, solverVersions);
+		m_statistics.emplace_back();
+		m_statistics.back().solver = "cache";
+	}
+}
+
+SMTPortfolio::~SMTPortfolio() = default;
+
+vector<SMTPortfolio::NamedSolver> SMTPortfolio::builtinSolvers(SolverSettings const& _settings)
 {
-	m_solvers.emplace_back(make_shared<smt::SMTLib2Interface>(_smtlib2Responses));
+	vector<NamedSolver> solvers;
 #ifdef HAVE_Z3
-	m_solvers.emplace_back(make_shared<smt::Z3Interface>());
+	solvers.push_back({"z3", Z3Interface::version(), make_shared<smt::Z3Interface>(_settings.queryTimeout)});
 #endif
 #ifdef HAVE_CVC4
-	m_solvers.emplace_back(make_shared<smt::CVC4Interface>());
+	solvers.push_back({"cvc4", CVC4Interface::version(), make_shared<smt::CVC4Interface>(_settings.queryTimeout)});
 #endif
+	(void)_settings;
+	return solvers;
 }
 
 void SMTPortfolio::reset()
 {
 	for (auto s : m_solvers)
 		s->reset();
+	m_trail.clear();
+	m_trail.push_back({m_nextFrameId++, {}});
 }
 
 void SMTPortfolio::push()
 {
 	for (auto s : m_solvers)
 		s->push();
+	m_trail.push_back({m_nextFrameId++, {}});
 }
 
 void SMTPortfolio::pop()
 {
 	for (auto s : m_solvers)
 		s->pop();
+	solAssert(m_trail.size() > 1, "");
+	m_trail.pop_back();
 }
 
-void SMTPortfolio::declareVariable(string const& _name, Sort const& _sort)
+void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	for (auto s : m_solvers)
 		s->declareVariable(_name, _sort);
+	if (m_settings.threads > 1)
+		m_trail.back().entries.emplace_back([=](SolverInterface& _solver) { _solver.declareVariable(_name, _sort); });
 }
 
 void SMTPortfolio::addAssertion(Expression const& _expr)
 {
 	for (auto s : m_solvers)
 		s->addAssertion(_expr);
+	if (m_settings.threads > 1)
+		m_trail.back().entries.emplace_back([=](SolverInterface& _solver) { _solver.addAssertion(_expr); });
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
+{
+	boost::optional<SMTQueryCache::Query> cachedQuery;
+	if (m_cache)
+	{
+		SolverStatistics& statistics = m_statistics.back();
+		auto start = chrono::steady_clock::now();
+		cachedQuery = SMTQueryCache::normalise(smtlib2().query(_expressionsToEvaluate), smtlib2().symbols());
+		auto result = m_cache->lookup(*cachedQuery);
+		statistics.time += chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+		statistics.queries++;
+		if (result)
+		{
+			statistics.answers++;
+			statistics.firstAnswers++;
+			return std::move(*result);
+		}
+	}
+
+	unsigned smtlib2Answers = m_statistics.front().answers;
+	pair<CheckResult, vector<string>> result;
+	if (!m_settings.race || m_solvers.size() == 1)
+		result = checkConsensus(_expressionsToEvaluate);
+	else
+		result = checkRace(_expressionsToEvaluate);
+	// Answers of the SMT-LIB2 interface come from the responses given to the compiler,
+	// which are not part of the key, so only the answers of the other solvers are stored.
+	if (cachedQuery && solverAnswered(result.first) && m_statistics.front().answers == smtlib2Answers)
+		m_cache->store(*cachedQuery, result);
+	return result;
+}
+
+void SMTPortfolio::interrupt()
+{
+	for (auto s : m_solvers)
+		s->interrupt();
 }
 
 /*
- * Broadcasts the SMT query to all solvers and returns a single result.
+ * Broadcasts the SMT query to all solvers one after the other and returns a single result.
  * This comment explains how this result is decided.
  *
  * When a solver is queried, there are four possible answers:
@@ -101,19 +194,24 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *
  *   If all solvers return ERROR, the result is ERROR.
 */
-pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
+pair<CheckResult, vector<string>> SMTPortfolio::checkConsensus(vector<Expression> const& _expressionsToEvaluate)
 {
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto s : m_solvers)
+	for (size_t i = 0; i < m_solvers.size(); ++i)
 	{
 		CheckResult result;
 		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
+		auto start = chrono::steady_clock::now();
+		tie(result, values) = m_solvers[i]->check(_expressionsToEvaluate);
+		m_statistics[i].time += chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+		m_statistics[i].queries++;
 		if (solverAnswered(result))
 		{
+			m_statistics[i].answers++;
 			if (!solverAnswered(lastResult))
 			{
+				m_statistics[i].firstAnswers++;
 				lastResult = result;
 				finalValues = std::move(values);
 			}
@@ -129,13 +227,208 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 	return make_pair(lastResult, finalValues);
 }
 
+/*
+ * Asks the SMT-LIB2 interface and, if it has no answer, runs the SMT query on all other
+ * solvers in parallel. The SMT-LIB2 interface is not part of the race, so that the queries
+ * it reports as unhandled do not depend on timing.
+ * The first SAT or UNSAT answer is returned and the remaining solvers are interrupted.
+ * Conflicting answers are not detected.
+ * If no solver answers the query, the result is decided as in checkConsensus.
+ */
+pair<CheckResult, vector<string>> SMTPortfolio::checkRace(vector<Expression> const& _expressionsToEvaluate)
+{
+	auto start = chrono::steady_clock::now();
+	auto smtlib2Result = m_solvers.front()->check(_expressionsToEvaluate);
+	m_statistics.front().time += chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+	m_statistics.front().queries++;
+	if (solverAnswered(smtlib2Result.first))
+	{
+		m_statistics.front().answers++;
+		m_statistics.front().firstAnswers++;
+		return smtlib2Result;
+	}
+	CheckResult finalResult = smtlib2Result.first == CheckResult::UNKNOWN ? CheckResult::UNKNOWN : CheckResult::ERROR;
+
+	size_t const racing = m_solvers.size() - 1;
+	vector<pair<CheckResult, vector<string>>> results(racing, {CheckResult::UNKNOWN, {}});
+	vector<chrono::steady_clock::duration> times(racing);
+	vector<bool> started(racing, false);
+	vector<bool> running(racing, false);
+	mutex raceMutex;
+	condition_variable solverFinished;
+	boost::optional<size_t> winner;
+	if (!m_pool)
+		m_pool = make_unique<ThreadPool>();
+	m_pool->parallelFor(racing, racing, [&](size_t _index)
+	{
+		SolverInterface& solver = *m_solvers[_index + 1];
+		{
+			lock_guard<mutex> lock(raceMutex);
+			// Latched: solvers that would only start after the race is decided are not run.
+			if (winner)
+				return;
+			started[_index] = running[_index] = true;
+		}
+		auto start = chrono::steady_clock::now();
+		auto result = solver.check(_expressionsToEvaluate);
+		times[_index] = chrono::steady_clock::now() - start;
+
+		unique_lock<mutex> lock(raceMutex);
+		running[_index] = false;
+		results[_index] = std::move(result);
+		solverFinished.notify_all();
+		if (winner || !solverAnswered(results[_index].first))
+			return;
+		winner = _index;
+		// An interrupt is lost if it reaches a solver just before its check started,
+		// so the others are interrupted until they have returned.
+		while (find(running.begin(), running.end(), true) != running.end())
+		{
+			for (size_t i = 0; i < racing; ++i)
+				if (running[i])
+					m_solvers[i + 1]->interrupt();
+			solverFinished.wait_for(lock, chrono::milliseconds(10));
+		}
+	});
+
+	for (size_t i = 0; i < racing; ++i)
+	{
+		if (!started[i])
+			continue;
+		SolverStatistics& statistics = m_statistics[i + 1];
+		statistics.queries++;
+		statistics.time += chrono::duration_cast<chrono::milliseconds>(times[i]);
+		if (solverAnswered(results[i].first))
+			statistics.answers++;
+		else if (results[i].first == CheckResult::UNKNOWN)
+			finalResult = CheckResult::UNKNOWN;
+	}
+	if (!winner)
+		return make_pair(finalResult, vector<string>{});
+	m_statistics[*winner + 1].firstAnswers++;
+	return std::move(results[*winner]);
+}
+
+vector<pair<CheckResult, vector<string>>> SMTPortfolio::checkIndependently(vector<Query> const& _queries)
+{
+	vector<pair<CheckResult, vector<string>>> results(_queries.size());
+	size_t threads = min<size_t>(m_settings.threads, _queries.size());
+	if (threads <= 1)
+	{
+		for (size_t i = 0; i < _queries.size(); ++i)
+		{
+			push();
+			addAssertion(_queries[i].assertion);
+			results[i] = check(_queries[i].expressionsToEvaluate);
+			pop();
+		}
+		return results;
+	}
+
+	if (m_workers.size() < threads)
+	{
+		SolverSettings settings = m_settings;
+		settings.threads = 1;
+		m_workers.resize(threads);
+		for (Worker& worker: m_workers)
+			if (!worker.portfolio)
+			{
+				worker.portfolio = make_unique<SMTPortfolio>(m_smtlib2Responses, settings);
+				worker.reportedStatistics = worker.portfolio->statistics();
+			}
+	}
+	if (!m_pool)
+		m_pool = make_unique<ThreadPool>();
+
+	vector<vector<string>> unhandledQueries(_queries.size());
+	atomic<size_t> nextQuery{0};
+	m_pool->parallelFor(threads, threads, [&](size_t _thread)
+	{
+		size_t i = nextQuery++;
+		// Workers that do not get a query are not brought up to date.
+		if (i >= _queries.size())
+			return;
+		Worker& worker = m_workers[_thread];
+		synchronise(worker);
+		for (; i < _queries.size(); i = nextQuery++)
+		{
+			size_t unhandledBefore = worker.portfolio->unhandledQueries().size();
+			worker.portfolio->push();
+			worker.portfolio->addAssertion(_queries[i].assertion);
+			results[i] = worker.portfolio->check(_queries[i].expressionsToEvaluate);
+			worker.portfolio->pop();
+			vector<string> unhandled = worker.portfolio->unhandledQueries();
+			unhandledQueries[i].assign(unhandled.begin() + unhandledBefore, unhandled.end());
+		}
+	});
+
+	for (Worker& worker: m_workers)
+	{
+		vector<SolverStatistics> const& statistics = worker.portfolio->statistics();
+		for (size_t i = 0; i < m_statistics.size(); ++i)
+		{
+			SolverStatistics& reported = worker.reportedStatistics.at(i);
+			m_statistics[i].queries += statistics.at(i).queries - reported.queries;
+			m_statistics[i].answers += statistics.at(i).answers - reported.answers;
+			m_statistics[i].firstAnswers += statistics.at(i).firstAnswers - reported.firstAnswers;
+			m_statistics[i].time += statistics.at(i).time - reported.time;
+		}
+		worker.reportedStatistics = statistics;
+	}
+	for (auto& queries: unhandledQueries)
+		m_unhandledParallelQueries += move(queries);
+	return results;
+}
+
+void SMTPortfolio::synchronise(Worker& _worker)
+{
+	SMTPortfolio& portfolio = *_worker.portfolio;
+	if (_worker.frames.empty() || _worker.frames.front().first != m_trail.front().id)
+	{
+		// There was a reset since the worker was last used.
+		portfolio.reset();
+		_worker.frames = {{m_trail.front().id, 0}};
+	}
+
+	// Keep the frames that are still on the trail. Frames below the top one of the trail
+	// can only have grown while the frames above them were popped.
+	size_t common = 1;
+	while (
+		common < _worker.frames.size() &&
+		common < m_trail.size() &&
+		_worker.frames[common - 1].second == m_trail[common - 1].entries.size() &&
+		_worker.frames[common].first == m_trail[common].id
+	)
+		common++;
+	for (; _worker.frames.size() > common; _worker.frames.pop_back())
+		portfolio.pop();
+
+	for (size_t frame = 0; frame < m_trail.size(); ++frame)
+	{
+		if (frame == _worker.frames.size())
+		{
+			portfolio.push();
+			_worker.frames.emplace_back(m_trail[frame].id, 0);
+		}
+		size_t& replayed = _worker.frames[frame].second;
+		for (; replayed < m_trail[frame].entries.size(); ++replayed)
+			m_trail[frame].entries[replayed](portfolio);
+	}
+}
+
 vector<string> SMTPortfolio::unhandledQueries()
+{
+	return smtlib2().unhandledQueries() + m_unhandledParallelQueries;
+}
+
+SMTLib2Interface& SMTPortfolio::smtlib2()
 {
 	// This code assumes that the constructor guarantees that
 	// SmtLib2Interface is in position 0.
 	solAssert(!m_solvers.empty(), "");
-	solAssert(dynamic_cast<smt::SMTLib2Interface*>(m_solvers.at(0).get()), "");
-	return m_solvers.at(0)->unhandledQueries();
+	auto smtlib2 = dynamic_cast<smt::SMTLib2Interface*>(m_solvers.at(0).get());
+	solAssert(smtlib2, "");
+	return *smtlib2;
 }
 
 bool SMTPortfolio::solverAnswered(CheckResult result)
@@ -23,43 +23,135 @@
 #include <libdevcore/FixedHash.h>
 
 #include <boost/noncopyable.hpp>
+#include <functional>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace dev
 {
+class ThreadPool;
+
 namespace solidity
 {
 namespace smt
 {
 
+class SMTLib2Interface;
+class SMTQueryCache;
+
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
- * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ * Queries are run on one solver after the other, checking whether different solvers
+ * give conflicting answers, or, in race mode, on all solvers in parallel, using the
+ * first answer. The SMT-LIB2 interface, which only looks up the responses given to
+ * the compiler, is always asked first and does not take part in the race.
+ *
+ * Independent queries can be checked in parallel using separate portfolios, which are
+ * brought into the same state by replaying the declarations and assertions. The portfolios
+ * are kept, so only the changes since their last use have to be replayed.
+ *
+ * If a cache directory is set, the answers to queries are looked up there before any
+ * solver is invoked, and stored there afterwards.
  */
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
 public:
-	SMTPortfolio(std::map<h256, std::string> const& _smtlib2Responses);
+	/// A solver together with the name and version under which it is reported.
+	struct NamedSolver
+	{
+		std::string name;
+		std::string version;
+		std::shared_ptr<SolverInterface> solver;
+	};
+
+	/// Uses the SMT-LIB2 interface and the solvers that are compiled in.
+	SMTPortfolio(
+		std::map<h256, std::string> const& _smtlib2Responses,
+		SolverSettings const& _settings = SolverSettings{}
+	);
+	/// Uses the SMT-LIB2 interface followed by @a _solvers.
+	SMTPortfolio(
+		std::map<h256, std::string> const& _smtlib2Responses,
+		SolverSettings const& _settings,
+		std::vector<NamedSolver> _solvers
+	);
+	~SMTPortfolio();
 
 	void reset() override;
 
 	void push() override;
 	void pop() override;
 
-	void declareVariable(std::string const&, Sort const&) override;
+	void declareVariable(std::string const&, SortPointer const&) override;
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 	std::vector<std::string> unhandledQueries() override;
 	unsigned solvers() override { return m_solvers.size(); }
+
+	/// A query that is checked on top of the current assertions.
+	struct Query
+	{
+		Expression assertion;
+		std::vector<Expression> expressionsToEvaluate;
+	};
+	/// Checks each of @a _queries as if it was added after a push, checked and removed again
+	/// by a pop, so the state of the solvers is unchanged.
+	/// Uses up to SolverSettings::threads threads.
+	/// @returns the results in the order of the queries.
+	std::vector<std::pair<CheckResult, std::vector<std::string>>> checkIndependently(std::vector<Query> const& _queries);
+
+	/// @returns the statistics for each solver, accumulated over all queries,
+	/// followed by the statistics for the cache (as solver "cache") if it is enabled.
+	std::vector<SolverStatistics> const& statistics() const { return m_statistics; }
 private:
 	static bool solverAnswered(CheckResult result);
+	static std::vector<NamedSolver> builtinSolvers(SolverSettings const& _settings);
+
+	std::pair<CheckResult, std::vector<std::string>> checkConsensus(std::vector<Expression> const& _expressionsToEvaluate);
+	std::pair<CheckResult, std::vector<std::string>> checkRace(std::vector<Expression> const& _expressionsToEvaluate);
+
+	SMTLib2Interface& smtlib2();
 
+	std::map<h256, std::string> const& m_smtlib2Responses;
+	SolverSettings m_settings;
 	std::vector<std::shared_ptr<smt::SolverInterface>> m_solvers;
+	/// Statistics for the solver at the same position in @a m_solvers and the cache.
+	std::vector<SolverStatistics> m_statistics;
+	std::shared_ptr<SMTQueryCache> m_cache;
+	/// Threads on which the solvers race or independent queries are checked, created on first use.
+	std::unique_ptr<ThreadPool> m_pool;
+
+	/// Declarations and assertions between two pushes.
+	struct TrailFrame
+	{
+		/// Identifies the frame, so that portfolios that replayed it can tell whether it was popped.
+		unsigned id;
+		std::vector<std::function<void(SolverInterface&)>> entries;
+	};
+	/// Frames since the last reset. Only recorded if queries are checked on multiple threads.
+	std::vector<TrailFrame> m_trail;
+	unsigned m_nextFrameId = 0;
+
+	/// Portfolio used by checkIndependently on one thread. It is kept between calls and
+	/// brought up to date with the trail by popping and pushing the frames that changed.
+	struct Worker
+	{
+		std::unique_ptr<SMTPortfolio> portfolio;
+		/// Id and number of replayed entries of each frame of the portfolio.
+		std::vector<std::pair<unsigned, size_t>> frames;
+		/// Statistics of the portfolio already added to ours.
+		std::vector<SolverStatistics> reportedStatistics;
+	};
+	/// Replays the parts of the trail that are missing in the portfolio of @a _worker.
+	void synchronise(Worker& _worker);
+	std::vector<Worker> m_workers;
+	/// Unhandled queries of the portfolios used by checkIndependently.
+	std::vector<std::string> m_unhandledParallelQueries;
 };
 
 }
@@ -0,0 +1,183 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * On-disk cache for the results of SMT queries.
+ */
+
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity::smt;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Prefix of the names of normalised symbols. It cannot be part of a Solidity identifier.
+char const c_symbolPrefix = '!';
+
+bool isDelimiter(char _c)
+{
+	return _c == '(' || _c == ')' || _c == '|' || isspace(static_cast<unsigned char>(_c));
+}
+
+/// @returns the SMT-LIB2 text @a _text where each symbol is replaced by the result of
+/// calling @a _rename on it. Quoted symbols stay quoted.
+template <class Rename>
+string renameSymbols(string const& _text, Rename const& _rename)
+{
+	string result;
+	result.reserve(_text.size());
+	size_t pos = 0;
+	while (pos < _text.size())
+	{
+		if (_text[pos] == '|')
+		{
+			size_t end = _text.find('|', pos + 1);
+			if (end == string::npos)
+			{
+				result.append(_text, pos, string::npos);
+				break;
+			}
+			result += '|' + _rename(_text.substr(pos + 1, end - pos - 1)) + '|';
+			pos = end + 1;
+		}
+		else if (isDelimiter(_text[pos]))
+			result += _text[pos++];
+		else
+		{
+			size_t end = pos;
+			while (end < _text.size() && !isDelimiter(_text[end]))
+				end++;
+			result += _rename(_text.substr(pos, end - pos));
+			pos = end;
+		}
+	}
+	return result;
+}
+
+}
+
+SMTQueryCache::Query SMTQueryCache::normalise(string const& _query, set<string> const& _symbols)
+{
+	Query query;
+	query.text = renameSymbols(_query, [&](string const& _name) {
+		if (!_symbols.count(_name))
+			return _name;
+		auto inserted = query.indices.emplace(_name, query.symbols.size());
+		if (inserted.second)
+			query.symbols.push_back(_name);
+		return c_symbolPrefix + to_string(inserted.first->second);
+	});
+	return query;
+}
+
+boost::optional<pair<CheckResult, vector<string>>> SMTQueryCache::lookup(Query const& _query) const
+{
+	fs::path path = entryPath(_query);
+	boost::system::error_code error;
+	if (!fs::exists(path, error))
+		return {};
+
+	Json::Value entry;
+	try
+	{
+		if (!jsonParseStrict(readFileAsString(path.string()), entry) || !entry.isObject())
+			return {};
+	}
+	catch (...)
+	{
+		return {};
+	}
+	pair<CheckResult, vector<string>> result;
+	if (entry["result"] == "sat")
+		result.first = CheckResult::SATISFIABLE;
+	else if (entry["result"] == "unsat")
+		result.first = CheckResult::UNSATISFIABLE;
+	else
+		return {};
+	if (!entry["values"].isArray())
+		return {};
+	for (auto const& value: entry["values"])
+	{
+		if (!value.isString())
+			return {};
+		result.second.emplace_back(renameSymbols(value.asString(), [&](string const& _name) {
+			if (_name.size() > 1 && _name[0] == c_symbolPrefix && all_of(_name.begin() + 1, _name.end(), ::isdigit))
+			{
+				size_t index = stoul(_name.substr(1));
+				if (index < _query.symbols.size())
+					return _query.symbols[index];
+			}
+			return _name;
+		}));
+	}
+	return result;
+}
+
+void SMTQueryCache::store(Query const& _query, pair<CheckResult, vector<string>> const& _result) const
+{
+	Json::Value entry(Json::objectValue);
+	if (_result.first == CheckResult::SATISFIABLE)
+		entry["result"] = "sat";
+	else if (_result.first == CheckResult::UNSATISFIABLE)
+		entry["result"] = "unsat";
+	else
+		return;
+	entry["values"] = Json::arrayValue;
+	for (string const& value: _result.second)
+		entry["values"].append(renameSymbols(value, [&](string const& _name) {
+			auto it = _query.indices.find(_name);
+			return it == _query.indices.end() ? _name : c_symbolPrefix + to_string(it->second);
+		}));
+
+	// Failing to write the entry only means that the query has to be solved again.
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+	fs::path path = entryPath(_query);
+	fs::path temporaryPath = path;
+	temporaryPath += "." + fs::unique_path().string() + ".tmp";
+	{
+		ofstream file(temporaryPath.string(), ios::binary);
+		file << jsonCompactPrint(entry);
+		if (!file.good())
+			error = make_error_code(boost::system::errc::io_error);
+	}
+	if (!error)
+		fs::rename(temporaryPath, path, error);
+	if (error)
+		fs::remove(temporaryPath, error);
+}
+
+fs::path SMTQueryCache::entryPath(Query const& _query) const
+{
+	return m_directory / (keccak256(m_solvers + '\0' + _query.text).hex() + ".json");
+}
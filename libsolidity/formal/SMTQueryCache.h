@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * On-disk cache for the results of SMT queries.
+ */
+
+#pragma once
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Content-addressed cache that maps SMT-LIB2 queries to the answers of the solvers.
+ *
+ * Queries are normalised by renaming the declared symbols in the order of their first
+ * occurrence, so that the names of the Solidity variables and their AST IDs do not
+ * influence the key. Entries are keyed on the hash of the normalised query and the names
+ * and versions of the solvers. Only SAT and UNSAT answers are stored, and the portfolio
+ * does not store the answers taken from the SMT-LIB2 responses given to the compiler.
+ *
+ * Entries are written to a temporary file which is then renamed, so multiple processes
+ * and threads can share the same cache directory. Problems with the cache directory
+ * are ignored, they only prevent the cache from being used.
+ */
+class SMTQueryCache
+{
+public:
+	/// A query in normalised form, together with the original names of its symbols.
+	struct Query
+	{
+		std::string text;
+		/// The original names of the renamed symbols, by their index.
+		std::vector<std::string> symbols;
+		/// The indices of the renamed symbols, by their original name.
+		std::map<std::string, size_t> indices;
+	};
+
+	/// @param _solvers the names and versions of the solvers whose answers are stored.
+	SMTQueryCache(boost::filesystem::path _directory, std::string _solvers):
+		m_directory(std::move(_directory)), m_solvers(std::move(_solvers))
+	{}
+
+	/// Normalises the SMT-LIB2 query @a _query, where @a _symbols are the declared symbols.
+	static Query normalise(std::string const& _query, std::set<std::string> const& _symbols);
+
+	/// @returns the stored answer to @a _query, with the values referring to the original symbols.
+	boost::optional<std::pair<CheckResult, std::vector<std::string>>> lookup(Query const& _query) const;
+	/// Stores the answer @a _result to @a _query if it is SAT or UNSAT.
+	void store(Query const& _query, std::pair<CheckResult, std::vector<std::string>> const& _result) const;
+
+private:
+	boost::filesystem::path entryPath(Query const& _query) const;
+
+	boost::filesystem::path m_directory;
+	std::string m_solvers;
+};
+
+}
+}
+}
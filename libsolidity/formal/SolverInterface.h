@@ -23,6 +23,7 @@
 #include <libdevcore/Exceptions.h>
 
 #include <boost/noncopyable.hpp>
+#include <chrono>
 #include <cstdio>
 #include <map>
 #include <string>
@@ -40,6 +41,36 @@ enum class CheckResult
 	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
 };
 
+/// Settings for the SMT solvers used by the SMTChecker.
+struct SolverSettings
+{
+	/// Timeout for a single query of each solver in milliseconds.
+	unsigned queryTimeout = 10000;
+	/// If true, the solvers are run in parallel and the first one that answers wins, so the
+	/// reported counterexamples depend on which solver is fastest. Otherwise, all solvers are
+	/// run to completion and their answers are compared.
+	bool race = false;
+	/// Number of threads used to check independent queries, e.g. the overflow targets
+	/// of a function, with separate solver instances.
+	unsigned threads = 1;
+	/// Directory in which the answers to queries are cached, disabled if empty.
+	std::string cacheDirectory;
+};
+
+/// Statistics about the queries to one solver.
+struct SolverStatistics
+{
+	std::string solver;
+	/// Number of queries sent to the solver.
+	unsigned queries = 0;
+	/// Number of queries answered with SAT or UNSAT.
+	unsigned answers = 0;
+	/// Number of queries for which the answer of this solver was used first.
+	unsigned firstAnswers = 0;
+	/// Time spent in queries, including the time until cancelled.
+	std::chrono::milliseconds time{0};
+};
+
 enum class Kind
 {
 	Int,
@@ -293,11 +324,11 @@ public:
 	virtual void push() = 0;
 	virtual void pop() = 0;
 
-	virtual void declareVariable(std::string const& _name, Sort const& _sort) = 0;
+	virtual void declareVariable(std::string const& _name, SortPointer const& _sort) = 0;
 	Expression newVariable(std::string _name, SortPointer _sort)
 	{
 		// Subclasses should do something here
-		declareVariable(_name, *_sort);
+		declareVariable(_name, _sort);
 		return Expression(std::move(_name), {}, std::move(_sort));
 	}
 
@@ -308,15 +339,15 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a call to @a check that is running on another thread to stop as soon as possible.
+	/// The interrupted call returns UNKNOWN. Can be called from any thread.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
 	/// @returns how many SMT solvers this interface has.
 	virtual unsigned solvers() { return 1; }
-
-protected:
-	// SMT query timeout in milliseconds.
-	static int const queryTimeout = 10000;
 };
 
 }
@@ -24,13 +24,23 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
 
-Z3Interface::Z3Interface():
+Z3Interface::Z3Interface(unsigned _queryTimeout):
 	m_solver(m_context)
 {
 	// This needs to be set globally.
 	z3::set_param("rewriter.pull_cheap_ite", true);
 	// This needs to be set in the context.
-	m_context.set("timeout", queryTimeout);
+	m_context.set("timeout", int(_queryTimeout));
+}
+
+string Z3Interface::version()
+{
+	unsigned major = 0;
+	unsigned minor = 0;
+	unsigned buildNumber = 0;
+	unsigned revision = 0;
+	Z3_get_version(&major, &minor, &buildNumber, &revision);
+	return to_string(major) + "." + to_string(minor) + "." + to_string(buildNumber);
 }
 
 void Z3Interface::reset()
@@ -50,12 +60,13 @@ void Z3Interface::pop()
 	m_solver.pop();
 }
 
-void Z3Interface::declareVariable(string const& _name, Sort const& _sort)
+void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
-	if (_sort.kind == Kind::Function)
-		declareFunction(_name, _sort);
+	solAssert(_sort, "");
+	if (_sort->kind == Kind::Function)
+		declareFunction(_name, *_sort);
 	else if (!m_constants.count(_name))
-		m_constants.insert({_name, m_context.constant(_name.c_str(), z3Sort(_sort))});
+		m_constants.insert({_name, m_context.constant(_name.c_str(), z3Sort(*_sort))});
 }
 
 void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
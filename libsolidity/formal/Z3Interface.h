@@ -31,18 +31,23 @@ namespace smt
 class Z3Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	Z3Interface();
+	explicit Z3Interface(unsigned _queryTimeout);
 
 	void reset() override;
 
 	void push() override;
 	void pop() override;
 
-	void declareVariable(std::string const& _name, Sort const& _sort) override;
+	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	void interrupt() override { m_context.interrupt(); }
+
+	/// @returns the version of the linked Z3 library.
+	static std::string version();
+
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
@@ -0,0 +1,119 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * On-disk cache for the output of standard JSON compilations.
+ */
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolidity/interface/Version.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace fs = boost::filesystem;
+
+boost::optional<Json::Value> CompilationCache::lookup(
+	Json::Value const& _input,
+	ReadCallback::Callback const& _readFile
+) const
+{
+	fs::path path = entryPath(_input);
+	boost::system::error_code error;
+	if (!fs::exists(path, error))
+		return {};
+
+	Json::Value entry;
+	if (!jsonParseStrict(readFileAsString(path.string()), entry) || !entry.isObject())
+		return {};
+	Json::Value const& readFiles = entry["readFiles"];
+	if (!readFiles.isObject() || !entry.isMember("output"))
+		return {};
+
+	for (auto const& fileName: readFiles.getMemberNames())
+	{
+		if (!_readFile || !readFiles[fileName].isString())
+			return {};
+		ReadCallback::Result result = _readFile(fileName);
+		if (!result.success || keccak256(result.responseOrErrorMessage).hex() != readFiles[fileName].asString())
+			return {};
+	}
+	return entry["output"];
+}
+
+void CompilationCache::store(
+	Json::Value const& _input,
+	map<string, h256> const& _readFiles,
+	Json::Value const& _output
+) const
+{
+	if (_output.isMember("errors"))
+		for (auto const& error: _output["errors"])
+			if (error["severity"] != "warning")
+				return;
+
+	Json::Value entry(Json::objectValue);
+	entry["readFiles"] = Json::objectValue;
+	for (auto const& file: _readFiles)
+		entry["readFiles"][file.first] = file.second.hex();
+	entry["output"] = _output;
+
+	// Failing to write the entry only means that it has to be compiled again.
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+	fs::path path = entryPath(_input);
+	fs::path temporaryPath = path;
+	temporaryPath += "." + fs::unique_path().string() + ".tmp";
+	{
+		ofstream file(temporaryPath.string(), ios::binary);
+		file << jsonCompactPrint(entry);
+		if (!file.good())
+			error = make_error_code(boost::system::errc::io_error);
+	}
+	if (!error)
+		fs::rename(temporaryPath, path, error);
+	if (error)
+		fs::remove(temporaryPath, error);
+}
+
+fs::path CompilationCache::entryPath(Json::Value const& _input) const
+{
+	// The number of optimiser threads and of compilation threads does not influence the output.
+	Json::Value input = _input;
+	if (input.isObject() && input.isMember("settings") && input["settings"].isObject())
+		input["settings"].removeMember("parallelism");
+	Json::Value* yulDetails = &input;
+	for (char const* member: {"settings", "optimizer", "details", "yulDetails"})
+		if (yulDetails && yulDetails->isObject() && yulDetails->isMember(member))
+			yulDetails = &(*yulDetails)[member];
+		else
+			yulDetails = nullptr;
+	if (yulDetails && yulDetails->isObject())
+		yulDetails->removeMember("threads");
+	return m_directory / (keccak256(VersionString + '\0' + jsonCompactPrint(input)).hex() + ".json");
+}
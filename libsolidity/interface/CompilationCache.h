@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * On-disk cache for the output of standard JSON compilations.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/ReadFile.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+
+#include <map>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Content-addressed cache that maps standard JSON inputs to their outputs.
+ *
+ * Entries are keyed on the hash of the compiler version and the input (which contains the
+ * sources and all settings). Files read through the read callback during compilation are
+ * stored in the entry together with the hash of their content and are read again on lookup,
+ * so that changes to them invalidate the entry.
+ *
+ * Entries are written to a temporary file which is then renamed, so multiple processes
+ * can share the same cache directory.
+ */
+class CompilationCache
+{
+public:
+	explicit CompilationCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the output stored for @a _input if there is an entry and all files it depends on
+	/// still have the same content when read through @a _readFile.
+	boost::optional<Json::Value> lookup(Json::Value const& _input, ReadCallback::Callback const& _readFile) const;
+	/// Stores @a _output for @a _input, where @a _readFiles are the hashes of the contents of
+	/// all files read through the read callback.
+	/// Outputs that contain errors are not stored.
+	void store(
+		Json::Value const& _input,
+		std::map<std::string, h256> const& _readFiles,
+		Json::Value const& _output
+	) const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(Json::Value const& _input) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
+}
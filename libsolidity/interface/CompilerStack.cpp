@@ -38,7 +38,10 @@
 #include <libsolidity/analysis/ViewPureChecker.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/codegen/GeneratedAssemblyCache.h>
 #include <libsolidity/formal/SMTChecker.h>
 #include <libsolidity/interface/ABI.h>
 #include <libsolidity/interface/Natspec.h>
@@ -54,6 +57,7 @@
 
 #include <libdevcore/SwarmHash.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Parallel.h>
 
 #include <json/json.h>
 
@@ -135,12 +139,35 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _respons
 	m_smtlib2Responses[_hash] = _response;
 }
 
+void CompilerStack::setParallelism(unsigned _threads)
+{
+	m_parallelism = max(_threads, 1u);
+}
+
+void CompilerStack::setSMTSolverSettings(smt::SolverSettings const& _settings)
+{
+	if (m_stackState >= ParsingSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set SMT solver settings before parsing."));
+	m_smtSolverSettings = _settings;
+}
+
+CompilerStack::CompilerStack(ReadCallback::Callback const& _readFile):
+	m_readFile(_readFile),
+	m_generatedAssemblyCache(make_unique<GeneratedAssemblyCache>()),
+	m_errorList(),
+	m_errorReporter(m_errorList)
+{
+}
+
+CompilerStack::~CompilerStack() = default;
+
 void CompilerStack::reset(bool _keepSettings)
 {
 	m_stackState = Empty;
 	m_sources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
+	m_smtSolverStatistics.clear();
 	if (!_keepSettings)
 	{
 		m_remappings.clear();
@@ -148,22 +175,34 @@ void CompilerStack::reset(bool _keepSettings)
 		m_evmVersion = langutil::EVMVersion();
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
+		m_smtSolverSettings = smt::SolverSettings{};
+		m_parallelism = 1;
 	}
+	m_typeProvider.reset();
 	m_globalContext.reset();
 	m_scopes.clear();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_generatedAssemblyCache->clear();
 	m_errorReporter.clear();
 }
 
-void CompilerStack::setSources(StringMap const& _sources)
+void CompilerStack::setSources(StringMap _sources)
+{
+	map<string, CharStream> sources;
+	for (auto& source: _sources)
+		sources.emplace(source.first, CharStream(/*content*/std::move(source.second), /*name*/source.first));
+	setSourceStreams(sources);
+}
+
+void CompilerStack::setSourceStreams(map<string, CharStream> const& _sources)
 {
 	if (m_stackState == SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
 	for (auto const& source: _sources)
-		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/source.second, /*name*/source.first));
+		m_sources[source.first].scanner = make_shared<Scanner>(source.second);
 	m_stackState = SourcesSet;
 }
 
@@ -173,6 +212,7 @@ bool CompilerStack::parse()
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
 	m_errorReporter.clear();
 	ASTNode::resetID();
+	m_typeProvider = make_unique<TypeProvider>();
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning("This is a pre-release compiler version, please do not use it in production.");
@@ -197,11 +237,10 @@ bool CompilerStack::parse()
 		else
 		{
 			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			for (auto& newSource: loadMissingSources(*source.ast, path))
 			{
 				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(std::move(newSource.second), newPath));
 				sourcesToParse.push_back(newPath);
 			}
 		}
@@ -219,6 +258,7 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsingSuccessful || m_stackState >= AnalysisSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was successful."));
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	resolveImports();
 
 	bool noErrors = true;
@@ -340,10 +380,11 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			SMTChecker smtChecker(m_errorReporter, m_smtlib2Responses);
+			SMTChecker smtChecker(m_errorReporter, m_smtlib2Responses, m_smtSolverSettings);
 			for (Source const* source: m_sourceOrder)
 				smtChecker.analyze(*source->ast, source->scanner);
 			m_unhandledSMTLib2Queries += smtChecker.unhandledQueries();
+			m_smtSolverStatistics = smtChecker.solverStatistics();
 		}
 	}
 	catch(FatalError const&)
@@ -381,13 +422,17 @@ bool CompilerStack::compile()
 		if (!parseAndAnalyze())
 			return false;
 
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
-	for (Source const* source: m_sourceOrder)
-		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
-				if (isRequestedContract(*contract))
-					compileContract(*contract, otherCompilers);
+	if (m_parallelism > 1)
+		compileContractsInParallel(otherCompilers);
+	else
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					if (isRequestedContract(*contract))
+						compileContract(*contract, otherCompilers);
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
@@ -715,7 +760,10 @@ tuple<int, int, int, int> CompilerStack::positionFromSourceLocation(SourceLocati
 h256 const& CompilerStack::Source::keccak256() const
 {
 	if (keccak256HashCached == h256{})
-		keccak256HashCached = dev::keccak256(scanner->source());
+	{
+		CharStream const& stream = *scanner->charStream();
+		keccak256HashCached = dev::keccak256(bytesConstRef(reinterpret_cast<uint8_t const*>(stream.data()), stream.size()));
+	}
 	return keccak256HashCached;
 }
 
@@ -750,7 +798,7 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 				result = m_readFile(importPath);
 
 			if (result.success)
-				newSources[importPath] = result.responseOrErrorMessage;
+				newSources[importPath] = std::move(result.responseOrErrorMessage);
 			else
 			{
 				m_errorReporter.parserError(
@@ -859,9 +907,86 @@ void CompilerStack::compileContract(
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		compileContract(*dependency, _otherCompilers);
 
+	_otherCompilers[&_contract] = generateCode(_contract, _otherCompilers);
+}
+
+void CompilerStack::compileContractsInParallel(
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+)
+{
+	// Group the contracts by the length of the longest chain of contracts they create,
+	// so that the contracts of a group only depend on contracts of earlier groups.
+	// The dependencies include the base contracts, which can create contracts themselves
+	// even if they cannot be deployed.
+	map<ContractDefinition const*, size_t> firstDependentGroup;
+	vector<vector<ContractDefinition const*>> groups;
+	function<size_t(ContractDefinition const&)> schedule = [&](ContractDefinition const& _contract)
+	{
+		auto it = firstDependentGroup.find(&_contract);
+		if (it != firstDependentGroup.end())
+			return it->second;
+		size_t group = 0;
+		for (auto const* dependency: _contract.annotation().contractDependencies)
+			group = max(group, schedule(*dependency));
+		if (!_contract.canBeDeployed())
+			return firstDependentGroup[&_contract] = group;
+		if (groups.size() <= group)
+			groups.resize(group + 1);
+		groups[group].push_back(&_contract);
+		return firstDependentGroup[&_contract] = group + 1;
+	};
+	for (Source const* source: m_sourceOrder)
+		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+				if (isRequestedContract(*contract))
+					schedule(*contract);
+
+	// Contracts share the nodes of their bases and of the types they use, so everything
+	// that is otherwise computed on first use is computed before the threads start.
+	SimpleASTVisitor prepare(
+		[](ASTNode const& _node)
+		{
+			_node.annotation();
+			if (auto contract = dynamic_cast<ContractDefinition const*>(&_node))
+			{
+				contract->interfaceFunctionList();
+				contract->interfaceEvents();
+				contract->inheritableMembers();
+			}
+			return true;
+		},
+		[](ASTNode const&) {}
+	);
+	for (auto const& source: m_sources)
+	{
+		source.second.ast->accept(prepare);
+		source.second.keccak256();
+		source.second.swarmHash();
+	}
+
+	yul::YulStringRepository& repository = yul::YulStringRepository::instance();
+	for (auto const& group: groups)
+	{
+		vector<shared_ptr<Compiler const>> compilers(group.size());
+		parallelFor(group.size(), m_parallelism, [&](size_t _index)
+		{
+			yul::YulStringRepository::Scope scope{repository};
+			TypeProvider::Scope typeProviderScope{*m_typeProvider};
+			compilers[_index] = generateCode(*group[_index], _otherCompilers);
+		});
+		for (size_t i = 0; i < group.size(); ++i)
+			_otherCompilers[group[i]] = compilers[i];
+	}
+}
+
+shared_ptr<Compiler const> CompilerStack::generateCode(
+	ContractDefinition const& _contract,
+	map<ContractDefinition const*, shared_ptr<Compiler const>> const& _otherCompilers
+)
+{
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimiserSettings, m_generatedAssemblyCache.get());
 	compiledContract.compiler = compiler;
 
 	bytes cborEncodedMetadata = createCBORMetadata(
@@ -899,7 +1024,7 @@ void CompilerStack::compileContract(
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
 
-	_otherCompilers[compiledContract.contract] = compiler;
+	return compiler;
 }
 
 CompilerStack::Contract const& CompilerStack::contract(string const& _contractName) const
@@ -23,9 +23,11 @@
 
 #pragma once
 
+#include <libsolidity/formal/SolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 
+#include <liblangutil/CharStream.h>
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
@@ -68,7 +70,9 @@ class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
+class GeneratedAssemblyCache;
 class GlobalContext;
+class TypeProvider;
 class Natspec;
 class DeclarationContainer;
 
@@ -98,10 +102,8 @@ public:
 	/// Creates a new compiler stack.
 	/// @param _readFile callback to used to read files for import statements. Must return
 	/// and must not emit exceptions.
-	explicit CompilerStack(ReadCallback::Callback const& _readFile = ReadCallback::Callback()):
-		m_readFile(_readFile),
-		m_errorList(),
-		m_errorReporter(m_errorList) {}
+	explicit CompilerStack(ReadCallback::Callback const& _readFile = ReadCallback::Callback());
+	~CompilerStack();
 
 	/// @returns the list of errors that occurred during parsing and type checking.
 	langutil::ErrorList const& errors() const { return m_errorReporter.errors(); }
@@ -148,12 +150,23 @@ public:
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
 
 	/// Sets the sources. Must be set before parsing.
-	void setSources(StringMap const& _sources);
+	void setSources(StringMap _sources);
+	/// Sets the sources from character streams, whose contents are shared instead of copied.
+	/// Must be set before parsing.
+	void setSourceStreams(std::map<std::string, langutil::CharStream> const& _sources);
 
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
 	void addSMTLib2Response(h256 const& _hash, std::string const& _response);
 
+	/// Changes the timeout and the mode of the solvers used by the SMTChecker.
+	/// Must be set before parsing.
+	void setSMTSolverSettings(smt::SolverSettings const& _settings);
+
+	/// Sets the number of threads on which contracts that do not create each other are compiled
+	/// at the same time. Defaults to one. Does not change the bytecode.
+	void setParallelism(unsigned _threads);
+
 	/// Parses all source units that were added
 	/// @returns false on error.
 	bool parse();
@@ -193,6 +206,9 @@ public:
 	/// by calling @a addSMTLib2Response).
 	std::vector<std::string> const& unhandledSMTLib2Queries() const { return m_unhandledSMTLib2Queries; }
 
+	/// @returns the statistics for each solver used by the SMTChecker during analysis.
+	std::vector<smt::SolverStatistics> const& smtSolverStatistics() const { return m_smtSolverStatistics; }
+
 	/// @returns a list of the contract names in the sources.
 	std::vector<std::string> contractNames() const;
 
@@ -299,6 +315,19 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
+	/// Compiles the requested contracts and their dependencies on @a m_parallelism threads,
+	/// starting a contract once all contracts it creates are compiled.
+	void compileContractsInParallel(
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+	);
+
+	/// Generates and assembles the code of a single contract, whose dependencies
+	/// have to be in @a _otherCompilers.
+	std::shared_ptr<Compiler const> generateCode(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers
+	);
+
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
 	void link();
@@ -358,11 +387,19 @@ private:
 	std::map<std::string const, Source> m_sources;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<h256, std::string> m_smtlib2Responses;
+	smt::SolverSettings m_smtSolverSettings;
+	/// Number of threads used to compile contracts.
+	unsigned m_parallelism = 1;
+	std::vector<smt::SolverStatistics> m_smtSolverStatistics;
+	/// Shared instances of the types used by the sources, replaced whenever they are parsed.
+	std::unique_ptr<TypeProvider> m_typeProvider;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	/// This is updated during compilation.
 	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
 	std::map<std::string const, Contract> m_contracts;
+	/// Inline assembly blocks generated for the contracts, kept until the next reset.
+	std::unique_ptr<GeneratedAssemblyCache> m_generatedAssemblyCache;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
 	bool m_metadataLiteralSources = false;
@@ -104,6 +104,9 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Number of threads the Yul optimiser uses for steps that process each function separately.
+	/// Does not influence the output and is thus not part of the comparison.
+	size_t yulOptimiserThreads = 1;
 };
 
 }
@@ -277,7 +277,7 @@ boost::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 boost::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
+	static set<string> keys{"evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "parallelism", "remappings", "smtChecker"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -304,6 +304,12 @@ boost::optional<Json::Value> checkOptimizerDetail(Json::Value const& _details, s
 	return {};
 }
 
+boost::optional<Json::Value> checkSMTCheckerKeys(Json::Value const& _input)
+{
+	static set<string> keys{"cacheDirectory", "portfolio", "statistics", "threads", "timeout"};
+	return checkKeys(_input, keys, "settings.smtChecker");
+}
+
 boost::optional<Json::Value> checkMetadataKeys(Json::Value const& _input)
 {
 	if (_input.isObject() && _input.isMember("useLiteralContent") && !_input["useLiteralContent"].isBool())
@@ -407,10 +413,17 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation"}, "settings.optimizer.details.yulDetails"))
+			Json::Value const& yulDetails = details["yulDetails"];
+			if (auto result = checkKeys(yulDetails, {"stackAllocation", "threads"}, "settings.optimizer.details.yulDetails"))
 				return *result;
-			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
+			if (auto error = checkOptimizerDetail(yulDetails, "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
+			if (yulDetails.isMember("threads"))
+			{
+				if (!yulDetails["threads"].isUInt() || yulDetails["threads"].asUInt() == 0)
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.threads\" must be a positive number.");
+				settings.yulOptimiserThreads = yulDetails["threads"].asUInt();
+			}
 		}
 	}
 	return std::move(settings);
@@ -584,6 +597,51 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 			ret.optimiserSettings = boost::get<OptimiserSettings>(std::move(optimiserSettings));
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt() || settings["parallelism"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be a positive number.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
+	if (settings.isMember("smtChecker"))
+	{
+		Json::Value const& smtChecker = settings["smtChecker"];
+		if (auto result = checkSMTCheckerKeys(smtChecker))
+			return *result;
+		if (smtChecker.isMember("timeout"))
+		{
+			if (!smtChecker["timeout"].isUInt() || smtChecker["timeout"].asUInt() == 0)
+				return formatFatalError("JSONError", "\"settings.smtChecker.timeout\" must be a positive number.");
+			ret.smtSolverSettings.queryTimeout = smtChecker["timeout"].asUInt();
+		}
+		if (smtChecker.isMember("threads"))
+		{
+			if (!smtChecker["threads"].isUInt() || smtChecker["threads"].asUInt() == 0)
+				return formatFatalError("JSONError", "\"settings.smtChecker.threads\" must be a positive number.");
+			ret.smtSolverSettings.threads = smtChecker["threads"].asUInt();
+		}
+		if (smtChecker.isMember("portfolio"))
+		{
+			Json::Value const& portfolio = smtChecker["portfolio"];
+			if (portfolio != "race" && portfolio != "consensus")
+				return formatFatalError("JSONError", "\"settings.smtChecker.portfolio\" must be \"race\" or \"consensus\".");
+			ret.smtSolverSettings.race = portfolio == "race";
+		}
+		if (smtChecker.isMember("statistics"))
+		{
+			if (!smtChecker["statistics"].isBool())
+				return formatFatalError("JSONError", "\"settings.smtChecker.statistics\" must be Boolean");
+			ret.smtSolverStatistics = smtChecker["statistics"].asBool();
+		}
+		if (smtChecker.isMember("cacheDirectory"))
+		{
+			if (!smtChecker["cacheDirectory"].isString())
+				return formatFatalError("JSONError", "\"settings.smtChecker.cacheDirectory\" must be a string.");
+			ret.smtSolverSettings.cacheDirectory = smtChecker["cacheDirectory"].asString();
+		}
+	}
+
 	Json::Value jsonLibraries = settings.get("libraries", Json::Value(Json::objectValue));
 	if (!jsonLibraries.isObject())
 		return formatFatalError("JSONError", "\"libraries\" is not a JSON object.");
@@ -650,9 +708,13 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.setSources(sourceList);
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
+	if (_inputsAndSettings.smtSolverSettings.cacheDirectory.empty() && m_cache)
+		_inputsAndSettings.smtSolverSettings.cacheDirectory = (m_cache->directory() / "smt").string();
+	compilerStack.setSMTSolverSettings(_inputsAndSettings.smtSolverSettings);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setRemappings(_inputsAndSettings.remappings);
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
 	compilerStack.setLibraries(_inputsAndSettings.libraries);
 	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
@@ -767,6 +829,19 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
 			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + keccak256(query).hex()] = query;
 
+	if (_inputsAndSettings.smtSolverStatistics)
+	{
+		output["smtChecker"]["solvers"] = Json::objectValue;
+		for (auto const& statistics: compilerStack.smtSolverStatistics())
+		{
+			Json::Value& solver = output["smtChecker"]["solvers"][statistics.solver];
+			solver["queries"] = statistics.queries;
+			solver["answers"] = statistics.answers;
+			solver["firstAnswers"] = statistics.firstAnswers;
+			solver["time"] = Json::UInt64(statistics.time.count());
+		}
+	}
+
 	output["sources"] = Json::objectValue;
 	unsigned sourceIndex = 0;
 	for (string const& sourceName: analysisSuccess ? compilerStack.sourceNames() : vector<string>())
@@ -924,7 +999,52 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 }
 
 
+StandardCompiler::StandardCompiler(ReadCallback::Callback const& _readFile)
+{
+	if (_readFile)
+		m_readFile = [this, _readFile](string const& _path)
+		{
+			ReadCallback::Result result = _readFile(_path);
+			// The hashes are only needed to store the output in the cache.
+			if (m_cache && result.success)
+				m_readFiles[_path] = keccak256(result.responseOrErrorMessage);
+			return result;
+		};
+}
+
+void StandardCompiler::setCacheDirectory(string const& _directory)
+{
+	m_cache = make_unique<CompilationCache>(_directory);
+}
+
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	if (!m_cache)
+		return compileUncached(_input);
+
+	// Problems with the cache are not reported, they only prevent it from being used.
+	try
+	{
+		if (auto output = m_cache->lookup(_input, m_readFile))
+			return std::move(*output);
+	}
+	catch (...)
+	{
+	}
+
+	m_readFiles.clear();
+	Json::Value output = compileUncached(_input);
+	try
+	{
+		m_cache->store(_input, m_readFiles, output);
+	}
+	catch (...)
+	{
+	}
+	return output;
+}
+
+Json::Value StandardCompiler::compileUncached(Json::Value const& _input)
 {
 	try
 	{
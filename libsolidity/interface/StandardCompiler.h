@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 
 #include <boost/optional.hpp>
@@ -43,10 +44,10 @@ public:
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback to used to read files for import statements. Must return
 	/// and must not emit exceptions.
-	explicit StandardCompiler(ReadCallback::Callback const& _readFile = ReadCallback::Callback()):
-		m_readFile(_readFile)
-	{
-	}
+	explicit StandardCompiler(ReadCallback::Callback const& _readFile = ReadCallback::Callback());
+
+	/// Looks up the outputs in and stores them to a compilation cache in @a _directory.
+	void setCacheDirectory(std::string const& _directory);
 
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
@@ -62,9 +63,12 @@ private:
 		Json::Value errors;
 		std::map<std::string, std::string> sources;
 		std::map<h256, std::string> smtLib2Responses;
+		smt::SolverSettings smtSolverSettings;
+		bool smtSolverStatistics = false;
 		langutil::EVMVersion evmVersion;
 		std::vector<CompilerStack::Remapping> remappings;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
+		unsigned parallelism = 1;
 		std::map<std::string, h160> libraries;
 		bool metadataLiteralSources = false;
 		Json::Value outputSelection;
@@ -76,8 +80,12 @@ private:
 
 	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
+	Json::Value compileUncached(Json::Value const& _input);
 
+	/// Calls the read callback and records the hashes of the files read successfully.
 	ReadCallback::Callback m_readFile;
+	std::map<std::string, h256> m_readFiles;
+	std::unique_ptr<CompilationCache> m_cache;
 };
 
 }
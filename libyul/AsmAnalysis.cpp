@@ -53,6 +53,7 @@ bool AsmAnalyzer::analyze(Block const& _block)
 {
 	if (!(ScopeFiller(m_info, m_errorReporter))(_block))
 		return false;
+	m_activeVariables.resize(m_info.numberOfVariables, false);
 
 	bool success = (*this)(_block);
 	if (!success)
@@ -140,7 +141,7 @@ bool AsmAnalyzer::operator()(Identifier const& _identifier)
 	if (m_currentScope->lookup(_identifier.name, Scope::Visitor(
 		[&](Scope::Variable const& _var)
 		{
-			if (!m_activeVariables.count(&_var))
+			if (!m_activeVariables[_var.index])
 			{
 				m_errorReporter.declarationError(
 					_identifier.location,
@@ -289,7 +290,7 @@ bool AsmAnalyzer::operator()(VariableDeclaration const& _varDecl)
 	for (auto const& variable: _varDecl.variables)
 	{
 		expectValidType(variable.type.str(), variable.location);
-		m_activeVariables.insert(&boost::get<Scope::Variable>(m_currentScope->identifiers.at(variable.name)));
+		m_activeVariables[boost::get<Scope::Variable>(m_currentScope->identifiers.at(variable.name)).index] = true;
 	}
 	m_info.stackHeightInfo[&_varDecl] = m_stackHeight;
 	return success;
@@ -304,7 +305,7 @@ bool AsmAnalyzer::operator()(FunctionDefinition const& _funDef)
 	for (auto const& var: _funDef.parameters + _funDef.returnVariables)
 	{
 		expectValidType(var.type.str(), var.location);
-		m_activeVariables.insert(&boost::get<Scope::Variable>(varScope.identifiers.at(var.name)));
+		m_activeVariables[boost::get<Scope::Variable>(varScope.identifiers.at(var.name)).index] = true;
 	}
 
 	int const stackHeight = m_stackHeight;
@@ -592,7 +593,7 @@ bool AsmAnalyzer::checkAssignment(Identifier const& _variable, size_t _valueSize
 			m_errorReporter.typeError(_variable.location, "Assignment requires variable.");
 			success = false;
 		}
-		else if (!m_activeVariables.count(&boost::get<Scope::Variable>(*var)))
+		else if (!m_activeVariables[boost::get<Scope::Variable>(*var).index])
 		{
 			m_errorReporter.declarationError(
 				_variable.location,
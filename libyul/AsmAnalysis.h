@@ -120,8 +120,8 @@ private:
 	yul::ExternalIdentifierAccess::Resolver m_resolver;
 	Scope* m_currentScope = nullptr;
 	/// Variables that are active at the current point in assembly (as opposed to
-	/// "part of the scope but not yet declared")
-	std::set<Scope::Variable const*> m_activeVariables;
+	/// "part of the scope but not yet declared"), by the index of the variable.
+	std::vector<bool> m_activeVariables;
 	AsmAnalysisInfo& m_info;
 	langutil::ErrorReporter& m_errorReporter;
 	langutil::EVMVersion m_evmVersion;
@@ -26,6 +26,7 @@
 
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace yul
@@ -35,12 +36,17 @@ struct Scope;
 
 struct AsmAnalysisInfo
 {
-	using StackHeightInfo = std::map<void const*, int>;
+	using StackHeightInfo = std::unordered_map<void const*, int>;
 	using Scopes = std::map<Block const*, std::shared_ptr<Scope>>;
 	Scopes scopes;
 	StackHeightInfo stackHeightInfo;
 	/// Virtual blocks which will be used for scopes for function arguments and return values.
 	std::map<FunctionDefinition const*, std::shared_ptr<Block const>> virtualBlocks;
+	/// Number of variables, labels and functions registered in the scopes. They are the
+	/// upper bounds of the indices of the scope entities.
+	size_t numberOfVariables = 0;
+	size_t numberOfLabels = 0;
+	size_t numberOfFunctions = 0;
 };
 
 }
@@ -24,29 +24,35 @@ using namespace std;
 using namespace dev;
 using namespace yul;
 
-bool Scope::registerLabel(YulString _name)
+bool Scope::registerLabel(YulString _name, size_t _index)
 {
 	if (exists(_name))
 		return false;
-	identifiers[_name] = Label();
+	identifiers[_name] = Label{_index};
 	return true;
 }
 
-bool Scope::registerVariable(YulString _name, YulType const& _type)
+bool Scope::registerVariable(YulString _name, YulType const& _type, size_t _index)
 {
 	if (exists(_name))
 		return false;
 	Variable variable;
 	variable.type = _type;
-	identifiers[_name] = variable;
+	variable.index = _index;
+	variables.push_back(&boost::get<Variable>(identifiers[_name] = variable));
 	return true;
 }
 
-bool Scope::registerFunction(YulString _name, std::vector<YulType> const& _arguments, std::vector<YulType> const& _returns)
+bool Scope::registerFunction(
+	YulString _name,
+	std::vector<YulType> const& _arguments,
+	std::vector<YulType> const& _returns,
+	size_t _index
+)
 {
 	if (exists(_name))
 		return false;
-	identifiers[_name] = Function{_arguments, _returns};
+	identifiers[_name] = Function{_arguments, _returns, _index};
 	return true;
 }
 
@@ -82,11 +88,7 @@ bool Scope::exists(YulString _name) const
 
 size_t Scope::numberOfVariables() const
 {
-	size_t count = 0;
-	for (auto const& identifier: identifiers)
-		if (identifier.second.type() == typeid(Scope::Variable))
-			count++;
-	return count;
+	return variables.size();
 }
 
 bool Scope::insideFunction() const
@@ -31,6 +31,8 @@
 
 #include <functional>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace yul
 {
@@ -40,24 +42,33 @@ struct Scope
 	using YulType = YulString;
 	using LabelID = size_t;
 
-	struct Variable { YulType type; };
-	struct Label { };
+	/// Variables, labels and functions carry an index that is unique among the entities
+	/// of the same kind in an AsmAnalysisInfo, so that code generation can keep its
+	/// bookkeeping in dense tables.
+	struct Variable
+	{
+		YulType type;
+		size_t index;
+	};
+	struct Label { size_t index; };
 	struct Function
 	{
 		std::vector<YulType> arguments;
 		std::vector<YulType> returns;
+		size_t index;
 	};
 
 	using Identifier = boost::variant<Variable, Label, Function>;
 	using Visitor = dev::GenericVisitor<Variable const, Label const, Function const>;
 	using NonconstVisitor = dev::GenericVisitor<Variable, Label, Function>;
 
-	bool registerVariable(YulString _name, YulType const& _type);
-	bool registerLabel(YulString _name);
+	bool registerVariable(YulString _name, YulType const& _type, size_t _index);
+	bool registerLabel(YulString _name, size_t _index);
 	bool registerFunction(
 		YulString _name,
 		std::vector<YulType> const& _arguments,
-		std::vector<YulType> const& _returns
+		std::vector<YulType> const& _returns,
+		size_t _index
 	);
 
 	/// Looks up the identifier in this or super scopes and returns a valid pointer if found
@@ -93,7 +104,9 @@ struct Scope
 	/// If true, variables from the super scope are not visible here (other identifiers are),
 	/// but they are still taken into account to prevent shadowing.
 	bool functionScope = false;
-	std::map<YulString, Identifier> identifiers;
+	std::unordered_map<YulString, Identifier> identifiers;
+	/// The variables registered directly inside the scope, in the order of registration.
+	std::vector<Variable const*> variables;
 };
 
 }
@@ -52,7 +52,7 @@ bool ScopeFiller::operator()(ExpressionStatement const& _expr)
 
 bool ScopeFiller::operator()(Label const& _item)
 {
-	if (!m_currentScope->registerLabel(_item.name))
+	if (!m_currentScope->registerLabel(_item.name, m_info.numberOfLabels))
 	{
 		//@TODO secondary location
 		m_errorReporter.declarationError(
@@ -61,6 +61,7 @@ bool ScopeFiller::operator()(Label const& _item)
 		);
 		return false;
 	}
+	m_info.numberOfLabels++;
 	return true;
 }
 
@@ -81,7 +82,9 @@ bool ScopeFiller::operator()(FunctionDefinition const& _funDef)
 	vector<Scope::YulType> returns;
 	for (auto const& _return: _funDef.returnVariables)
 		returns.emplace_back(_return.type.str());
-	if (!m_currentScope->registerFunction(_funDef.name, arguments, returns))
+	if (m_currentScope->registerFunction(_funDef.name, arguments, returns, m_info.numberOfFunctions))
+		m_info.numberOfFunctions++;
+	else
 	{
 		//@TODO secondary location
 		m_errorReporter.declarationError(
@@ -166,7 +169,7 @@ bool ScopeFiller::operator()(Block const& _block)
 
 bool ScopeFiller::registerVariable(TypedName const& _name, SourceLocation const& _location, Scope& _scope)
 {
-	if (!_scope.registerVariable(_name.name, _name.type))
+	if (!_scope.registerVariable(_name.name, _name.type, m_info.numberOfVariables))
 	{
 		//@TODO secondary location
 		m_errorReporter.declarationError(
@@ -175,6 +178,7 @@ bool ScopeFiller::registerVariable(TypedName const& _name, SourceLocation const&
 		);
 		return false;
 	}
+	m_info.numberOfVariables++;
 	return true;
 }
 
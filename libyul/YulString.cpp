@@ -0,0 +1,109 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+#include <atomic>
+
+using namespace std;
+using namespace yul;
+
+namespace
+{
+atomic<uint64_t> g_lastGeneration{0};
+}
+
+YulStringRepository::Scope::Scope():
+	m_repository(make_unique<YulStringRepository>()),
+	m_previous(currentScope())
+{
+	currentScope() = m_repository.get();
+}
+
+YulStringRepository::Scope::Scope(YulStringRepository& _repository):
+	m_previous(currentScope())
+{
+	currentScope() = &_repository;
+}
+
+YulStringRepository::Scope::~Scope()
+{
+	currentScope() = m_previous;
+}
+
+YulStringRepository::YulStringRepository():
+	m_generation(++g_lastGeneration)
+{
+	// Reserve ID zero for the empty string.
+	Shard& shard = m_shards[0];
+	shard.chunks[0].reset(new string[c_chunkSize]);
+	shard.size = 1;
+}
+
+YulStringRepository& YulStringRepository::instance()
+{
+	if (YulStringRepository* scoped = currentScope())
+		return *scoped;
+	static YulStringRepository inst;
+	return inst;
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+	size_t shardIndex = h % c_shardCount;
+	Shard& shard = m_shards[shardIndex];
+
+	lock_guard<mutex> lock(shard.mutex);
+	auto range = shard.hashToIndex.equal_range(h);
+	for (auto it = range.first; it != range.second; ++it)
+		if (shard.chunks[it->second / c_chunkSize][it->second % c_chunkSize] == _string)
+			return Handle{it->second * c_shardCount + shardIndex, h};
+
+	size_t index = shard.size;
+	size_t chunk = index / c_chunkSize;
+	yulAssert(chunk < c_maxChunks, "Too many distinct YulStrings.");
+	if (!shard.chunks[chunk])
+		shard.chunks[chunk].reset(new string[c_chunkSize]);
+	shard.chunks[chunk][index % c_chunkSize] = _string;
+	shard.size++;
+	shard.hashToIndex.emplace_hint(range.second, make_pair(h, index));
+	return Handle{index * c_shardCount + shardIndex, h};
+}
+
+string const& YulStringRepository::idToString(size_t _id) const
+{
+	// The handle was created after the string was stored, so reading
+	// it does not require the lock of the shard.
+	Shard const& shard = m_shards[_id % c_shardCount];
+	size_t index = _id / c_shardCount;
+	yulAssert(shard.chunks[index / c_chunkSize], "Invalid YulString ID.");
+	return shard.chunks[index / c_chunkSize][index % c_chunkSize];
+}
+
+YulStringRepository*& YulStringRepository::currentScope()
+{
+	static thread_local YulStringRepository* repository = nullptr;
+	return repository;
+}
@@ -22,10 +22,12 @@
 
 #include <boost/noncopyable.hpp>
 
-#include <unordered_map>
+#include <array>
+#include <cstdint>
 #include <memory>
-#include <vector>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace yul
 {
@@ -34,6 +36,10 @@ namespace yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// The repository is safe to use from multiple threads. It is split into shards selected
+/// by the string hash, each with its own lock for insertions. Strings are stored in chunks
+/// that are never moved, so looking up the string of an existing handle does not lock.
 class YulStringRepository: boost::noncopyable
 {
 public:
@@ -43,32 +49,43 @@ public:
 		std::uint64_t hash;
 	};
 
-	YulStringRepository() = default;
-
-	static YulStringRepository& instance()
+	/// Installs a fresh repository for the current thread for the lifetime of the scope object.
+	/// All YulStrings created or accessed by the thread while the scope is active refer to
+	/// that repository, which is freed when the scope ends. YulStrings must therefore not
+	/// outlive the scope they were created in.
+	class Scope: boost::noncopyable
 	{
-		static YulStringRepository inst;
-		return inst;
-	}
-	Handle stringToHandle(std::string const& _string)
-	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-		return Handle{id, h};
-	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
+	public:
+		Scope();
+		/// Installs an existing repository for the current thread, e.g. the one of the
+		/// thread that started a parallel task. Does not take ownership.
+		explicit Scope(YulStringRepository& _repository);
+		~Scope();
+
+	private:
+		std::unique_ptr<YulStringRepository> m_repository;
+		YulStringRepository* m_previous = nullptr;
+	};
+
+	YulStringRepository();
+
+	/// @returns the repository of the innermost active scope of the current thread
+	/// or the process-wide repository if there is none.
+	static YulStringRepository& instance();
+	/// @returns true if a scope is active for the current thread.
+	static bool scopeActive() { return currentScope(); }
+
+	/// @returns a number that identifies the repository. Unlike its address, it is not reused
+	/// by repositories created after this one is freed.
+	std::uint64_t generation() const { return m_generation; }
+
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const;
 
 	static std::uint64_t hash(std::string const& v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash - can be replaced by a better one, e.g. xxhash64,
+		// but note that the order of YulStrings depends on it.
 		std::uint64_t hash = emptyHash();
 		for (auto c: v)
 		{
@@ -81,8 +98,27 @@ public:
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
 
 private:
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	static constexpr size_t c_shardCount = 16;
+	static constexpr size_t c_chunkSize = 1024;
+	static constexpr size_t c_maxChunks = 1024;
+
+	struct Shard
+	{
+		/// Guards insertions into the shard.
+		std::mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToIndex;
+		size_t size = 0;
+		/// Storage of the strings. Chunks are only ever appended, so references stay valid.
+		std::array<std::unique_ptr<std::string[]>, c_maxChunks> chunks;
+	};
+
+	/// @returns the repository installed by the innermost active scope of the current thread.
+	static YulStringRepository*& currentScope();
+
+	/// The string with ID @a _id is stored at index @a _id / c_shardCount of shard @a _id % c_shardCount.
+	/// The empty string has ID zero.
+	std::array<Shard, c_shardCount> m_shards;
+	std::uint64_t const m_generation;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -117,6 +153,8 @@ public:
 	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
 
 	bool empty() const { return m_handle.id == 0; }
+	/// @returns the deterministic hash of the string.
+	std::uint64_t hash() const { return m_handle.hash; }
 	std::string const& str() const
 	{
 		return YulStringRepository::instance().idToString(m_handle.id);
@@ -133,3 +171,14 @@ inline YulString operator "" _yulstring(char const* _string, std::size_t _size)
 }
 
 }
+
+namespace std
+{
+template<> struct hash<yul::YulString>
+{
+	size_t operator()(yul::YulString const& _x) const
+	{
+		return static_cast<size_t>(_x.hash());
+	}
+};
+}
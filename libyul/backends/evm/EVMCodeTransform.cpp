@@ -33,6 +33,15 @@ using namespace std;
 using namespace dev;
 using namespace yul;
 
+CodeTransformContext::CodeTransformContext(AsmAnalysisInfo const& _info):
+	labelIDs(_info.numberOfLabels),
+	functionEntryIDs(_info.numberOfFunctions),
+	variableStackHeights(_info.numberOfVariables),
+	variableReferences(_info.numberOfVariables, 0),
+	variablesScheduledForDeletion(_info.numberOfVariables, false)
+{
+}
+
 void VariableReferenceCounter::operator()(Identifier const& _identifier)
 {
 	increaseRefIfFound(_identifier.name);
@@ -83,7 +92,7 @@ void VariableReferenceCounter::increaseRefIfFound(YulString _variableName)
 	m_scope->lookup(_variableName, Scope::Visitor(
 		[=](Scope::Variable const& _var)
 		{
-			++m_context.variableReferences[&_var];
+			++m_context.variableReferences.at(_var.index);
 		},
 		[=](Scope::Label const&) { },
 		[=](Scope::Function const&) { }
@@ -115,7 +124,7 @@ CodeTransform::CodeTransform(
 	if (!m_context)
 	{
 		// initialize
-		m_context = make_shared<Context>();
+		m_context = make_shared<Context>(m_info);
 		if (m_allowStackOpt)
 			VariableReferenceCounter{*m_context, m_info}(_block);
 	}
@@ -126,16 +135,16 @@ void CodeTransform::decreaseReference(YulString, Scope::Variable const& _var)
 	if (!m_allowStackOpt)
 		return;
 
-	unsigned& ref = m_context->variableReferences.at(&_var);
+	unsigned& ref = m_context->variableReferences.at(_var.index);
 	solAssert(ref >= 1, "");
 	--ref;
 	if (ref == 0)
-		m_variablesScheduledForDeletion.insert(&_var);
+		m_context->variablesScheduledForDeletion[_var.index] = true;
 }
 
 bool CodeTransform::unreferenced(Scope::Variable const& _var) const
 {
-	return !m_context->variableReferences.count(&_var) || m_context->variableReferences[&_var] == 0;
+	return m_context->variableReferences.at(_var.index) == 0;
 }
 
 void CodeTransform::freeUnusedVariables()
@@ -143,13 +152,9 @@ void CodeTransform::freeUnusedVariables()
 	if (!m_allowStackOpt)
 		return;
 
-	for (auto const& identifier: m_scope->identifiers)
-		if (identifier.second.type() == typeid(Scope::Variable))
-		{
-			Scope::Variable const& var = boost::get<Scope::Variable>(identifier.second);
-			if (m_variablesScheduledForDeletion.count(&var))
-				deleteVariable(var);
-		}
+	for (Scope::Variable const* var: m_scope->variables)
+		if (m_context->variablesScheduledForDeletion[var->index])
+			deleteVariable(*var);
 
 	while (m_unusedStackSlots.count(m_assembly.stackHeight() - 1))
 	{
@@ -162,11 +167,12 @@ void CodeTransform::freeUnusedVariables()
 void CodeTransform::deleteVariable(Scope::Variable const& _var)
 {
 	solAssert(m_allowStackOpt, "");
-	solAssert(m_context->variableStackHeights.count(&_var) > 0, "");
-	m_unusedStackSlots.insert(m_context->variableStackHeights[&_var]);
-	m_context->variableStackHeights.erase(&_var);
-	m_context->variableReferences.erase(&_var);
-	m_variablesScheduledForDeletion.erase(&_var);
+	boost::optional<int>& stackHeight = m_context->variableStackHeights.at(_var.index);
+	solAssert(stackHeight, "");
+	m_unusedStackSlots.insert(*stackHeight);
+	stackHeight.reset();
+	m_context->variableReferences[_var.index] = 0;
+	m_context->variablesScheduledForDeletion[_var.index] = false;
 }
 
 void CodeTransform::operator()(VariableDeclaration const& _varDecl)
@@ -192,7 +198,7 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 	{
 		YulString varName = _varDecl.variables[varIndex].name;
 		auto& var = boost::get<Scope::Variable>(m_scope->identifiers.at(varName));
-		m_context->variableStackHeights[&var] = height + varIndex;
+		m_context->variableStackHeights.at(var.index) = height + varIndex;
 		if (!m_allowStackOpt)
 			continue;
 
@@ -200,13 +206,13 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 		{
 			if (atTopOfStack)
 			{
-				m_context->variableStackHeights.erase(&var);
+				m_context->variableStackHeights[var.index].reset();
 				m_assembly.setSourceLocation(_varDecl.location);
 				m_assembly.appendInstruction(dev::eth::Instruction::POP);
 				--m_stackAdjustment;
 			}
 			else
-				m_variablesScheduledForDeletion.insert(&var);
+				m_context->variablesScheduledForDeletion[var.index] = true;
 		}
 		else if (m_unusedStackSlots.empty())
 			atTopOfStack = false;
@@ -214,7 +220,7 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 		{
 			int slot = *m_unusedStackSlots.begin();
 			m_unusedStackSlots.erase(m_unusedStackSlots.begin());
-			m_context->variableStackHeights[&var] = slot;
+			m_context->variableStackHeights[var.index] = slot;
 			m_assembly.setSourceLocation(_varDecl.location);
 			if (int heightDiff = variableHeightDiff(var, varName, true))
 				m_assembly.appendInstruction(dev::eth::swapInstruction(heightDiff - 1));
@@ -428,7 +434,7 @@ void CodeTransform::operator()(Switch const& _switch)
 
 	visitExpression(*_switch.expression);
 	int expressionHeight = m_assembly.stackHeight();
-	map<Case const*, AbstractAssembly::LabelID> caseBodies;
+	vector<pair<Case const*, AbstractAssembly::LabelID>> caseBodies;
 	AbstractAssembly::LabelID end = m_assembly.newLabelId();
 	for (Case const& c: _switch.cases)
 	{
@@ -437,7 +443,7 @@ void CodeTransform::operator()(Switch const& _switch)
 			(*this)(*c.value);
 			m_assembly.setSourceLocation(c.location);
 			AbstractAssembly::LabelID bodyLabel = m_assembly.newLabelId();
-			caseBodies[&c] = bodyLabel;
+			caseBodies.emplace_back(&c, bodyLabel);
 			solAssert(m_assembly.stackHeight() == expressionHeight + 1, "");
 			m_assembly.appendInstruction(dev::eth::dupInstruction(2));
 			m_assembly.appendInstruction(dev::eth::Instruction::EQ);
@@ -484,7 +490,7 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 	for (auto const& v: _function.parameters | boost::adaptors::reversed)
 	{
 		auto& var = boost::get<Scope::Variable>(varScope->identifiers.at(v.name));
-		m_context->variableStackHeights[&var] = height++;
+		m_context->variableStackHeights.at(var.index) = height++;
 	}
 
 	m_assembly.setSourceLocation(_function.location);
@@ -506,7 +512,7 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 	for (auto const& v: _function.returnVariables)
 	{
 		auto& var = boost::get<Scope::Variable>(varScope->identifiers.at(v.name));
-		m_context->variableStackHeights[&var] = height++;
+		m_context->variableStackHeights.at(var.index) = height++;
 		// Preset stack slots for return variables to zero.
 		m_assembly.appendConstant(u256(0));
 	}
@@ -697,22 +703,21 @@ AbstractAssembly::LabelID CodeTransform::labelFromIdentifier(Identifier const& _
 
 AbstractAssembly::LabelID CodeTransform::labelID(Scope::Label const& _label)
 {
-	if (!m_context->labelIDs.count(&_label))
-		m_context->labelIDs[&_label] = m_assembly.newLabelId();
-	return m_context->labelIDs[&_label];
+	boost::optional<AbstractAssembly::LabelID>& id = m_context->labelIDs.at(_label.index);
+	if (!id)
+		id = m_assembly.newLabelId();
+	return *id;
 }
 
 AbstractAssembly::LabelID CodeTransform::functionEntryID(YulString _name, Scope::Function const& _function)
 {
-	if (!m_context->functionEntryIDs.count(&_function))
-	{
-		AbstractAssembly::LabelID id =
+	boost::optional<AbstractAssembly::LabelID>& id = m_context->functionEntryIDs.at(_function.index);
+	if (!id)
+		id =
 			m_useNamedLabelsForFunctions ?
 			m_assembly.namedLabel(_name.str()) :
 			m_assembly.newLabelId();
-		m_context->functionEntryIDs[&_function] = id;
-	}
-	return m_context->functionEntryIDs[&_function];
+	return *id;
 }
 
 void CodeTransform::visitExpression(Expression const& _expression)
@@ -740,19 +745,15 @@ void CodeTransform::finalizeBlock(Block const& _block, int blockStartStackHeight
 
 	// pop variables
 	solAssert(m_info.scopes.at(&_block).get() == m_scope, "");
-	for (auto const& id: m_scope->identifiers)
-		if (id.second.type() == typeid(Scope::Variable))
+	for (Scope::Variable const* var: m_scope->variables)
+		if (m_allowStackOpt)
 		{
-			Scope::Variable const& var = boost::get<Scope::Variable>(id.second);
-			if (m_allowStackOpt)
-			{
-				solAssert(!m_context->variableStackHeights.count(&var), "");
-				solAssert(!m_context->variableReferences.count(&var), "");
-				m_stackAdjustment++;
-			}
-			else
-				m_assembly.appendInstruction(dev::eth::Instruction::POP);
+			solAssert(!m_context->variableStackHeights[var->index], "");
+			solAssert(m_context->variableReferences[var->index] == 0, "");
+			m_stackAdjustment++;
 		}
+		else
+			m_assembly.appendInstruction(dev::eth::Instruction::POP);
 
 	int deposit = m_assembly.stackHeight() - blockStartStackHeight;
 	solAssert(deposit == 0, "Invalid stack height at end of block: " + to_string(deposit));
@@ -789,8 +790,9 @@ void CodeTransform::generateAssignment(Identifier const& _variableName)
 
 int CodeTransform::variableHeightDiff(Scope::Variable const& _var, YulString _varName, bool _forSwap)
 {
-	solAssert(m_context->variableStackHeights.count(&_var), "");
-	int heightDiff = m_assembly.stackHeight() - m_context->variableStackHeights[&_var];
+	boost::optional<int> const& stackHeight = m_context->variableStackHeights.at(_var.index);
+	solAssert(stackHeight, "");
+	int heightDiff = m_assembly.stackHeight() - *stackHeight;
 	solAssert(heightDiff > (_forSwap ? 1 : 0), "Negative stack difference for variable.");
 	int limit = _forSwap ? 17 : 16;
 	if (heightDiff > limit)
@@ -30,7 +30,9 @@
 #include <boost/variant.hpp>
 #include <boost/optional.hpp>
 
+#include <set>
 #include <stack>
+#include <vector>
 
 namespace langutil
 {
@@ -53,12 +55,25 @@ struct StackTooDeepError: virtual YulException
 	int depth;
 };
 
+/**
+ * State shared between the code transforms of a Yul block and the functions inside it.
+ * The tables are indexed by the indices of the scope entities (see Scope) and sized
+ * by the number of entities in the analysis info.
+ */
 struct CodeTransformContext
 {
-	std::map<Scope::Label const*, AbstractAssembly::LabelID> labelIDs;
-	std::map<Scope::Function const*, AbstractAssembly::LabelID> functionEntryIDs;
-	std::map<Scope::Variable const*, int> variableStackHeights;
-	std::map<Scope::Variable const*, unsigned> variableReferences;
+	explicit CodeTransformContext(AsmAnalysisInfo const& _info);
+
+	std::vector<boost::optional<AbstractAssembly::LabelID>> labelIDs;
+	std::vector<boost::optional<AbstractAssembly::LabelID>> functionEntryIDs;
+	/// Stack heights of the variables that currently occupy a stack slot.
+	std::vector<boost::optional<int>> variableStackHeights;
+	/// Number of references to the variables that still have to be generated.
+	std::vector<unsigned> variableReferences;
+	/// Variables whose reference counter has reached zero,
+	/// and whose stack slot will be marked as unused once we reach
+	/// statement level in the scope where the variable was defined.
+	std::vector<bool> variablesScheduledForDeletion;
 
 	struct JumpInfo
 	{
@@ -236,10 +251,6 @@ private:
 	int m_stackAdjustment = 0;
 	std::shared_ptr<Context> m_context;
 
-	/// Set of variables whose reference counter has reached zero,
-	/// and whose stack slot will be marked as unused once we reach
-	/// statement level in the scope where the variable was defined.
-	std::set<Scope::Variable const*> m_variablesScheduledForDeletion;
 	std::set<int> m_unusedStackSlots;
 
 	std::vector<StackTooDeepError> m_stackErrors;
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AsmData.h>
 #include <libyul/YulString.h>
 
 #include <map>
@@ -88,6 +89,8 @@ protected:
 	/// List of scopes.
 	std::vector<Scope> m_variableScopes;
 	Dialect const& m_dialect;
+	/// Value of variables that are declared without value.
+	Expression const m_zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
 };
 
 }
@@ -171,7 +171,7 @@ vector<Statement> InlineModifier::performInline(Statement& _statement, FunctionC
 
 	m_driver.tentativelyUpdateCodeSize(function->name, m_currentFunction);
 
-	static Expression const zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
+	Expression const zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
 
 	// helper function to create a new variable that is supposed to model
 	// an existing variable.
@@ -24,6 +24,10 @@
 #include <libyul/AsmData.h>
 #include <libyul/Dialect.h>
 
+#include <libdevcore/CommonData.h>
+
+#include <algorithm>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
@@ -39,14 +43,40 @@ NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames)
 {
 }
 
+NameDispenser::NameDispenser(NameDispenser const& _parent, size_t _part, size_t _partCount):
+	m_dialect(_parent.m_dialect),
+	m_parentNames(&_parent.m_usedNames),
+	m_nextSuffix(_parent.m_nextSuffix + _part),
+	m_suffixStep(_partCount)
+{
+}
+
 YulString NameDispenser::newName(YulString _nameHint)
 {
-	YulString name = _nameHint;
-	while (name.empty() || m_usedNames.count(name) || m_dialect.builtin(name))
+	// Parts always use a suffix, since the hint itself could be chosen by multiple parts.
+	YulString name = m_parentNames ? YulString{} : _nameHint;
+	while (
+		name.empty() ||
+		m_usedNames.count(name) ||
+		(m_parentNames && m_parentNames->count(name)) ||
+		m_dialect.builtin(name)
+	)
 	{
-		m_counter++;
-		name = YulString(_nameHint.str() + "_" + to_string(m_counter));
+		name = YulString(_nameHint.str() + "_" + to_string(m_nextSuffix));
+		m_nextSuffix += m_suffixStep;
 	}
 	m_usedNames.emplace(name);
 	return name;
 }
+
+void NameDispenser::merge(vector<NameDispenser> const& _parts)
+{
+	for (NameDispenser const& part: _parts)
+	{
+		m_usedNames += part.m_usedNames;
+		// If the part used a suffix, the last one is one step back. Otherwise, the part is
+		// still at its first suffix, which is less than one step ahead of ours.
+		if (part.m_nextSuffix > part.m_suffixStep)
+			m_nextSuffix = max(m_nextSuffix, part.m_nextSuffix - part.m_suffixStep + 1);
+	}
+}
@@ -24,6 +24,7 @@
 #include <libyul/YulString.h>
 
 #include <set>
+#include <vector>
 
 namespace yul
 {
@@ -42,15 +43,28 @@ public:
 	explicit NameDispenser(Dialect const& _dialect, Block const& _ast);
 	/// Initialize the name dispenser with the given used names.
 	explicit NameDispenser(Dialect const& _dialect, std::set<YulString> _usedNames);
+	/// Initialize the name dispenser for the part with index @a _part out of @a _partCount parts
+	/// of the code that are processed independently. The names returned for different parts
+	/// never clash, independently of the order in which they are requested.
+	/// @a _parent must not be used until the parts are merged back using @a merge.
+	NameDispenser(NameDispenser const& _parent, size_t _part, size_t _partCount);
 
 	/// @returns a currently unused name that should be similar to _nameHint.
 	YulString newName(YulString _nameHint);
 
+	/// Marks all names used by the given part dispensers as used.
+	void merge(std::vector<NameDispenser> const& _parts);
+
 private:
 
 	Dialect const& m_dialect;
 	std::set<YulString> m_usedNames;
-	size_t m_counter = 0;
+	/// Names used by the parent dispenser if this dispenser is responsible for a part of the code.
+	std::set<YulString> const* m_parentNames = nullptr;
+	/// Suffix tried next if a name is already in use. Parts of the code use every
+	/// @a m_suffixStep-th suffix, starting at an offset given by their index.
+	size_t m_nextSuffix = 1;
+	size_t m_suffixStep = 1;
 };
 
 }
@@ -28,6 +28,8 @@
 
 #include <boost/range/algorithm_ext/erase.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
@@ -63,7 +65,7 @@ void RedundantAssignEliminator::operator()(If const& _if)
 	TrackedAssignments skipBranch{m_assignments};
 	(*this)(_if.body);
 
-	merge(m_assignments, move(skipBranch));
+	merge(m_assignments, skipBranch);
 }
 
 void RedundantAssignEliminator::operator()(Switch const& _switch)
@@ -88,8 +90,8 @@ void RedundantAssignEliminator::operator()(Switch const& _switch)
 		m_assignments = move(branches.back());
 		branches.pop_back();
 	}
-	for (auto& branch: branches)
-		merge(m_assignments, move(branch));
+	for (auto const& branch: branches)
+		merge(m_assignments, branch);
 }
 
 void RedundantAssignEliminator::operator()(FunctionDefinition const& _functionDefinition)
@@ -151,8 +153,8 @@ void RedundantAssignEliminator::operator()(ForLoop const& _forLoop)
 	visit(*_forLoop.condition);
 
 	// Order does not matter because "max" is commutative and associative.
-	merge(m_assignments, move(oneRun));
-	merge(m_assignments, move(zeroRuns));
+	merge(m_assignments, oneRun);
+	merge(m_assignments, zeroRuns);
 	merge(m_assignments, move(m_forLoopInfo.pendingBreakStmts));
 	m_forLoopInfo.pendingBreakStmts.clear();
 
@@ -199,7 +201,7 @@ void RedundantAssignEliminator::run(Dialect const& _dialect, Block& _ast)
 }
 
 template <class K, class V, class F>
-void joinMap(std::map<K, V>& _a, std::map<K, V>&& _b, F _conflictSolver)
+void joinMap(std::map<K, V>& _a, std::map<K, V> const& _b, F _conflictSolver)
 {
 	// TODO Perhaps it is better to just create a sorted list
 	// and then use insert(begin, end)
@@ -212,39 +214,45 @@ void joinMap(std::map<K, V>& _a, std::map<K, V>&& _b, F _conflictSolver)
 	for (; itb != bend; ++ita)
 	{
 		if (ita == aend)
-			ita = _a.insert(ita, std::move(*itb++));
+			ita = _a.insert(ita, *itb++);
 		else if (ita->first < itb->first)
 			continue;
 		else if (itb->first < ita->first)
-			ita = _a.insert(ita, std::move(*itb++));
+			ita = _a.insert(ita, *itb++);
 		else
 		{
-			_conflictSolver(ita->second, std::move(itb->second));
+			_conflictSolver(ita->second, itb->second);
 			++itb;
 		}
 	}
 }
 
-void RedundantAssignEliminator::merge(TrackedAssignments& _target, TrackedAssignments&& _other)
+void RedundantAssignEliminator::merge(TrackedAssignments& _target, TrackedAssignments const& _other)
 {
-	joinMap(_target, move(_other), [](
+	_target.merge(_other, [](
 		map<Assignment const*, State>& _assignmentHere,
-		map<Assignment const*, State>&& _assignmentThere
+		map<Assignment const*, State> const& _assignmentThere
 	)
 	{
-		return joinMap(_assignmentHere, move(_assignmentThere), State::join);
+		return joinMap(_assignmentHere, _assignmentThere, State::join);
 	});
 }
 
 void RedundantAssignEliminator::merge(TrackedAssignments& _target, vector<TrackedAssignments>&& _source)
 {
-	for (TrackedAssignments& ts: _source)
-		merge(_target, move(ts));
+	for (TrackedAssignments const& ts: _source)
+		merge(_target, ts);
 	_source.clear();
 }
 
 void RedundantAssignEliminator::changeUndecidedTo(YulString _variable, RedundantAssignEliminator::State _newState)
 {
+	auto const* assignments = m_assignments.find(_variable);
+	// Only modify the map if something changes, so that it keeps sharing the unchanged assignments.
+	if (!assignments || none_of(assignments->begin(), assignments->end(), [](pair<Assignment const*, State> const& _assignment) {
+		return _assignment.second == State::Undecided;
+	}))
+		return;
 	for (auto& assignment: m_assignments[_variable])
 		if (assignment.second == State::Undecided)
 			assignment.second = _newState;
@@ -265,7 +273,10 @@ void RedundantAssignEliminator::finalize(
 	RedundantAssignEliminator::State _finalState
 )
 {
-	for (auto const& assignment: _assignments[_variable])
+	auto const* assignments = _assignments.find(_variable);
+	if (!assignments)
+		return;
+	for (auto const& assignment: *assignments)
 	{
 		State const state = assignment.second == State::Undecided ? _finalState : assignment.second;
 
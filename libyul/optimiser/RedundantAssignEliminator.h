@@ -22,9 +22,13 @@
 #pragma once
 
 #include <libyul/AsmDataForward.h>
+#include <libyul/YulString.h>
 #include <libyul/optimiser/ASTWalker.h>
 
+#include <libdevcore/PersistentMap.h>
+
 #include <map>
+#include <set>
 #include <vector>
 
 namespace yul
@@ -137,14 +141,18 @@ private:
 		Value m_value = Undecided;
 	};
 
-	// TODO check that this does not cause nondeterminism!
-	// This could also be a pseudo-map from state to assignment.
-	using TrackedAssignments = std::map<YulString, std::map<Assignment const*, State>>;
+	struct VariableHash
+	{
+		std::uint64_t operator()(YulString _variable) const { return _variable.hash(); }
+	};
+	/// Copies share the assignments of all variables they do not modify, so copying at
+	/// control flow splits is cheap and joins only visit the variables assigned in between.
+	using TrackedAssignments = dev::PersistentMap<YulString, std::map<Assignment const*, State>, VariableHash>;
 
 	/// Joins the assignment mapping of @a _source into @a _target according to the rules laid out
 	/// above.
+	static void merge(TrackedAssignments& _target, TrackedAssignments const& _source);
 	/// Will destroy @a _source.
-	static void merge(TrackedAssignments& _target, TrackedAssignments&& _source);
 	static void merge(TrackedAssignments& _target, std::vector<TrackedAssignments>&& _source);
 	void changeUndecidedTo(YulString _variable, State _newState);
 	/// Called when a variable goes out of scope. Sets the state of all still undecided
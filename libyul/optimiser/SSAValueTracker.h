@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AsmData.h>
 
 #include <map>
 #include <set>
@@ -52,6 +53,8 @@ private:
 	void setValue(YulString _name, Expression const* _value);
 
 	std::map<YulString, Expression const*> m_values;
+	/// Value of variables that are declared without value.
+	Expression const m_zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
 };
 
 }
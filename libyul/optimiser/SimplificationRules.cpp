@@ -34,6 +34,42 @@ using namespace dev::eth;
 using namespace langutil;
 using namespace yul;
 
+namespace
+{
+
+OperandShape operandShape(Pattern const& _pattern)
+{
+	switch (_pattern.kind())
+	{
+	case PatternKind::Operation:
+		return OperandShape::operation(_pattern.instruction());
+	case PatternKind::Constant:
+		return OperandShape::constant();
+	default:
+		return OperandShape::any();
+	}
+}
+
+/// @returns the shape of @a _expr, resolving variables the same way as Pattern::matches.
+OperandShape operandShape(Expression const& _expr, map<YulString, Expression const*> const& _ssaValues)
+{
+	Expression const* expr = &_expr;
+	if (_expr.type() == typeid(Identifier))
+	{
+		auto value = _ssaValues.find(boost::get<Identifier>(_expr).name);
+		if (value != _ssaValues.end() && value->second)
+			expr = value->second;
+	}
+	if (expr->type() == typeid(Literal) && boost::get<Literal>(*expr).kind == LiteralKind::Number)
+		return OperandShape::constant();
+	else if (expr->type() == typeid(FunctionalInstruction))
+		return OperandShape::operation(boost::get<FunctionalInstruction>(*expr).instruction);
+	else
+		return OperandShape::any();
+}
+
+}
+
 
 SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 	Expression const& _expr,
@@ -44,23 +80,23 @@ SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 	if (_expr.type() != typeid(FunctionalInstruction))
 		return nullptr;
 
-	static SimplificationRules rules;
+	static thread_local SimplificationRules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	FunctionalInstruction const& instruction = boost::get<FunctionalInstruction>(_expr);
-	for (auto const& rule: rules.m_rules[uint8_t(instruction.instruction)])
-	{
+	SimplificationRuleIndex<Pattern>::Shapes operands;
+	for (size_t i = 0; i < instruction.arguments.size() && i < operands.size(); ++i)
+		operands[i] = operandShape(instruction.arguments[i], _ssaValues);
+
+	return rules.m_rules.findFirst(instruction.instruction, operands, [&](SimplificationRule<Pattern> const& _rule) {
 		rules.resetMatchGroups();
-		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
-	}
-	return nullptr;
+		return _rule.pattern.matches(_expr, _dialect, _ssaValues) && (!_rule.feasible || _rule.feasible());
+	});
 }
 
 bool SimplificationRules::isInitialized() const
 {
-	return !m_rules[uint8_t(dev::eth::Instruction::ADD)].empty();
+	return m_rules.hasRules(dev::eth::Instruction::ADD);
 }
 
 void SimplificationRules::addRules(vector<SimplificationRule<Pattern>> const& _rules)
@@ -71,7 +107,12 @@ void SimplificationRules::addRules(vector<SimplificationRule<Pattern>> const& _r
 
 void SimplificationRules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	SimplificationRuleIndex<Pattern>::Shapes operands;
+	vector<Pattern> arguments = _rule.pattern.arguments();
+	assertThrow(arguments.size() <= operands.size(), OptimizerException, "Too many operands in rule.");
+	for (size_t i = 0; i < arguments.size(); ++i)
+		operands[i] = operandShape(arguments[i]);
+	m_rules.add(_rule.pattern.instruction(), _rule, operands);
 }
 
 SimplificationRules::SimplificationRules()
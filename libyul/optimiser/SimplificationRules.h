@@ -21,6 +21,7 @@
 #pragma once
 
 #include <libevmasm/SimplificationRule.h>
+#include <libevmasm/SimplificationRuleIndex.h>
 
 #include <libyul/AsmDataForward.h>
 #include <libyul/AsmData.h>
@@ -62,7 +63,7 @@ private:
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
 	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<dev::eth::SimplificationRule<Pattern>> m_rules[256];
+	dev::eth::SimplificationRuleIndex<Pattern> m_rules;
 };
 
 enum class PatternKind
@@ -104,6 +105,7 @@ public:
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	dev::u256 d() const;
 
+	PatternKind kind() const { return m_kind; }
 	dev::eth::Instruction instruction() const;
 
 	/// Turns this pattern into an actual expression. Should only be called
@@ -0,0 +1,131 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that keeps track of functions that reached a fixpoint.
+ */
+
+#include <libyul/optimiser/StableFunctions.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/Exceptions.h>
+
+#include <libdevcore/Parallel.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+void StableFunctions::startRound(Block const& _ast)
+{
+	for (auto const& statement: _ast.statements)
+		if (statement.type() == typeid(FunctionDefinition))
+		{
+			FunctionDefinition const& function = boost::get<FunctionDefinition>(statement);
+			if (!m_stable.count(function.name))
+				m_copies[function.name] = boost::get<FunctionDefinition>(ASTCopier{}(function));
+		}
+}
+
+void StableFunctions::endRound(Block const& _ast)
+{
+	for (auto const& statement: _ast.statements)
+		if (statement.type() == typeid(FunctionDefinition))
+		{
+			FunctionDefinition const& function = boost::get<FunctionDefinition>(statement);
+			if (unchanged(function))
+				m_stable.insert(function.name);
+			else
+				m_stable.erase(function.name);
+		}
+}
+
+void StableFunctions::checkForChanges(Block const& _ast)
+{
+	for (auto const& statement: _ast.statements)
+		if (statement.type() == typeid(FunctionDefinition))
+		{
+			FunctionDefinition const& function = boost::get<FunctionDefinition>(statement);
+			if (m_stable.count(function.name) && !unchanged(function))
+				m_stable.erase(function.name);
+		}
+}
+
+void StableFunctions::runOnUnstable(
+	Block& _ast,
+	NameDispenser& _dispenser,
+	size_t _threads,
+	function<void(Block&, NameDispenser&)> const& _steps
+) const
+{
+	// Split into the top-level code, the functions the steps are applied to and the stable functions.
+	// The ranks are the positions among all function definitions.
+	vector<Block> parts;
+	parts.emplace_back(Block{_ast.location, {}});
+	vector<Statement> stableFunctions;
+	vector<size_t> stableRanks;
+	size_t rank = 0;
+	for (auto& statement: _ast.statements)
+		if (statement.type() == typeid(FunctionDefinition))
+		{
+			if (m_stable.count(boost::get<FunctionDefinition>(statement).name))
+			{
+				stableRanks.push_back(rank);
+				stableFunctions.emplace_back(std::move(statement));
+			}
+			else
+			{
+				parts.emplace_back(Block{_ast.location, {}});
+				parts.back().statements.emplace_back(std::move(statement));
+			}
+			rank++;
+		}
+		else
+			parts.front().statements.emplace_back(std::move(statement));
+
+	vector<NameDispenser> dispensers;
+	dispensers.reserve(parts.size());
+	for (size_t i = 0; i < parts.size(); ++i)
+		dispensers.emplace_back(_dispenser, i, parts.size());
+	YulStringRepository& repository = YulStringRepository::instance();
+	parallelFor(parts.size(), _threads, [&](size_t _index) {
+		YulStringRepository::Scope scope{repository};
+		_steps(parts[_index], dispensers[_index]);
+	});
+	_dispenser.merge(dispensers);
+
+	// Re-assemble, keeping the relative order of all function definitions.
+	_ast.statements = std::move(parts.front().statements);
+	size_t nextStable = 0;
+	rank = 0;
+	for (size_t i = 1; i < parts.size(); ++i)
+	{
+		yulAssert(parts[i].statements.size() == 1, "");
+		for (; nextStable < stableFunctions.size() && stableRanks[nextStable] == rank; ++nextStable, ++rank)
+			_ast.statements.emplace_back(std::move(stableFunctions[nextStable]));
+		_ast.statements.emplace_back(std::move(parts[i].statements.front()));
+		rank++;
+	}
+	for (; nextStable < stableFunctions.size(); ++nextStable)
+		_ast.statements.emplace_back(std::move(stableFunctions[nextStable]));
+}
+
+bool StableFunctions::unchanged(FunctionDefinition const& _function) const
+{
+	auto copy = m_copies.find(_function.name);
+	return copy != m_copies.end() && SyntacticallyEqual{}.statementEqual(copy->second, _function);
+}
@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that keeps track of functions that reached a fixpoint.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/AsmData.h>
+#include <libyul/YulString.h>
+
+#include <functional>
+#include <map>
+#include <set>
+
+namespace yul
+{
+
+/**
+ * Keeps track of the functions that did not change during a full round of the optimiser suite.
+ *
+ * Function-local optimiser steps only depend on the body of the function they are applied to,
+ * so they can be skipped for such stable functions in later rounds. Steps that work across
+ * functions (inliners, the function combiner) can still modify stable functions. This is
+ * detected by comparing against a copy of the function taken when it became stable.
+ *
+ * Since function-local steps do not depend on other functions, they can also be applied to
+ * each function separately and in parallel.
+ *
+ * Prerequisite: Disambiguator, FunctionHoister
+ */
+class StableFunctions
+{
+public:
+	/// Stores copies of all functions that are not known to be stable yet.
+	void startRound(Block const& _ast);
+	/// Marks all functions that are syntactically equal to their copy from the
+	/// start of the round as stable and removes those that changed.
+	void endRound(Block const& _ast);
+	/// Removes all functions from the set of stable functions that changed.
+	void checkForChanges(Block const& _ast);
+
+	/// Runs @a _steps on the top-level code of @a _ast and on each function that is not stable
+	/// separately, using up to @a _threads threads and a name dispenser derived from @a _dispenser
+	/// for each part. The result does not depend on the number of threads.
+	/// The relative order of the function definitions is kept.
+	void runOnUnstable(
+		Block& _ast,
+		NameDispenser& _dispenser,
+		size_t _threads,
+		std::function<void(Block&, NameDispenser&)> const& _steps
+	) const;
+
+	bool isStable(YulString _functionName) const { return m_stable.count(_functionName); }
+
+private:
+	bool unchanged(FunctionDefinition const& _function) const;
+
+	/// Copies of the functions, either from the start of the round or from the
+	/// time they became stable.
+	std::map<YulString, FunctionDefinition> m_copies;
+	std::set<YulString> m_stable;
+};
+
+}
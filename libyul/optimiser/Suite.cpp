@@ -37,6 +37,7 @@
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
+#include <libyul/optimiser/StableFunctions.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
@@ -60,7 +61,8 @@ void OptimiserSuite::run(
 	Block& _ast,
 	AsmAnalysisInfo const& _analysisInfo,
 	bool _optimizeStackAllocation,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	size_t _threads
 )
 {
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
@@ -82,6 +84,16 @@ void OptimiserSuite::run(
 
 	NameDispenser dispenser{*_dialect, ast};
 
+	// Functions that did not change during a full round are excluded from
+	// the function-local steps until a step across functions modifies them.
+	// The function-local steps are run on each function separately and possibly in parallel.
+	StableFunctions stableFunctions;
+	// The pruner removes unused variables inside of functions, so stable functions can change.
+	auto pruneUnused = [&]() {
+		UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
+		stableFunctions.checkForChanges(ast);
+	};
+
 	size_t codeSize = 0;
 	for (size_t rounds = 0; rounds < 12; ++rounds)
 	{
@@ -92,37 +104,44 @@ void OptimiserSuite::run(
 			codeSize = newSize;
 		}
 
-		{
+		stableFunctions.startRound(ast);
+
+		stableFunctions.runOnUnstable(ast, dispenser, _threads, [&](Block& _ast, NameDispenser& _dispenser) {
 			// Turn into SSA and simplify
-			ExpressionSplitter{*_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
+			ExpressionSplitter{*_dialect, _dispenser}(_ast);
+			SSATransform::run(_ast, _dispenser);
+			RedundantAssignEliminator::run(*_dialect, _ast);
+			RedundantAssignEliminator::run(*_dialect, _ast);
 
-			ExpressionSimplifier::run(*_dialect, ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
-		}
+			ExpressionSimplifier::run(*_dialect, _ast);
+			CommonSubexpressionEliminator{*_dialect}(_ast);
 
-		{
 			// still in SSA, perform structural simplification
-			StructuralSimplifier{*_dialect}(ast);
-			BlockFlattener{}(ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-		}
+			StructuralSimplifier{*_dialect}(_ast);
+			BlockFlattener{}(_ast);
+		});
+		pruneUnused();
+
 		{
 			// simplify again
-			CommonSubexpressionEliminator{*_dialect}(ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
+			stableFunctions.runOnUnstable(ast, dispenser, _threads, [&](Block& _ast, NameDispenser&) {
+				CommonSubexpressionEliminator{*_dialect}(_ast);
+			});
+			pruneUnused();
 		}
 
 		{
 			// reverse SSA
-			SSAReverser::run(ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-
-			ExpressionJoiner::run(ast);
-			ExpressionJoiner::run(ast);
+			stableFunctions.runOnUnstable(ast, dispenser, _threads, [&](Block& _ast, NameDispenser&) {
+				SSAReverser::run(_ast);
+				CommonSubexpressionEliminator{*_dialect}(_ast);
+			});
+			pruneUnused();
+
+			stableFunctions.runOnUnstable(ast, dispenser, _threads, [&](Block& _ast, NameDispenser&) {
+				ExpressionJoiner::run(_ast);
+				ExpressionJoiner::run(_ast);
+			});
 		}
 
 		// should have good "compilability" property here.
@@ -130,41 +149,47 @@ void OptimiserSuite::run(
 		{
 			// run functional expression inliner
 			ExpressionInliner(*_dialect, ast).run();
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
+			pruneUnused();
 		}
 
-		{
+		stableFunctions.runOnUnstable(ast, dispenser, _threads, [&](Block& _ast, NameDispenser& _dispenser) {
 			// Turn into SSA again and simplify
-			ExpressionSplitter{*_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
-		}
+			ExpressionSplitter{*_dialect, _dispenser}(_ast);
+			SSATransform::run(_ast, _dispenser);
+			RedundantAssignEliminator::run(*_dialect, _ast);
+			RedundantAssignEliminator::run(*_dialect, _ast);
+			CommonSubexpressionEliminator{*_dialect}(_ast);
+		});
 
 		{
 			// run full inliner
 			FunctionGrouper{}(ast);
 			EquivalentFunctionCombiner::run(ast);
 			FullInliner{ast, dispenser}.run();
-			BlockFlattener{}(ast);
+			stableFunctions.checkForChanges(ast);
 		}
 
-		{
+		stableFunctions.runOnUnstable(ast, dispenser, _threads, [&](Block& _ast, NameDispenser& _dispenser) {
+			BlockFlattener{}(_ast);
+
 			// SSA plus simplify
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			ExpressionSimplifier::run(*_dialect, ast);
-			StructuralSimplifier{*_dialect}(ast);
-			BlockFlattener{}(ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-			CommonSubexpressionEliminator{*_dialect}(ast);
-		}
+			SSATransform::run(_ast, _dispenser);
+			RedundantAssignEliminator::run(*_dialect, _ast);
+			RedundantAssignEliminator::run(*_dialect, _ast);
+			ExpressionSimplifier::run(*_dialect, _ast);
+			StructuralSimplifier{*_dialect}(_ast);
+			BlockFlattener{}(_ast);
+			CommonSubexpressionEliminator{*_dialect}(_ast);
+			SSATransform::run(_ast, _dispenser);
+			RedundantAssignEliminator::run(*_dialect, _ast);
+			RedundantAssignEliminator::run(*_dialect, _ast);
+		});
+		pruneUnused();
+		stableFunctions.runOnUnstable(ast, dispenser, _threads, [&](Block& _ast, NameDispenser&) {
+			CommonSubexpressionEliminator{*_dialect}(_ast);
+		});
+
+		stableFunctions.endRound(ast);
 	}
 
 	// Make source short and pretty.
@@ -38,12 +38,15 @@ struct Dialect;
 class OptimiserSuite
 {
 public:
+	/// Optimises @a _ast. The function-local steps are applied to each function separately,
+	/// using up to @a _threads threads. The result does not depend on the number of threads.
 	static void run(
 		std::shared_ptr<Dialect> const& _dialect,
 		Block& _ast,
 		AsmAnalysisInfo const& _analysisInfo,
 		bool _optimizeStackAllocation,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		size_t _threads = 1
 	);
 };
 
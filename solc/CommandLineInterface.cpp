@@ -35,6 +35,7 @@
 #include <libsolidity/interface/GasEstimator.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/YulString.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/GasMeter.h>
@@ -48,12 +49,16 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/MappedFile.h>
 
+#include <algorithm>
 #include <memory>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/optional.hpp>
 
 #ifdef _WIN32 // windows
 	#include <io.h>
@@ -105,6 +110,7 @@ static string const g_strAsm = "asm";
 static string const g_strAsmJson = "asm-json";
 static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
@@ -133,8 +139,11 @@ static string const g_strOpcodes = "opcodes";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
+static string const g_strYulOptimizerThreads = "yul-optimizer-threads";
+static string const g_strJobs = "jobs";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
+static string const g_strServer = "server";
 static string const g_strSignatureHashes = "hashes";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
@@ -152,6 +161,7 @@ static string const g_strNewReporter = "new-reporter";
 static string const g_argAbi = g_strAbi;
 static string const g_argPrettyJson = g_strPrettyJson;
 static string const g_argAllowPaths = g_strAllowPaths;
+static string const g_argCacheDir = g_strCacheDir;
 static string const g_argAsm = g_strAsm;
 static string const g_argAsmJson = g_strAsmJson;
 static string const g_argAssemble = g_strAssemble;
@@ -176,8 +186,11 @@ static string const g_argNatspecUser = g_strNatspecUser;
 static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
+static string const g_argYulOptimizerThreads = g_strYulOptimizerThreads;
+static string const g_argJobs = g_strJobs;
 static string const g_argOutputDir = g_strOutputDir;
 static string const g_argSignatureHashes = g_strSignatureHashes;
+static string const g_argServer = g_strServer;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStrictAssembly = g_strStrictAssembly;
 static string const g_argVersion = g_strVersion;
@@ -471,13 +484,16 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 					continue;
 				}
 
-				m_sourceCodes[infile.generic_string()] = dev::readFileAsString(infile.string());
+				m_sourceCodes[infile.generic_string()] = CharStream(
+					make_shared<dev::MappedFile const>(infile.string()),
+					infile.generic_string()
+				);
 				path = boost::filesystem::canonical(infile).string();
 			}
 			m_allowedDirectories.push_back(boost::filesystem::path(path).remove_filename());
 		}
 	if (addStdin)
-		m_sourceCodes[g_stdinFileName] = dev::readStandardInput();
+		m_sourceCodes[g_stdinFileName] = CharStream(dev::readStandardInput(), g_stdinFileName);
 	if (m_sourceCodes.size() == 0)
 	{
 		serr() << "No input files given. If you wish to use the standard input please specify \"-\" explicitly." << endl;
@@ -487,6 +503,14 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 	return true;
 }
 
+StringMap CommandLineInterface::sourceCodeStrings() const
+{
+	StringMap sourceCodes;
+	for (auto const& src: m_sourceCodes)
+		sourceCodes[src.first] = src.second.source();
+	return sourceCodes;
+}
+
 bool CommandLineInterface::parseLibraryOption(string const& _input)
 {
 	namespace fs = boost::filesystem;
@@ -617,6 +641,16 @@ Allowed options)",
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
 		(g_strOptimizeYul.c_str(), "Enable Yul optimizer in Solidity, mostly for ABIEncoderV2. Still considered experimental.")
+		(
+			g_argYulOptimizerThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Set how many threads the Yul optimizer uses to optimize functions in parallel. Does not change the output."
+		)
+		(
+			g_argJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Set on how many threads contracts that do not create each other are compiled in parallel. Does not change the bytecode."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
 		(
 			g_argLibraries.c_str(),
@@ -642,6 +676,20 @@ Allowed options)",
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input and provides the result on the standard output."
 		)
+		(
+			g_argServer.c_str(),
+			"Switch to Standard JSON server mode, ignoring all options except --allow-paths and --cache-dir. "
+			"It reads Standard JSON inputs from standard input until it is closed and writes each result "
+			"to standard output. Inputs and results are preceded by a \"Content-Length: <bytes>\" header "
+			"and an empty line. Every input is compiled from scratch."
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Cache the outputs of Standard JSON and server mode compilations in the given directory and reuse them "
+			"if the input, the compiler version and all imported files are unchanged. "
+			"The answers of the SMT solvers are cached in its subdirectory \"smt\"."
+		)
 		(
 			g_argAssemble.c_str(),
 			"Switch to assembly mode, ignoring all options except --machine and --optimize and assumes input is assembly."
@@ -783,9 +831,11 @@ bool CommandLineInterface::processInput()
 			if (!boost::filesystem::is_regular_file(canonicalPath))
 				return ReadCallback::Result{false, "Not a valid file."};
 
-			auto contents = dev::readFileAsString(canonicalPath.string());
-			m_sourceCodes[path.generic_string()] = contents;
-			return ReadCallback::Result{true, contents};
+			CharStream& stream = m_sourceCodes[path.generic_string()] = CharStream(
+				make_shared<dev::MappedFile const>(canonicalPath.string()),
+				path.generic_string()
+			);
+			return ReadCallback::Result{true, stream.source()};
 		}
 		catch (Exception const& _exception)
 		{
@@ -817,10 +867,15 @@ bool CommandLineInterface::processInput()
 	{
 		string input = dev::readStandardInput();
 		StandardCompiler compiler(fileReader);
+		if (m_args.count(g_argCacheDir))
+			compiler.setCacheDirectory(m_args[g_argCacheDir].as<string>());
 		sout() << compiler.compile(input) << endl;
 		return true;
 	}
 
+	if (m_args.count(g_argServer))
+		return serveStandardJSON(fileReader);
+
 	if (!readInputFilesAndConfigureRemappings())
 		return false;
 
@@ -901,7 +956,7 @@ bool CommandLineInterface::processInput()
 			m_compiler->useMetadataLiteralSources(true);
 		if (m_args.count(g_argInputFile))
 			m_compiler->setRemappings(m_remappings);
-		m_compiler->setSources(m_sourceCodes);
+		m_compiler->setSourceStreams(m_sourceCodes);
 		if (m_args.count(g_argLibraries))
 			m_compiler->setLibraries(m_libraries);
 		m_compiler->setEVMVersion(m_evmVersion);
@@ -911,7 +966,9 @@ bool CommandLineInterface::processInput()
 		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
 		settings.runYulOptimiser = m_args.count(g_strOptimizeYul);
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
+		settings.yulOptimiserThreads = max(m_args[g_argYulOptimizerThreads].as<unsigned>(), 1u);
 		m_compiler->setOptimiserSettings(settings);
+		m_compiler->setParallelism(m_args[g_argJobs].as<unsigned>());
 
 		bool successful = m_compiler->compile();
 
@@ -1003,7 +1060,7 @@ void CommandLineInterface::handleCombinedJSON()
 		if (requests.count(g_strOpcodes))
 			contractData[g_strOpcodes] = dev::eth::disassemble(m_compiler->object(contractName).bytecode);
 		if (requests.count(g_strAsm))
-			contractData[g_strAsm] = m_compiler->assemblyJSON(contractName, m_sourceCodes);
+			contractData[g_strAsm] = m_compiler->assemblyJSON(contractName, sourceCodeStrings());
 		if (requests.count(g_strSrcMap))
 		{
 			auto map = m_compiler->sourceMapping(contractName);
@@ -1095,7 +1152,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 				string postfix = "";
 				if (_argStr == g_argAst)
 				{
-					ASTPrinter printer(m_compiler->ast(sourceCode.first), sourceCode.second);
+					ASTPrinter printer(m_compiler->ast(sourceCode.first), sourceCode.second.source());
 					printer.print(data);
 				}
 				else
@@ -1117,7 +1174,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 				{
 					ASTPrinter printer(
 						m_compiler->ast(sourceCode.first),
-						sourceCode.second,
+						sourceCode.second.source(),
 						gasCosts
 					);
 					printer.print(sout());
@@ -1131,7 +1188,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
@@ -1141,6 +1198,63 @@ bool CommandLineInterface::actOnInput()
 	return !m_error;
 }
 
+bool CommandLineInterface::serveStandardJSON(ReadCallback::Callback const& _fileReader)
+{
+	// The compiler is kept across requests, together with everything that is
+	// initialised once per process.
+	StandardCompiler compiler(_fileReader);
+	if (m_args.count(g_argCacheDir))
+		compiler.setCacheDirectory(m_args[g_argCacheDir].as<string>());
+
+	string const contentLengthHeader = "Content-Length:";
+	while (true)
+	{
+		boost::optional<size_t> contentLength;
+		string line;
+		while (getline(cin, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			if (line.empty())
+				break;
+			if (boost::starts_with(line, contentLengthHeader))
+				try
+				{
+					contentLength = boost::lexical_cast<size_t>(boost::trim_copy(line.substr(contentLengthHeader.size())));
+				}
+				catch (boost::bad_lexical_cast const&)
+				{
+					serr() << "Invalid header: " << line << endl;
+					return false;
+				}
+		}
+		if (!cin)
+			// End of input.
+			return !contentLength;
+		if (!contentLength)
+		{
+			serr() << "Missing \"" << contentLengthHeader << "\" header." << endl;
+			return false;
+		}
+
+		string input(*contentLength, '\0');
+		if (!cin.read(&input[0], *contentLength))
+		{
+			serr() << "Unexpected end of input." << endl;
+			return false;
+		}
+
+		// Nothing read or created for one request is kept for the next one.
+		m_sourceCodes.clear();
+		string output;
+		{
+			yul::YulStringRepository::Scope yulStrings;
+			output = compiler.compile(input);
+		}
+		sout() << contentLengthHeader << " " << output.size() << "\r\n\r\n" << output << flush;
+	}
+}
+
 bool CommandLineInterface::link()
 {
 	// Map from how the libraries will be named inside the bytecode to their addresses.
@@ -1164,14 +1278,15 @@ bool CommandLineInterface::link()
 	}
 	for (auto& src: m_sourceCodes)
 	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		string code = src.second.source();
+		auto end = code.end();
+		for (auto it = code.begin(); it != end;)
 		{
 			while (it != end && *it != '_') ++it;
 			if (it == end) break;
 			if (end - it < placeholderSize)
 			{
-				serr() << "Error in binary object file " << src.first << " at position " << (end - src.second.begin()) << endl;
+				serr() << "Error in binary object file " << src.first << " at position " << (end - code.begin()) << endl;
 				return false;
 			}
 
@@ -1187,9 +1302,10 @@ bool CommandLineInterface::link()
 		}
 		// Remove hints for resolved libraries.
 		for (auto const& library: m_libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+			boost::algorithm::erase_all(code, "\n" + libraryPlaceholderHint(library.first));
+		while (!code.empty() && *prev(code.end()) == '\n')
+			code.resize(code.size() - 1);
+		src.second = CharStream(std::move(code), src.first);
 	}
 	return true;
 }
@@ -1198,11 +1314,11 @@ void CommandLineInterface::writeLinkedFiles()
 {
 	for (auto const& src: m_sourceCodes)
 		if (src.first == g_stdinFileName)
-			sout() << src.second << endl;
+			sout() << src.second.source() << endl;
 		else
 		{
 			ofstream outFile(src.first);
-			outFile << src.second;
+			outFile << src.second.source();
 			if (!outFile)
 			{
 				serr() << "Could not write to file " << src.first << ". Aborting." << endl;
@@ -1237,16 +1353,18 @@ bool CommandLineInterface::assemble(
 {
 	bool successful = true;
 	map<string, yul::AssemblyStack> assemblyStacks;
+	OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
+	settings.yulOptimiserThreads = max(m_args[g_argYulOptimizerThreads].as<unsigned>(), 1u);
 	for (auto const& src: m_sourceCodes)
 	{
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(
 			m_evmVersion,
 			_language,
-			_optimize ? OptimiserSettings::full() : OptimiserSettings::minimal()
+			settings
 		);
 		try
 		{
-			if (!stack.parseAndAnalyze(src.first, src.second))
+			if (!stack.parseAndAnalyze(src.first, src.second.source()))
 				successful = false;
 			else
 				stack.optimize();
@@ -1351,9 +1469,9 @@ void CommandLineInterface::outputCompilationResults()
 		{
 			string ret;
 			if (m_args.count(g_argAsmJson))
-				ret = dev::jsonPrettyPrint(m_compiler->assemblyJSON(contract, m_sourceCodes));
+				ret = dev::jsonPrettyPrint(m_compiler->assemblyJSON(contract, sourceCodeStrings()));
 			else
-				ret = m_compiler->assemblyString(contract, m_sourceCodes);
+				ret = m_compiler->assemblyString(contract, sourceCodeStrings());
 
 			if (m_args.count(g_argOutputDir))
 			{
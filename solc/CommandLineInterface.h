@@ -23,6 +23,7 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 #include <libyul/AssemblyStack.h>
+#include <liblangutil/CharStream.h>
 #include <liblangutil/EVMVersion.h>
 
 #include <boost/program_options.hpp>
@@ -50,6 +51,10 @@ public:
 	bool actOnInput();
 
 private:
+	/// Compiles Standard JSON inputs read from standard input until it is closed.
+	/// @returns false if the input is malformed.
+	bool serveStandardJSON(ReadCallback::Callback const& _fileReader);
+
 	bool link();
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
@@ -75,6 +80,8 @@ private:
 
 	/// Fills @a m_sourceCodes initially and @a m_redirects.
 	bool readInputFilesAndConfigureRemappings();
+	/// @returns a copy of @a m_sourceCodes as strings, for the outputs that need the text.
+	dev::StringMap sourceCodeStrings() const;
 	/// Tries to read from the file @a _input or interprets _input literally if that fails.
 	/// It then tries to parse the contents and appends to m_libraries.
 	bool parseLibraryOption(std::string const& _input);
@@ -97,8 +104,8 @@ private:
 
 	/// Compiler arguments variable map
 	boost::program_options::variables_map m_args;
-	/// map of input files to source code strings
-	std::map<std::string, std::string> m_sourceCodes;
+	/// map of input files to their source code, memory-mapped where possible
+	std::map<std::string, langutil::CharStream> m_sourceCodes;
 	/// list of remappings
 	std::vector<dev::solidity::CompilerStack::Remapping> m_remappings;
 	/// list of allowed directories to read files from
@@ -79,7 +79,8 @@ CommonOptions::CommonOptions(std::string _caption):
 		("testpath", po::value<fs::path>(&this->testPath)->default_value(dev::test::testPath()), "path to test files")
 		("ipcpath", po::value<fs::path>(&ipcPath)->default_value(IPCEnvOrDefaultPath()), "path to ipc socket")
 		("no-ipc", po::bool_switch(&disableIPC), "disable semantic tests")
-		("no-smt", po::bool_switch(&disableSMT), "disable SMT checker");
+		("no-smt", po::bool_switch(&disableSMT), "disable SMT checker")
+		("internal-evm", po::bool_switch(&internalEVM), "execute semantic tests in an in-process EVM instead of using the ipc socket");
 }
 
 void CommonOptions::validate() const
@@ -95,7 +96,7 @@ void CommonOptions::validate() const
 		"Invalid test path specified."
 	);
 
-	if (!disableIPC)
+	if (!disableIPC && !internalEVM)
 	{
 		assertThrow(
 			!ipcPath.empty(),
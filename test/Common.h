@@ -39,6 +39,8 @@ struct CommonOptions: boost::noncopyable
 	bool optimize = false;
 	bool disableIPC = false;
 	bool disableSMT = false;
+	/// Execute the semantic and end-to-end tests in an in-process EVM instead of the client at ipcPath.
+	bool internalEVM = false;
 
 	langutil::EVMVersion evmVersion() const;
 
@@ -0,0 +1,1290 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * In-process EVM that executes the transactions of the tests without an external client.
+ */
+
+#include <test/EVMHost.h>
+
+#include <test/EVMPrecompiles.h>
+
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/Instruction.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <libdevcore/Keccak256.h>
+
+#include <array>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::test;
+using namespace langutil;
+
+namespace
+{
+
+using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 512, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
+
+unsigned const c_maxCallDepth = 1024;
+size_t const c_maxCodeSize = 0x6000;
+/// Timestamp of the first block after the genesis block.
+u256 const c_initialTimestamp = 1546300800;
+u256 const c_initialBalance = u256("0x100000000000000000000000000000000000000000");
+
+struct OpcodeInfo
+{
+	bool valid = false;
+	unsigned args = 0;
+	unsigned ret = 0;
+	/// Static part of the gas costs, the rest is charged while executing the instruction.
+	unsigned gas = 0;
+};
+
+using OpcodeTable = array<OpcodeInfo, 256>;
+
+bool availableIn(Instruction _instruction, EVMVersion _evmVersion)
+{
+	switch (_instruction)
+	{
+	case Instruction::RETURNDATASIZE:
+	case Instruction::RETURNDATACOPY:
+		return _evmVersion.supportsReturndata();
+	case Instruction::STATICCALL:
+		return _evmVersion.hasStaticCall();
+	case Instruction::REVERT:
+		return _evmVersion >= EVMVersion::byzantium();
+	case Instruction::SHL:
+	case Instruction::SHR:
+	case Instruction::SAR:
+		return _evmVersion.hasBitwiseShifting();
+	case Instruction::CREATE2:
+		return _evmVersion.hasCreate2();
+	case Instruction::EXTCODEHASH:
+		return _evmVersion.hasExtCodeHash();
+	default:
+		return true;
+	}
+}
+
+unsigned staticGas(Instruction _instruction, Tier _tier, EVMVersion _evmVersion)
+{
+	switch (_tier)
+	{
+	case Tier::Zero: return GasCosts::tier0Gas;
+	case Tier::Base: return GasCosts::tier1Gas;
+	case Tier::VeryLow: return GasCosts::tier2Gas;
+	case Tier::Low: return GasCosts::tier3Gas;
+	case Tier::Mid: return GasCosts::tier4Gas;
+	case Tier::High: return GasCosts::tier5Gas;
+	case Tier::Ext: return GasCosts::tier6Gas;
+	case Tier::ExtCode: return GasCosts::extCodeGas(_evmVersion);
+	case Tier::Balance: return GasCosts::balanceGas(_evmVersion);
+	case Tier::Special:
+	case Tier::Invalid:
+		break;
+	}
+	switch (_instruction)
+	{
+	case Instruction::EXP: return GasCosts::expGas;
+	case Instruction::KECCAK256: return GasCosts::keccak256Gas;
+	case Instruction::SLOAD: return GasCosts::sloadGas(_evmVersion);
+	case Instruction::JUMPDEST: return GasCosts::jumpdestGas;
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		return GasCosts::createGas;
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+		return GasCosts::callGas(_evmVersion);
+	case Instruction::SELFDESTRUCT: return GasCosts::selfdestructGas(_evmVersion);
+	default:
+		// LOG and SSTORE are charged completely while executing.
+		return 0;
+	}
+}
+
+/// @returns the table of instructions for the given EVM version. The tables are built once,
+/// because instructionInfo() is too expensive to call for every executed instruction.
+OpcodeTable const& opcodeTable(EVMVersion _evmVersion)
+{
+	static map<EVMVersion, OpcodeTable> const tables = []() {
+		map<EVMVersion, OpcodeTable> result;
+		for (auto evmVersion: {
+			EVMVersion::homestead(),
+			EVMVersion::tangerineWhistle(),
+			EVMVersion::spuriousDragon(),
+			EVMVersion::byzantium(),
+			EVMVersion::constantinople(),
+			EVMVersion::petersburg()
+		})
+		{
+			OpcodeTable& table = result[evmVersion];
+			for (unsigned opcode = 0; opcode < 256; ++opcode)
+			{
+				Instruction instruction = Instruction(opcode);
+				if (!isValidInstruction(instruction) || !availableIn(instruction, evmVersion))
+					continue;
+				InstructionInfo info = instructionInfo(instruction);
+				table[opcode].valid = true;
+				table[opcode].args = unsigned(info.args);
+				table[opcode].ret = unsigned(info.ret);
+				table[opcode].gas = staticGas(instruction, info.gasPriceTier, evmVersion);
+			}
+		}
+		return result;
+	}();
+	return tables.at(_evmVersion);
+}
+
+u256 exp256(u256 _base, u256 _exponent)
+{
+	u256 result = 1;
+	for (; _exponent; _exponent >>= 1)
+	{
+		if (_exponent & 1)
+			result *= _base;
+		_base *= _base;
+	}
+	return result;
+}
+
+u256 toU256(Address const& _address)
+{
+	return u256(u160(_address));
+}
+
+Address toAddress(u256 const& _value)
+{
+	return Address(u160(_value & u256(~u160(0))));
+}
+
+/// @returns the address of a contract created by @a _sender with nonce @a _nonce,
+/// i.e. the hash of the RLP encoding of the pair.
+Address createAddress(Address const& _sender, u256 const& _nonce)
+{
+	bytes nonce = _nonce == 0 ? bytes{0x80} : toCompactBigEndian(_nonce);
+	if (nonce.size() > 1 || nonce[0] >= 0x80)
+		nonce = bytes{uint8_t(0x80 + nonce.size())} + nonce;
+	bytes list = bytes{0x94} + _sender.asBytes() + nonce;
+	return Address(keccak256(bytes{uint8_t(0xc0 + list.size())} + list), Address::AlignRight);
+}
+
+Address create2Address(Address const& _sender, u256 const& _salt, bytes const& _initCode)
+{
+	return Address(
+		keccak256(bytes{0xff} + _sender.asBytes() + toBigEndian(_salt) + keccak256(_initCode).asBytes()),
+		Address::AlignRight
+	);
+}
+
+}
+
+/// Execution of code in a single call frame.
+class EVMHost::Frame
+{
+public:
+	Frame(EVMHost& _host, Message const& _message, bytes const& _code):
+		m_host(_host),
+		m_message(_message),
+		m_code(_code),
+		m_opcodes(opcodeTable(_host.m_evmVersion)),
+		m_gas(_message.gas)
+	{}
+
+	Result run();
+
+private:
+	/// Thrown for out of gas, stack underflow and the other errors that consume all gas.
+	struct ExceptionalHalt {};
+
+	u256 pop()
+	{
+		u256 value = std::move(m_stack.back());
+		m_stack.pop_back();
+		return value;
+	}
+	u256& top(size_t _depth = 0) { return m_stack[m_stack.size() - 1 - _depth]; }
+	void push(u256 _value) { m_stack.emplace_back(std::move(_value)); }
+
+	void useGas(int64_t _amount)
+	{
+		if (_amount > m_gas)
+			throw ExceptionalHalt();
+		m_gas -= _amount;
+	}
+	void useGas(bigint const& _amount)
+	{
+		if (_amount > m_gas)
+			throw ExceptionalHalt();
+		m_gas -= int64_t(_amount);
+	}
+	static bigint words(u256 const& _size) { return (bigint(_size) + 31) / 32; }
+	/// Charges for and grows the memory to include the given range.
+	void expandMemory(u256 const& _offset, u256 const& _size);
+	bytes readMemory(u256 const& _offset, u256 const& _size);
+	/// Copies @a _size bytes of @a _source starting at @a _sourceOffset to memory, padded with zeros.
+	void copyToMemory(bytesConstRef _source, u256 const& _memoryOffset, u256 const& _sourceOffset, u256 const& _size);
+	bool isJumpDestination(u256 const& _target);
+
+	void sstore();
+	void call(Instruction _instruction);
+	void create(Instruction _instruction);
+	void selfdestruct();
+
+	EVMHost& m_host;
+	Message const& m_message;
+	bytes const& m_code;
+	OpcodeTable const& m_opcodes;
+	int64_t m_gas;
+	size_t m_pc = 0;
+	std::vector<u256> m_stack;
+	bytes m_memory;
+	bytes m_returnData;
+	/// Valid jump destinations, determined on the first jump.
+	std::vector<bool> m_jumpDestinations;
+};
+
+void EVMHost::Frame::expandMemory(u256 const& _offset, u256 const& _size)
+{
+	if (_size == 0)
+		return;
+	bigint end = bigint(_offset) + _size;
+	// More memory could never be paid for.
+	if (end > (bigint(1) << 32))
+		throw ExceptionalHalt();
+	if (end <= m_memory.size())
+		return;
+	auto cost = [](bigint const& _words) {
+		return GasCosts::memoryGas * _words + _words * _words / GasCosts::quadCoeffDiv;
+	};
+	bigint newWords = (end + 31) / 32;
+	useGas(cost(newWords) - cost(m_memory.size() / 32));
+	m_memory.resize(size_t(newWords * 32));
+}
+
+bytes EVMHost::Frame::readMemory(u256 const& _offset, u256 const& _size)
+{
+	expandMemory(_offset, _size);
+	if (_size == 0)
+		return {};
+	return bytes(m_memory.begin() + size_t(_offset), m_memory.begin() + size_t(_offset + _size));
+}
+
+void EVMHost::Frame::copyToMemory(
+	bytesConstRef _source,
+	u256 const& _memoryOffset,
+	u256 const& _sourceOffset,
+	u256 const& _size
+)
+{
+	useGas(GasCosts::copyGas * words(_size));
+	expandMemory(_memoryOffset, _size);
+	if (_size == 0)
+		return;
+	size_t const size = size_t(_size);
+	auto target = m_memory.begin() + size_t(_memoryOffset);
+	size_t copied = 0;
+	if (_sourceOffset < _source.size())
+	{
+		copied = min(size, _source.size() - size_t(_sourceOffset));
+		copy_n(_source.begin() + size_t(_sourceOffset), copied, target);
+	}
+	fill(target + copied, target + size, 0);
+}
+
+bool EVMHost::Frame::isJumpDestination(u256 const& _target)
+{
+	if (m_jumpDestinations.empty())
+	{
+		m_jumpDestinations.resize(m_code.size() + 1, false);
+		for (size_t pc = 0; pc < m_code.size(); ++pc)
+		{
+			uint8_t opcode = m_code[pc];
+			if (opcode == uint8_t(Instruction::JUMPDEST))
+				m_jumpDestinations[pc] = true;
+			else if (opcode >= uint8_t(Instruction::PUSH1) && opcode <= uint8_t(Instruction::PUSH32))
+				pc += opcode - uint8_t(Instruction::PUSH1) + 1;
+		}
+	}
+	return _target < m_code.size() && m_jumpDestinations[size_t(_target)];
+}
+
+void EVMHost::Frame::sstore()
+{
+	if (m_message.isStatic)
+		throw ExceptionalHalt();
+	u256 key = pop();
+	u256 value = pop();
+	Address const& address = m_message.recipient;
+	u256 current = m_host.storageAt(address, key);
+	if (m_host.m_evmVersion == EVMVersion::constantinople())
+	{
+		// Net gas metering of EIP-1283.
+		u256 original = m_host.originalStorageAt(address, key);
+		if (current == value)
+			useGas(200);
+		else if (original == current)
+		{
+			if (original == 0)
+				useGas(GasCosts::sstoreSetGas);
+			else
+			{
+				useGas(GasCosts::sstoreResetGas);
+				if (value == 0)
+					m_host.addRefund(GasCosts::sstoreRefundGas);
+			}
+		}
+		else
+		{
+			useGas(200);
+			if (original != 0)
+			{
+				if (current == 0)
+					m_host.addRefund(-int64_t(GasCosts::sstoreRefundGas));
+				else if (value == 0)
+					m_host.addRefund(GasCosts::sstoreRefundGas);
+			}
+			if (original == value)
+				m_host.addRefund(original == 0 ? 19800 : 4800);
+		}
+	}
+	else
+	{
+		useGas(current == 0 && value != 0 ? GasCosts::sstoreSetGas : GasCosts::sstoreResetGas);
+		if (current != 0 && value == 0)
+			m_host.addRefund(GasCosts::sstoreRefundGas);
+	}
+	m_host.setStorage(address, key, value);
+}
+
+void EVMHost::Frame::call(Instruction _instruction)
+{
+	bool const transfersValue = _instruction == Instruction::CALL || _instruction == Instruction::CALLCODE;
+	u256 gas = pop();
+	Address to = toAddress(pop());
+	u256 value = transfersValue ? pop() : 0;
+	u256 inputOffset = pop();
+	u256 inputSize = pop();
+	u256 outputOffset = pop();
+	u256 outputSize = pop();
+
+	if (_instruction == Instruction::CALL && value != 0 && m_message.isStatic)
+		throw ExceptionalHalt();
+	EVMVersion const evmVersion = m_host.m_evmVersion;
+	if (value != 0)
+		useGas(GasCosts::callValueTransferGas);
+	if (_instruction == Instruction::CALL)
+	{
+		if (evmVersion >= EVMVersion::spuriousDragon())
+		{
+			if (value != 0 && m_host.isDead(to))
+				useGas(GasCosts::callNewAccountGas);
+		}
+		else if (!m_host.exists(to))
+			useGas(GasCosts::callNewAccountGas);
+	}
+	expandMemory(inputOffset, inputSize);
+	expandMemory(outputOffset, outputSize);
+
+	int64_t callGas;
+	if (evmVersion.canOverchargeGasForCall())
+		callGas = int64_t(min(bigint(gas), bigint(m_gas - m_gas / 64)));
+	else if (gas > m_gas)
+		throw ExceptionalHalt();
+	else
+		callGas = int64_t(gas);
+	useGas(callGas);
+	if (value != 0)
+		callGas += GasCosts::callStipend;
+
+	m_returnData.clear();
+	if (m_message.depth >= c_maxCallDepth || (value != 0 && m_host.balance(m_message.recipient) < value))
+	{
+		m_gas += callGas;
+		push(0);
+		return;
+	}
+
+	bytes input = readMemory(inputOffset, inputSize);
+	Message message;
+	message.codeAddress = to;
+	message.input = &input;
+	message.gas = callGas;
+	message.depth = m_message.depth + 1;
+	message.isStatic = m_message.isStatic;
+	switch (_instruction)
+	{
+	case Instruction::CALL:
+		message.kind = CallKind::Call;
+		message.recipient = to;
+		message.sender = m_message.recipient;
+		message.value = message.apparentValue = value;
+		break;
+	case Instruction::CALLCODE:
+		message.kind = CallKind::CallCode;
+		message.recipient = m_message.recipient;
+		message.sender = m_message.recipient;
+		message.value = message.apparentValue = value;
+		break;
+	case Instruction::DELEGATECALL:
+		message.kind = CallKind::DelegateCall;
+		message.recipient = m_message.recipient;
+		message.sender = m_message.sender;
+		message.apparentValue = m_message.apparentValue;
+		break;
+	default:
+		message.kind = CallKind::StaticCall;
+		message.recipient = to;
+		message.sender = m_message.recipient;
+		message.isStatic = true;
+		break;
+	}
+
+	Result result = m_host.call(message);
+	m_gas += result.gasLeft;
+	if (result.status != Status::Failure)
+	{
+		m_returnData = std::move(result.output);
+		if (outputSize != 0)
+			copy_n(
+				m_returnData.begin(),
+				min(size_t(outputSize), m_returnData.size()),
+				m_memory.begin() + size_t(outputOffset)
+			);
+	}
+	push(result.status == Status::Success ? 1 : 0);
+}
+
+void EVMHost::Frame::create(Instruction _instruction)
+{
+	u256 value = pop();
+	u256 offset = pop();
+	u256 size = pop();
+	u256 salt = _instruction == Instruction::CREATE2 ? pop() : 0;
+
+	if (m_message.isStatic)
+		throw ExceptionalHalt();
+	expandMemory(offset, size);
+	if (_instruction == Instruction::CREATE2)
+		useGas(GasCosts::keccak256WordGas * words(size));
+
+	int64_t gas = m_host.m_evmVersion.canOverchargeGasForCall() ? m_gas - m_gas / 64 : m_gas;
+	useGas(gas);
+
+	m_returnData.clear();
+	if (m_message.depth >= c_maxCallDepth || m_host.balance(m_message.recipient) < value)
+	{
+		m_gas += gas;
+		push(0);
+		return;
+	}
+
+	bytes initCode = readMemory(offset, size);
+	Message message;
+	message.kind = _instruction == Instruction::CREATE2 ? CallKind::Create2 : CallKind::Create;
+	message.sender = m_message.recipient;
+	message.value = message.apparentValue = value;
+	message.gas = gas;
+	message.depth = m_message.depth + 1;
+	message.salt = salt;
+
+	Result result = m_host.create(message, initCode);
+	m_gas += result.gasLeft;
+	if (result.status == Status::Revert)
+		m_returnData = std::move(result.output);
+	push(result.status == Status::Success ? toU256(result.createdAddress) : 0);
+}
+
+void EVMHost::Frame::selfdestruct()
+{
+	if (m_message.isStatic)
+		throw ExceptionalHalt();
+	Address beneficiary = toAddress(pop());
+	EVMVersion const evmVersion = m_host.m_evmVersion;
+	if (evmVersion >= EVMVersion::spuriousDragon())
+	{
+		if (m_host.isDead(beneficiary) && m_host.balance(m_message.recipient) != 0)
+			useGas(GasCosts::callNewAccountGas);
+	}
+	else if (evmVersion >= EVMVersion::tangerineWhistle() && !m_host.exists(beneficiary))
+		useGas(GasCosts::callNewAccountGas);
+	if (!m_host.m_destructed.count(m_message.recipient))
+		m_host.addRefund(GasCosts::selfdestructRefundGas);
+	m_host.selfdestruct(m_message.recipient, beneficiary);
+}
+
+EVMHost::Result EVMHost::Frame::run()
+{
+	try
+	{
+		while (m_pc < m_code.size())
+		{
+			uint8_t const opcode = m_code[m_pc];
+			OpcodeInfo const& info = m_opcodes[opcode];
+			if (!info.valid || m_stack.size() < info.args || m_stack.size() - info.args + info.ret > GasCosts::stackLimit)
+				throw ExceptionalHalt();
+			useGas(info.gas);
+
+			Instruction const instruction = Instruction(opcode);
+			size_t nextPC = m_pc + 1;
+			switch (instruction)
+			{
+			case Instruction::STOP:
+				return Result{Status::Success, m_gas, {}};
+			case Instruction::ADD:
+			{
+				u256 a = pop();
+				top() = a + top();
+				break;
+			}
+			case Instruction::MUL:
+			{
+				u256 a = pop();
+				top() = a * top();
+				break;
+			}
+			case Instruction::SUB:
+			{
+				u256 a = pop();
+				top() = a - top();
+				break;
+			}
+			case Instruction::DIV:
+			{
+				u256 a = pop();
+				top() = top() == 0 ? 0 : a / top();
+				break;
+			}
+			case Instruction::SDIV:
+			{
+				u256 a = pop();
+				top() = top() == 0 ? 0 : s2u(u2s(a) / u2s(top()));
+				break;
+			}
+			case Instruction::MOD:
+			{
+				u256 a = pop();
+				top() = top() == 0 ? 0 : a % top();
+				break;
+			}
+			case Instruction::SMOD:
+			{
+				u256 a = pop();
+				top() = top() == 0 ? 0 : s2u(u2s(a) % u2s(top()));
+				break;
+			}
+			case Instruction::ADDMOD:
+			{
+				u256 a = pop();
+				u256 b = pop();
+				top() = top() == 0 ? 0 : u256((u512(a) + u512(b)) % u512(top()));
+				break;
+			}
+			case Instruction::MULMOD:
+			{
+				u256 a = pop();
+				u256 b = pop();
+				top() = top() == 0 ? 0 : u256((u512(a) * u512(b)) % u512(top()));
+				break;
+			}
+			case Instruction::EXP:
+			{
+				u256 base = pop();
+				u256& exponent = top();
+				if (exponent != 0)
+					useGas(GasCosts::expByteGas(m_host.m_evmVersion) * (msb(exponent) / 8 + 1));
+				exponent = exp256(base, exponent);
+				break;
+			}
+			case Instruction::SIGNEXTEND:
+			{
+				u256 byteIndex = pop();
+				if (byteIndex < 31)
+				{
+					unsigned testBit = unsigned(byteIndex) * 8 + 7;
+					u256 mask = (u256(1) << testBit) - 1;
+					if (boost::multiprecision::bit_test(top(), testBit))
+						top() |= ~mask;
+					else
+						top() &= mask;
+				}
+				break;
+			}
+			case Instruction::LT:
+			{
+				u256 a = pop();
+				top() = a < top() ? 1 : 0;
+				break;
+			}
+			case Instruction::GT:
+			{
+				u256 a = pop();
+				top() = a > top() ? 1 : 0;
+				break;
+			}
+			case Instruction::SLT:
+			{
+				u256 a = pop();
+				top() = u2s(a) < u2s(top()) ? 1 : 0;
+				break;
+			}
+			case Instruction::SGT:
+			{
+				u256 a = pop();
+				top() = u2s(a) > u2s(top()) ? 1 : 0;
+				break;
+			}
+			case Instruction::EQ:
+			{
+				u256 a = pop();
+				top() = a == top() ? 1 : 0;
+				break;
+			}
+			case Instruction::ISZERO:
+				top() = top() == 0 ? 1 : 0;
+				break;
+			case Instruction::AND:
+			{
+				u256 a = pop();
+				top() &= a;
+				break;
+			}
+			case Instruction::OR:
+			{
+				u256 a = pop();
+				top() |= a;
+				break;
+			}
+			case Instruction::XOR:
+			{
+				u256 a = pop();
+				top() ^= a;
+				break;
+			}
+			case Instruction::NOT:
+				top() = ~top();
+				break;
+			case Instruction::BYTE:
+			{
+				u256 index = pop();
+				top() = index >= 32 ? 0 : (top() >> unsigned(8 * (31 - index))) & 0xff;
+				break;
+			}
+			case Instruction::SHL:
+			{
+				u256 shift = pop();
+				top() = shift > 255 ? 0 : top() << unsigned(shift);
+				break;
+			}
+			case Instruction::SHR:
+			{
+				u256 shift = pop();
+				top() = shift > 255 ? 0 : top() >> unsigned(shift);
+				break;
+			}
+			case Instruction::SAR:
+			{
+				static u256 const highBit = u256(1) << 255;
+				u256 shift = pop();
+				bool negative = (top() & highBit) != 0;
+				if (shift > 255)
+					top() = negative ? ~u256(0) : 0;
+				else if (shift > 0)
+				{
+					top() >>= unsigned(shift);
+					if (negative)
+						top() |= ~u256(0) << (256 - unsigned(shift));
+				}
+				break;
+			}
+			case Instruction::KECCAK256:
+			{
+				u256 offset = pop();
+				u256 size = top();
+				useGas(GasCosts::keccak256WordGas * words(size));
+				top() = u256(keccak256(readMemory(offset, size)));
+				break;
+			}
+			case Instruction::ADDRESS:
+				push(toU256(m_message.recipient));
+				break;
+			case Instruction::BALANCE:
+				top() = m_host.balance(toAddress(top()));
+				break;
+			case Instruction::ORIGIN:
+				push(toU256(m_host.m_origin));
+				break;
+			case Instruction::CALLER:
+				push(toU256(m_message.sender));
+				break;
+			case Instruction::CALLVALUE:
+				push(m_message.apparentValue);
+				break;
+			case Instruction::CALLDATALOAD:
+			{
+				bytes const& input = *m_message.input;
+				u256& offset = top();
+				bytes word(32, 0);
+				if (offset < input.size())
+					copy_n(input.begin() + size_t(offset), min<size_t>(32, input.size() - size_t(offset)), word.begin());
+				offset = fromBigEndian<u256>(word);
+				break;
+			}
+			case Instruction::CALLDATASIZE:
+				push(m_message.input->size());
+				break;
+			case Instruction::CALLDATACOPY:
+			{
+				u256 memoryOffset = pop();
+				u256 dataOffset = pop();
+				u256 size = pop();
+				copyToMemory(bytesConstRef(m_message.input), memoryOffset, dataOffset, size);
+				break;
+			}
+			case Instruction::CODESIZE:
+				push(m_code.size());
+				break;
+			case Instruction::CODECOPY:
+			{
+				u256 memoryOffset = pop();
+				u256 codeOffset = pop();
+				u256 size = pop();
+				copyToMemory(bytesConstRef(&m_code), memoryOffset, codeOffset, size);
+				break;
+			}
+			case Instruction::GASPRICE:
+				push(m_host.m_gasPrice);
+				break;
+			case Instruction::EXTCODESIZE:
+				top() = m_host.code(toAddress(top())).size();
+				break;
+			case Instruction::EXTCODECOPY:
+			{
+				Address address = toAddress(pop());
+				u256 memoryOffset = pop();
+				u256 codeOffset = pop();
+				u256 size = pop();
+				copyToMemory(bytesConstRef(&m_host.code(address)), memoryOffset, codeOffset, size);
+				break;
+			}
+			case Instruction::RETURNDATASIZE:
+				push(m_returnData.size());
+				break;
+			case Instruction::RETURNDATACOPY:
+			{
+				u256 memoryOffset = pop();
+				u256 dataOffset = pop();
+				u256 size = pop();
+				if (bigint(dataOffset) + size > m_returnData.size())
+					throw ExceptionalHalt();
+				copyToMemory(bytesConstRef(&m_returnData), memoryOffset, dataOffset, size);
+				break;
+			}
+			case Instruction::EXTCODEHASH:
+			{
+				Address address = toAddress(top());
+				top() = m_host.isDead(address) ? 0 : u256(keccak256(m_host.code(address)));
+				break;
+			}
+			case Instruction::BLOCKHASH:
+			{
+				u256 const number = m_host.blockNumber();
+				u256& requested = top();
+				if (requested < number && requested + 256 >= number)
+					requested = u256(m_host.blockHash(requested));
+				else
+					requested = 0;
+				break;
+			}
+			case Instruction::COINBASE:
+				push(toU256(m_host.m_coinbase));
+				break;
+			case Instruction::TIMESTAMP:
+				push(m_host.m_blockTimestamps.back());
+				break;
+			case Instruction::NUMBER:
+				push(m_host.blockNumber());
+				break;
+			case Instruction::DIFFICULTY:
+				push(m_host.m_difficulty);
+				break;
+			case Instruction::GASLIMIT:
+				push(m_host.m_gasLimit);
+				break;
+			case Instruction::POP:
+				m_stack.pop_back();
+				break;
+			case Instruction::MLOAD:
+			{
+				u256& offset = top();
+				expandMemory(offset, 32);
+				offset = fromBigEndian<u256>(bytesConstRef(m_memory.data() + size_t(offset), 32));
+				break;
+			}
+			case Instruction::MSTORE:
+			{
+				u256 offset = pop();
+				u256 value = pop();
+				expandMemory(offset, 32);
+				bytesRef word(m_memory.data() + size_t(offset), 32);
+				toBigEndian(value, word);
+				break;
+			}
+			case Instruction::MSTORE8:
+			{
+				u256 offset = pop();
+				u256 value = pop();
+				expandMemory(offset, 1);
+				m_memory[size_t(offset)] = uint8_t(value & 0xff);
+				break;
+			}
+			case Instruction::SLOAD:
+				top() = m_host.storageAt(m_message.recipient, top());
+				break;
+			case Instruction::SSTORE:
+				sstore();
+				break;
+			case Instruction::JUMP:
+			{
+				u256 target = pop();
+				if (!isJumpDestination(target))
+					throw ExceptionalHalt();
+				nextPC = size_t(target);
+				break;
+			}
+			case Instruction::JUMPI:
+			{
+				u256 target = pop();
+				u256 condition = pop();
+				if (condition != 0)
+				{
+					if (!isJumpDestination(target))
+						throw ExceptionalHalt();
+					nextPC = size_t(target);
+				}
+				break;
+			}
+			case Instruction::PC:
+				push(m_pc);
+				break;
+			case Instruction::MSIZE:
+				push(m_memory.size());
+				break;
+			case Instruction::GAS:
+				push(m_gas);
+				break;
+			case Instruction::JUMPDEST:
+				break;
+			case Instruction::LOG0:
+			case Instruction::LOG1:
+			case Instruction::LOG2:
+			case Instruction::LOG3:
+			case Instruction::LOG4:
+			{
+				if (m_message.isStatic)
+					throw ExceptionalHalt();
+				unsigned topics = opcode - uint8_t(Instruction::LOG0);
+				u256 offset = pop();
+				u256 size = pop();
+				useGas(GasCosts::logGas + GasCosts::logTopicGas * topics + GasCosts::logDataGas * bigint(size));
+				LogEntry entry;
+				entry.address = m_message.recipient;
+				for (unsigned i = 0; i < topics; ++i)
+					entry.topics.emplace_back(pop());
+				entry.data = readMemory(offset, size);
+				m_host.log(std::move(entry));
+				break;
+			}
+			case Instruction::CREATE:
+			case Instruction::CREATE2:
+				create(instruction);
+				break;
+			case Instruction::CALL:
+			case Instruction::CALLCODE:
+			case Instruction::DELEGATECALL:
+			case Instruction::STATICCALL:
+				call(instruction);
+				break;
+			case Instruction::RETURN:
+			case Instruction::REVERT:
+			{
+				u256 offset = pop();
+				u256 size = pop();
+				bytes output = readMemory(offset, size);
+				return Result{
+					instruction == Instruction::RETURN ? Status::Success : Status::Revert,
+					m_gas,
+					std::move(output)
+				};
+			}
+			case Instruction::SELFDESTRUCT:
+				selfdestruct();
+				return Result{Status::Success, m_gas, {}};
+			default:
+				if (opcode >= uint8_t(Instruction::PUSH1) && opcode <= uint8_t(Instruction::PUSH32))
+				{
+					size_t length = opcode - uint8_t(Instruction::PUSH1) + 1;
+					u256 value;
+					for (size_t i = 1; i <= length; ++i)
+						value = (value << 8) | (m_pc + i < m_code.size() ? m_code[m_pc + i] : 0);
+					push(std::move(value));
+					nextPC += length;
+				}
+				else if (opcode >= uint8_t(Instruction::DUP1) && opcode <= uint8_t(Instruction::DUP16))
+					push(top(opcode - uint8_t(Instruction::DUP1)));
+				else if (opcode >= uint8_t(Instruction::SWAP1) && opcode <= uint8_t(Instruction::SWAP16))
+					swap(top(), top(opcode - uint8_t(Instruction::SWAP1) + 1));
+				else
+					// INVALID and the instructions that are not executable.
+					throw ExceptionalHalt();
+			}
+			m_pc = nextPC;
+		}
+		return Result{Status::Success, m_gas, {}};
+	}
+	catch (ExceptionalHalt const&)
+	{
+		return Result{Status::Failure, 0, {}};
+	}
+}
+
+EVMHost::EVMHost(EVMVersion _evmVersion):
+	m_evmVersion(_evmVersion),
+	m_blockTimestamps{0},
+	m_nextTimestamp(c_initialTimestamp),
+	m_coinbase(Address("0x0000000000000010000000000000000000000000"))
+{
+	account(0);
+	// The precompiled contracts are not empty, so that calling them never creates an account.
+	for (unsigned i = 1; i <= 8; ++i)
+		m_accounts[Address(u160(i))].balance = 1;
+}
+
+Address EVMHost::account(size_t _i)
+{
+	// Like the accounts of the RPC test client, every account is funded when it is created.
+	while (m_accountAddresses.size() <= _i)
+	{
+		m_accountAddresses.emplace_back(
+			keccak256("account" + to_string(m_accountAddresses.size())),
+			Address::AlignRight
+		);
+		m_accounts[m_accountAddresses.back()].balance = c_initialBalance;
+	}
+	return m_accountAddresses[_i];
+}
+
+EVMHost::TransactionResult EVMHost::transact(
+	Address const& _from,
+	boost::optional<Address> const& _to,
+	bytes const& _data,
+	u256 const& _value,
+	u256 const& _gas,
+	u256 const& _gasPrice
+)
+{
+	mineBlock();
+	m_origin = _from;
+	m_gasPrice = _gasPrice;
+	m_refund = 0;
+	m_logs.clear();
+	m_destructed.clear();
+	m_originalStorage.clear();
+
+	int64_t intrinsicGas = _to ? GasCosts::txGas : GasCosts::txCreateGas;
+	for (uint8_t byte: _data)
+		intrinsicGas += byte ? GasCosts::txDataNonZeroGas : GasCosts::txDataZeroGas;
+	bigint upfrontCosts = bigint(_gas) * _gasPrice + _value;
+	solAssert(_gas >= intrinsicGas && _gas <= m_gasLimit, "Invalid transaction gas.");
+	solAssert(balance(_from) >= upfrontCosts, "Sender cannot pay for the transaction.");
+	setBalance(_from, balance(_from) - _gas * _gasPrice);
+
+	Message message;
+	message.sender = _from;
+	message.value = message.apparentValue = _value;
+	message.gas = int64_t(_gas) - intrinsicGas;
+	Result result;
+	if (_to)
+	{
+		incrementNonce(_from);
+		message.codeAddress = message.recipient = *_to;
+		message.input = &_data;
+		result = call(message);
+	}
+	else
+	{
+		message.kind = CallKind::Create;
+		result = create(message, _data);
+	}
+
+	int64_t gasUsed = int64_t(_gas) - result.gasLeft;
+	gasUsed -= min(m_refund, gasUsed / 2);
+	setBalance(_from, balance(_from) + (_gas - gasUsed) * _gasPrice);
+	touch(m_coinbase);
+	setBalance(m_coinbase, balance(m_coinbase) + gasUsed * _gasPrice);
+
+	for (Address const& address: m_destructed)
+		m_accounts.erase(address);
+	if (m_evmVersion >= EVMVersion::spuriousDragon())
+		for (auto it = m_accounts.begin(); it != m_accounts.end();)
+			if (isDead(it->first))
+				it = m_accounts.erase(it);
+			else
+				++it;
+	m_journal.clear();
+
+	TransactionResult transactionResult;
+	transactionResult.success = result.status == Status::Success;
+	transactionResult.output = std::move(result.output);
+	transactionResult.gasUsed = gasUsed;
+	transactionResult.logs = std::move(m_logs);
+	transactionResult.createdAddress = result.createdAddress;
+	return transactionResult;
+}
+
+void EVMHost::mineBlocks(unsigned _number)
+{
+	for (unsigned i = 0; i < _number; ++i)
+		mineBlock();
+}
+
+u256 EVMHost::blockTimestamp(u256 const& _number) const
+{
+	return _number < m_blockTimestamps.size() ? m_blockTimestamps[size_t(_number)] : 0;
+}
+
+h256 EVMHost::blockHash(u256 const& _number) const
+{
+	return keccak256(toBigEndian(_number));
+}
+
+u256 EVMHost::balance(Address const& _address) const
+{
+	auto it = m_accounts.find(_address);
+	return it == m_accounts.end() ? 0 : it->second.balance;
+}
+
+bytes const& EVMHost::code(Address const& _address) const
+{
+	static bytes const empty;
+	auto it = m_accounts.find(_address);
+	return it == m_accounts.end() ? empty : it->second.code;
+}
+
+bool EVMHost::storageEmpty(Address const& _address) const
+{
+	auto it = m_accounts.find(_address);
+	return it == m_accounts.end() || it->second.storage.empty();
+}
+
+EVMHost::Result EVMHost::call(Message const& _message)
+{
+	size_t const snapshot = checkpoint();
+	if (!exists(_message.recipient) && (_message.value != 0 || m_evmVersion < EVMVersion::spuriousDragon()))
+		touch(_message.recipient);
+	if (_message.kind == CallKind::Call && _message.value != 0)
+	{
+		setBalance(_message.sender, balance(_message.sender) - _message.value);
+		setBalance(_message.recipient, balance(_message.recipient) + _message.value);
+	}
+
+	Result result;
+	if (unsigned precompiled = precompiledContract(_message.codeAddress, m_evmVersion))
+	{
+		bytesConstRef input(_message.input);
+		bigint gas = precompiledContractGas(precompiled, input);
+		boost::optional<bytes> output;
+		if (gas <= _message.gas)
+			output = runPrecompiledContract(precompiled, input);
+		if (output)
+		{
+			result.status = Status::Success;
+			result.gasLeft = _message.gas - int64_t(gas);
+			result.output = std::move(*output);
+		}
+	}
+	else
+		result = execute(_message, code(_message.codeAddress));
+
+	if (result.status != Status::Success)
+		revertTo(snapshot);
+	return result;
+}
+
+EVMHost::Result EVMHost::create(Message _message, bytes const& _initCode)
+{
+	Address address = _message.kind == CallKind::Create ?
+		createAddress(_message.sender, m_accounts.at(_message.sender).nonce) :
+		create2Address(_message.sender, _message.salt, _initCode);
+	incrementNonce(_message.sender);
+
+	Result result;
+	result.createdAddress = address;
+	if (!code(address).empty() || (exists(address) && m_accounts.at(address).nonce != 0))
+		return result;
+
+	size_t const snapshot = checkpoint();
+	touch(address);
+	if (m_evmVersion >= EVMVersion::spuriousDragon())
+		incrementNonce(address);
+	setBalance(_message.sender, balance(_message.sender) - _message.value);
+	setBalance(address, balance(address) + _message.value);
+
+	static bytes const emptyInput;
+	_message.codeAddress = _message.recipient = address;
+	_message.input = &emptyInput;
+	Result execution = execute(_message, _initCode);
+	result.status = execution.status;
+	result.gasLeft = execution.gasLeft;
+	if (execution.status == Status::Revert)
+		result.output = std::move(execution.output);
+	else if (execution.status == Status::Success)
+	{
+		bytes& deployedCode = execution.output;
+		int64_t depositCost = GasCosts::createDataGas * int64_t(deployedCode.size());
+		if (
+			depositCost > result.gasLeft ||
+			(m_evmVersion >= EVMVersion::spuriousDragon() && deployedCode.size() > c_maxCodeSize)
+		)
+		{
+			result.status = Status::Failure;
+			result.gasLeft = 0;
+		}
+		else
+		{
+			result.gasLeft -= depositCost;
+			m_accounts.at(address).code = std::move(deployedCode);
+			m_journal.emplace_back([this, address]() { m_accounts.at(address).code.clear(); });
+		}
+	}
+
+	if (result.status != Status::Success)
+		revertTo(snapshot);
+	return result;
+}
+
+EVMHost::Result EVMHost::execute(Message const& _message, bytes const& _code)
+{
+	if (_code.empty())
+		return Result{Status::Success, _message.gas, {}};
+	return Frame(*this, _message, _code).run();
+}
+
+bool EVMHost::isDead(Address const& _address) const
+{
+	auto it = m_accounts.find(_address);
+	return
+		it == m_accounts.end() ||
+		(it->second.balance == 0 && it->second.nonce == 0 && it->second.code.empty());
+}
+
+EVMHost::Account& EVMHost::touch(Address const& _address)
+{
+	auto it = m_accounts.find(_address);
+	if (it == m_accounts.end())
+	{
+		it = m_accounts.emplace(_address, Account{}).first;
+		m_journal.emplace_back([this, _address]() { m_accounts.erase(_address); });
+	}
+	return it->second;
+}
+
+void EVMHost::setBalance(Address const& _address, u256 const& _balance)
+{
+	Account& account = touch(_address);
+	m_journal.emplace_back([this, _address, previous = account.balance]() {
+		m_accounts.at(_address).balance = previous;
+	});
+	account.balance = _balance;
+}
+
+void EVMHost::incrementNonce(Address const& _address)
+{
+	++touch(_address).nonce;
+	m_journal.emplace_back([this, _address]() { --m_accounts.at(_address).nonce; });
+}
+
+void EVMHost::setStorage(Address const& _address, u256 const& _key, u256 const& _value)
+{
+	auto& storage = touch(_address).storage;
+	u256 previous = storageAt(_address, _key);
+	m_originalStorage.emplace(make_pair(_address, _key), previous);
+	auto restore = [](map<u256, u256>& _storage, u256 const& _key, u256 const& _value) {
+		if (_value == 0)
+			_storage.erase(_key);
+		else
+			_storage[_key] = _value;
+	};
+	m_journal.emplace_back([=]() { restore(m_accounts.at(_address).storage, _key, previous); });
+	restore(storage, _key, _value);
+}
+
+u256 EVMHost::storageAt(Address const& _address, u256 const& _key) const
+{
+	auto account = m_accounts.find(_address);
+	if (account == m_accounts.end())
+		return 0;
+	auto slot = account->second.storage.find(_key);
+	return slot == account->second.storage.end() ? 0 : slot->second;
+}
+
+u256 EVMHost::originalStorageAt(Address const& _address, u256 const& _key) const
+{
+	auto it = m_originalStorage.find(make_pair(_address, _key));
+	return it == m_originalStorage.end() ? storageAt(_address, _key) : it->second;
+}
+
+void EVMHost::addRefund(int64_t _amount)
+{
+	m_refund += _amount;
+	m_journal.emplace_back([this, _amount]() { m_refund -= _amount; });
+}
+
+void EVMHost::selfdestruct(Address const& _address, Address const& _beneficiary)
+{
+	u256 value = balance(_address);
+	touch(_beneficiary);
+	setBalance(_beneficiary, balance(_beneficiary) + value);
+	setBalance(_address, 0);
+	if (m_destructed.insert(_address).second)
+		m_journal.emplace_back([this, _address]() { m_destructed.erase(_address); });
+}
+
+void EVMHost::log(LogEntry _entry)
+{
+	m_logs.emplace_back(std::move(_entry));
+	m_journal.emplace_back([this]() { m_logs.pop_back(); });
+}
+
+void EVMHost::revertTo(size_t _checkpoint)
+{
+	while (m_journal.size() > _checkpoint)
+	{
+		m_journal.back()();
+		m_journal.pop_back();
+	}
+}
+
+void EVMHost::mineBlock()
+{
+	m_blockTimestamps.push_back(m_nextTimestamp);
+	m_nextTimestamp += 1;
+}
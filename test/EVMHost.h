@@ -0,0 +1,193 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * In-process EVM that executes the transactions of the tests without an external client.
+ */
+
+#pragma once
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+#include <functional>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace dev
+{
+namespace test
+{
+
+using Address = h160;
+
+/**
+ * Blockchain with a single participant that executes every transaction in a block of its
+ * own, like the test client the ExecutionFramework talks to via RPC.
+ *
+ * The gas costs and the semantics of the instructions and precompiled contracts follow the
+ * given EVM version.
+ */
+class EVMHost: private boost::noncopyable
+{
+public:
+	struct LogEntry
+	{
+		Address address;
+		std::vector<h256> topics;
+		bytes data;
+	};
+
+	struct TransactionResult
+	{
+		bool success = false;
+		/// The return data of a call or the revert data of a failed transaction.
+		bytes output;
+		u256 gasUsed;
+		std::vector<LogEntry> logs;
+		/// Address of the created contract, also set if the creation failed.
+		Address createdAddress;
+	};
+
+	explicit EVMHost(langutil::EVMVersion _evmVersion);
+
+	/// @returns the address of the @a _i th account, which is funded when it is first requested.
+	Address account(size_t _i);
+
+	/// Executes a transaction in a new block. Creates a contract if @a _to is not set.
+	TransactionResult transact(
+		Address const& _from,
+		boost::optional<Address> const& _to,
+		bytes const& _data,
+		u256 const& _value,
+		u256 const& _gas,
+		u256 const& _gasPrice
+	);
+
+	/// Adds @a _number empty blocks.
+	void mineBlocks(unsigned _number);
+	/// Sets the timestamp of the next block. The blocks after it follow one second apart.
+	void setNextBlockTimestamp(u256 const& _timestamp) { m_nextTimestamp = _timestamp; }
+	/// Sets the beneficiary of the following blocks.
+	void setCoinbase(Address const& _coinbase) { m_coinbase = _coinbase; }
+
+	u256 blockNumber() const { return m_blockTimestamps.size() - 1; }
+	u256 blockTimestamp(u256 const& _number) const;
+	h256 blockHash(u256 const& _number) const;
+	u256 gasLimit() const { return m_gasLimit; }
+
+	u256 balance(Address const& _address) const;
+	bytes const& code(Address const& _address) const;
+	bool storageEmpty(Address const& _address) const;
+
+private:
+	struct Account
+	{
+		u256 balance;
+		u256 nonce;
+		bytes code;
+		std::map<u256, u256> storage;
+	};
+
+	enum class CallKind { Call, CallCode, DelegateCall, StaticCall, Create, Create2 };
+
+	struct Message
+	{
+		CallKind kind = CallKind::Call;
+		/// Account whose code is executed; the created account for creations.
+		Address codeAddress;
+		/// Account whose storage and balance are used.
+		Address recipient;
+		Address sender;
+		u256 value;
+		/// Value reported by CALLVALUE, differs from value for delegate calls.
+		u256 apparentValue;
+		bytes const* input = nullptr;
+		int64_t gas = 0;
+		unsigned depth = 0;
+		bool isStatic = false;
+		u256 salt;
+	};
+
+	enum class Status { Success, Revert, Failure };
+
+	struct Result
+	{
+		Status status = Status::Failure;
+		int64_t gasLeft = 0;
+		bytes output;
+		Address createdAddress = Address();
+	};
+
+	class Frame;
+	friend class Frame;
+
+	/// Executes a call or creation, including value transfer and state reversion on failure.
+	Result call(Message const& _message);
+	Result create(Message _message, bytes const& _initCode);
+	Result execute(Message const& _message, bytes const& _code);
+
+	bool exists(Address const& _address) const { return m_accounts.count(_address); }
+	/// @returns true if the account does not exist or is empty in the sense of EIP-161.
+	bool isDead(Address const& _address) const;
+	Account& touch(Address const& _address);
+	void setBalance(Address const& _address, u256 const& _balance);
+	void incrementNonce(Address const& _address);
+	void setStorage(Address const& _address, u256 const& _key, u256 const& _value);
+	u256 storageAt(Address const& _address, u256 const& _key) const;
+	/// @returns the value the storage slot had at the beginning of the transaction.
+	u256 originalStorageAt(Address const& _address, u256 const& _key) const;
+	void addRefund(int64_t _amount);
+	void selfdestruct(Address const& _address, Address const& _beneficiary);
+	void log(LogEntry _entry);
+
+	/// Changes to the state are recorded as functions undoing them, so that calls can
+	/// be reverted without copying the state.
+	size_t checkpoint() const { return m_journal.size(); }
+	void revertTo(size_t _checkpoint);
+
+	void mineBlock();
+
+	langutil::EVMVersion m_evmVersion;
+	std::map<Address, Account> m_accounts;
+	std::vector<std::function<void()>> m_journal;
+
+	/// Transaction state.
+	Address m_origin;
+	u256 m_gasPrice;
+	int64_t m_refund = 0;
+	std::vector<LogEntry> m_logs;
+	std::set<Address> m_destructed;
+	std::map<std::pair<Address, u256>, u256> m_originalStorage;
+
+	/// Block state.
+	std::vector<u256> m_blockTimestamps;
+	u256 m_nextTimestamp;
+	Address m_coinbase;
+	u256 const m_gasLimit = u256("0x1000000000000");
+	u256 const m_difficulty = 131072;
+
+	std::vector<Address> m_accountAddresses;
+};
+
+}
+}
@@ -0,0 +1,641 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Precompiled contracts of the in-process EVM.
+ */
+
+#include <test/EVMPrecompiles.h>
+
+#include <libdevcore/Keccak256.h>
+
+#include <array>
+
+using namespace std;
+using namespace dev;
+using namespace dev::test;
+using namespace langutil;
+
+namespace
+{
+
+uint32_t rotateLeft(uint32_t _x, unsigned _n) { return (_x << _n) | (_x >> (32 - _n)); }
+uint32_t rotateRight(uint32_t _x, unsigned _n) { return (_x >> _n) | (_x << (32 - _n)); }
+
+/// @returns @a _input padded as required by SHA-256 and RIPEMD-160, which only differ in the
+/// byte order of the length.
+bytes padMessage(bytesConstRef _input, bool _bigEndian)
+{
+	bytes message = _input.toBytes();
+	uint64_t const bitLength = uint64_t(_input.size()) * 8;
+	message.push_back(0x80);
+	while (message.size() % 64 != 56)
+		message.push_back(0);
+	for (unsigned i = 0; i < 8; ++i)
+		message.push_back(uint8_t(bitLength >> (_bigEndian ? 56 - 8 * i : 8 * i)));
+	return message;
+}
+
+bytes sha256(bytesConstRef _input)
+{
+	static uint32_t const c_k[64] = {
+		0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+		0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+		0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+		0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+		0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+		0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+		0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+		0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+	};
+	uint32_t h[8] = {
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+	};
+	bytes const message = padMessage(_input, true);
+	for (size_t chunk = 0; chunk < message.size(); chunk += 64)
+	{
+		uint32_t w[64];
+		for (unsigned i = 0; i < 16; ++i)
+			w[i] =
+				(uint32_t(message[chunk + 4 * i]) << 24) |
+				(uint32_t(message[chunk + 4 * i + 1]) << 16) |
+				(uint32_t(message[chunk + 4 * i + 2]) << 8) |
+				uint32_t(message[chunk + 4 * i + 3]);
+		for (unsigned i = 16; i < 64; ++i)
+		{
+			uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+		uint32_t a[8];
+		copy(h, h + 8, a);
+		for (unsigned i = 0; i < 64; ++i)
+		{
+			uint32_t s1 = rotateRight(a[4], 6) ^ rotateRight(a[4], 11) ^ rotateRight(a[4], 25);
+			uint32_t choice = (a[4] & a[5]) ^ (~a[4] & a[6]);
+			uint32_t t1 = a[7] + s1 + choice + c_k[i] + w[i];
+			uint32_t s0 = rotateRight(a[0], 2) ^ rotateRight(a[0], 13) ^ rotateRight(a[0], 22);
+			uint32_t majority = (a[0] & a[1]) ^ (a[0] & a[2]) ^ (a[1] & a[2]);
+			uint32_t t2 = s0 + majority;
+			copy_backward(a, a + 7, a + 8);
+			a[4] += t1;
+			a[0] = t1 + t2;
+		}
+		for (unsigned i = 0; i < 8; ++i)
+			h[i] += a[i];
+	}
+	bytes result;
+	for (uint32_t word: h)
+		for (unsigned i = 0; i < 4; ++i)
+			result.push_back(uint8_t(word >> (24 - 8 * i)));
+	return result;
+}
+
+bytes ripemd160(bytesConstRef _input)
+{
+	static unsigned const c_wordLeft[80] = {
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+		7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+		3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+		1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+		4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13
+	};
+	static unsigned const c_wordRight[80] = {
+		5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+		6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+		15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+		8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+		12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11
+	};
+	static unsigned const c_shiftLeft[80] = {
+		11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+		7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+		11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+		11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+		9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6
+	};
+	static unsigned const c_shiftRight[80] = {
+		8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+		9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+		9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+		15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+		8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11
+	};
+	static uint32_t const c_constantLeft[5] = {0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e};
+	static uint32_t const c_constantRight[5] = {0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000};
+	auto f = [](unsigned _round, uint32_t _x, uint32_t _y, uint32_t _z) -> uint32_t {
+		switch (_round)
+		{
+		case 0: return _x ^ _y ^ _z;
+		case 1: return (_x & _y) | (~_x & _z);
+		case 2: return (_x | ~_y) ^ _z;
+		case 3: return (_x & _z) | (_y & ~_z);
+		default: return _x ^ (_y | ~_z);
+		}
+	};
+
+	uint32_t h[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+	bytes const message = padMessage(_input, false);
+	for (size_t chunk = 0; chunk < message.size(); chunk += 64)
+	{
+		uint32_t x[16];
+		for (unsigned i = 0; i < 16; ++i)
+			x[i] =
+				uint32_t(message[chunk + 4 * i]) |
+				(uint32_t(message[chunk + 4 * i + 1]) << 8) |
+				(uint32_t(message[chunk + 4 * i + 2]) << 16) |
+				(uint32_t(message[chunk + 4 * i + 3]) << 24);
+		uint32_t left[5];
+		uint32_t right[5];
+		copy(h, h + 5, left);
+		copy(h, h + 5, right);
+		for (unsigned j = 0; j < 80; ++j)
+		{
+			unsigned round = j / 16;
+			uint32_t t = rotateLeft(
+				left[0] + f(round, left[1], left[2], left[3]) + x[c_wordLeft[j]] + c_constantLeft[round],
+				c_shiftLeft[j]
+			) + left[4];
+			left[0] = left[4];
+			left[4] = left[3];
+			left[3] = rotateLeft(left[2], 10);
+			left[2] = left[1];
+			left[1] = t;
+			t = rotateLeft(
+				right[0] + f(4 - round, right[1], right[2], right[3]) + x[c_wordRight[j]] + c_constantRight[round],
+				c_shiftRight[j]
+			) + right[4];
+			right[0] = right[4];
+			right[4] = right[3];
+			right[3] = rotateLeft(right[2], 10);
+			right[2] = right[1];
+			right[1] = t;
+		}
+		uint32_t t = h[1] + left[2] + right[3];
+		h[1] = h[2] + left[3] + right[4];
+		h[2] = h[3] + left[4] + right[0];
+		h[3] = h[4] + left[0] + right[1];
+		h[4] = h[0] + left[1] + right[2];
+		h[0] = t;
+	}
+	bytes result(12, 0);
+	for (uint32_t word: h)
+		for (unsigned i = 0; i < 4; ++i)
+			result.push_back(uint8_t(word >> (8 * i)));
+	return result;
+}
+
+/// @returns @a _length bytes of @a _input starting at @a _offset, padded with zeros.
+bytes paddedSlice(bytesConstRef _input, bigint const& _offset, size_t _length)
+{
+	bytes result(_length, 0);
+	if (_offset < _input.size())
+	{
+		size_t offset = size_t(_offset);
+		copy_n(_input.begin() + offset, min(_length, _input.size() - offset), result.begin());
+	}
+	return result;
+}
+
+bytes toBytes(bigint const& _value, size_t _length)
+{
+	bytes result(_length, 0);
+	toBigEndian(_value, result);
+	return result;
+}
+
+bigint readNumber(bytesConstRef _input, bigint const& _offset, size_t _length = 32)
+{
+	return fromBigEndian<bigint>(paddedSlice(_input, _offset, _length));
+}
+
+bigint modExpGas(bytesConstRef _input)
+{
+	bigint baseLength = readNumber(_input, 0);
+	bigint exponentLength = readNumber(_input, 32);
+	bigint modulusLength = readNumber(_input, 64);
+
+	bigint exponentHead = readNumber(_input, 96 + baseLength, size_t(min<bigint>(exponentLength, 32)));
+	bigint adjustedExponentLength = exponentLength > 32 ? 8 * (exponentLength - 32) : bigint(0);
+	if (exponentHead != 0)
+		adjustedExponentLength += msb(exponentHead);
+
+	bigint x = max(baseLength, modulusLength);
+	bigint multiplicationComplexity;
+	if (x <= 64)
+		multiplicationComplexity = x * x;
+	else if (x <= 1024)
+		multiplicationComplexity = x * x / 4 + 96 * x - 3072;
+	else
+		multiplicationComplexity = x * x / 16 + 480 * x - 199680;
+	return multiplicationComplexity * max<bigint>(adjustedExponentLength, 1) / 20;
+}
+
+bytes modExp(bytesConstRef _input)
+{
+	size_t baseLength = size_t(readNumber(_input, 0));
+	bigint exponentLength = readNumber(_input, 32);
+	size_t modulusLength = size_t(readNumber(_input, 64));
+	if (modulusLength == 0)
+		return {};
+
+	bigint base = readNumber(_input, 96, baseLength);
+	bigint exponent = readNumber(_input, 96 + baseLength, size_t(exponentLength));
+	bigint modulus = readNumber(_input, 96 + baseLength + exponentLength, modulusLength);
+	bigint result = modulus == 0 ? bigint(0) : bigint(boost::multiprecision::powm(base, exponent, modulus));
+	return toBytes(result, modulusLength);
+}
+
+/// Point on a curve y^2 = x^3 + b over a prime field, with zero coordinates denoting the
+/// point at infinity.
+struct Point
+{
+	bigint x;
+	bigint y;
+	bool isInfinity() const { return x == 0 && y == 0; }
+};
+
+struct Curve
+{
+	bigint p;
+	bigint b;
+
+	bigint mod(bigint const& _a) const { bigint r = _a % p; return r < 0 ? r + p : r; }
+	bigint inverse(bigint const& _a) const { return boost::multiprecision::powm(mod(_a), p - 2, p); }
+
+	bool contains(Point const& _point) const
+	{
+		if (_point.x >= p || _point.y >= p)
+			return false;
+		return _point.isInfinity() || mod(_point.y * _point.y) == mod(_point.x * _point.x * _point.x + b);
+	}
+
+	Point add(Point const& _a, Point const& _b) const
+	{
+		if (_a.isInfinity())
+			return _b;
+		if (_b.isInfinity())
+			return _a;
+		bigint lambda;
+		if (_a.x == _b.x)
+		{
+			if (mod(_a.y + _b.y) == 0)
+				return {};
+			lambda = mod(3 * _a.x * _a.x * inverse(2 * _a.y));
+		}
+		else
+			lambda = mod((_b.y - _a.y) * inverse(_b.x - _a.x));
+		bigint x = mod(lambda * lambda - _a.x - _b.x);
+		return {x, mod(lambda * (_a.x - x) - _a.y)};
+	}
+
+	Point multiply(Point const& _point, bigint const& _scalar) const
+	{
+		Point result;
+		for (int i = _scalar == 0 ? -1 : int(msb(_scalar)); i >= 0; --i)
+		{
+			result = add(result, result);
+			if (bit_test(_scalar, unsigned(i)))
+				result = add(result, _point);
+		}
+		return result;
+	}
+};
+
+boost::optional<bytes> ecrecover(bytesConstRef _input)
+{
+	static Curve const secp256k1{
+		bigint("0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f"),
+		7
+	};
+	static bigint const order("0xfffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141");
+	static Point const generator{
+		bigint("0x79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"),
+		bigint("0x483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8")
+	};
+
+	bigint hash = readNumber(_input, 0);
+	bigint v = readNumber(_input, 32);
+	bigint r = readNumber(_input, 64);
+	bigint s = readNumber(_input, 96);
+	if ((v != 27 && v != 28) || r == 0 || r >= order || s == 0 || s >= order)
+		return bytes{};
+
+	bigint ySquared = secp256k1.mod(r * r * r + secp256k1.b);
+	bigint y = boost::multiprecision::powm(ySquared, (secp256k1.p + 1) / 4, secp256k1.p);
+	if (secp256k1.mod(y * y) != ySquared)
+		return bytes{};
+	if (bit_test(y, 0) != (v == 28))
+		y = secp256k1.p - y;
+
+	bigint rInverse = boost::multiprecision::powm(r, order - 2, order);
+	bigint u1 = (order - hash % order) * rInverse % order;
+	bigint u2 = s * rInverse % order;
+	Point publicKey = secp256k1.add(secp256k1.multiply(generator, u1), secp256k1.multiply(Point{r, y}, u2));
+	if (publicKey.isInfinity())
+		return bytes{};
+	h256 publicKeyHash = keccak256(toBytes(publicKey.x, 32) + toBytes(publicKey.y, 32));
+	return bytes(12, 0) + h160(publicKeyHash, h160::AlignRight).asBytes();
+}
+
+Curve const& altBN128()
+{
+	static Curve const curve{
+		bigint("0x30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47"),
+		3
+	};
+	return curve;
+}
+
+boost::optional<bytes> bn128Add(bytesConstRef _input)
+{
+	Point a{readNumber(_input, 0), readNumber(_input, 32)};
+	Point b{readNumber(_input, 64), readNumber(_input, 96)};
+	if (!altBN128().contains(a) || !altBN128().contains(b))
+		return boost::none;
+	Point sum = altBN128().add(a, b);
+	return toBytes(sum.x, 32) + toBytes(sum.y, 32);
+}
+
+boost::optional<bytes> bn128Multiply(bytesConstRef _input)
+{
+	Point a{readNumber(_input, 0), readNumber(_input, 32)};
+	if (!altBN128().contains(a))
+		return boost::none;
+	Point product = altBN128().multiply(a, readNumber(_input, 64));
+	return toBytes(product.x, 32) + toBytes(product.y, 32);
+}
+
+/// Element a + b * i of the quadratic extension of the alt_bn128 field, with i^2 = -1.
+struct Fp2
+{
+	bigint a;
+	bigint b;
+
+	static bigint mod(bigint const& _x) { return altBN128().mod(_x); }
+
+	Fp2 operator+(Fp2 const& _other) const { return {mod(a + _other.a), mod(b + _other.b)}; }
+	Fp2 operator-(Fp2 const& _other) const { return {mod(a - _other.a), mod(b - _other.b)}; }
+	Fp2 operator*(Fp2 const& _other) const
+	{
+		return {mod(a * _other.a - b * _other.b), mod(a * _other.b + b * _other.a)};
+	}
+	Fp2 operator*(bigint const& _factor) const { return {mod(a * _factor), mod(b * _factor)}; }
+	bool operator==(Fp2 const& _other) const { return a == _other.a && b == _other.b; }
+	bool operator!=(Fp2 const& _other) const { return !(*this == _other); }
+
+	Fp2 conjugate() const { return {a, mod(-b)}; }
+	Fp2 inverse() const
+	{
+		bigint normInverse = altBN128().inverse(a * a + b * b);
+		return {mod(a * normInverse), mod(-b * normInverse)};
+	}
+	Fp2 power(bigint const& _exponent) const
+	{
+		Fp2 result{1, 0};
+		for (int i = _exponent == 0 ? -1 : int(msb(_exponent)); i >= 0; --i)
+		{
+			result = result * result;
+			if (bit_test(_exponent, unsigned(i)))
+				result = result * *this;
+		}
+		return result;
+	}
+};
+
+/// Point on the twist y^2 = x^3 + 3 / (9 + i) over Fp2.
+struct TwistPoint
+{
+	Fp2 x;
+	Fp2 y;
+	bool infinity = false;
+};
+
+Fp2 const& twistB()
+{
+	static Fp2 const b = Fp2{9, 1}.inverse() * bigint(3);
+	return b;
+}
+
+TwistPoint twistAdd(TwistPoint const& _a, TwistPoint const& _b)
+{
+	if (_a.infinity)
+		return _b;
+	if (_b.infinity)
+		return _a;
+	Fp2 lambda;
+	if (_a.x == _b.x)
+	{
+		if (_a.y != _b.y || _a.y == Fp2{})
+			return TwistPoint{{}, {}, true};
+		lambda = _a.x * _a.x * bigint(3) * (_a.y * bigint(2)).inverse();
+	}
+	else
+		lambda = (_b.y - _a.y) * (_b.x - _a.x).inverse();
+	Fp2 x = lambda * lambda - _a.x - _b.x;
+	return TwistPoint{x, lambda * (_a.x - x) - _a.y};
+}
+
+/// Element of the degree twelve extension of the alt_bn128 field, represented as polynomial
+/// in w with w^12 = 18 * w^6 - 82. Elements a + b * i of Fp2 embed as (a - 9 * b) + b * w^6.
+struct Fp12
+{
+	std::array<bigint, 12> coefficients;
+
+	static Fp12 one()
+	{
+		Fp12 result;
+		result.coefficients[0] = 1;
+		return result;
+	}
+	/// Adds @a _value * w^@a _power.
+	void add(Fp2 const& _value, unsigned _power)
+	{
+		coefficients[_power] = Fp2::mod(coefficients[_power] + _value.a - 9 * _value.b);
+		coefficients[_power + 6] = Fp2::mod(coefficients[_power + 6] + _value.b);
+	}
+
+	Fp12 operator*(Fp12 const& _other) const
+	{
+		std::array<bigint, 23> product;
+		for (unsigned i = 0; i < 12; ++i)
+			if (coefficients[i] != 0)
+				for (unsigned j = 0; j < 12; ++j)
+					product[i + j] += coefficients[i] * _other.coefficients[j];
+		for (unsigned i = 22; i >= 12; --i)
+		{
+			product[i - 6] += 18 * product[i];
+			product[i - 12] -= 82 * product[i];
+		}
+		Fp12 result;
+		for (unsigned i = 0; i < 12; ++i)
+			result.coefficients[i] = Fp2::mod(product[i]);
+		return result;
+	}
+	bool operator==(Fp12 const& _other) const { return coefficients == _other.coefficients; }
+};
+
+/// @returns the line through @a _a and @a _b (or the tangent if they are equal) of the twisted
+/// curve evaluated at the point (@a _x, @a _y) of the curve over the base field.
+Fp12 lineFunction(TwistPoint const& _a, TwistPoint const& _b, bigint const& _x, bigint const& _y)
+{
+	Fp12 result;
+	Fp2 lambda;
+	if (_a.x != _b.x)
+		lambda = (_b.y - _a.y) * (_b.x - _a.x).inverse();
+	else if (_a.y == _b.y)
+		lambda = _a.x * _a.x * bigint(3) * (_a.y * bigint(2)).inverse();
+	else
+	{
+		// Vertical line x - x_a * w^2.
+		result.coefficients[0] = _x;
+		result.add(Fp2{} - _a.x, 2);
+		return result;
+	}
+	// (lambda * w) * (x - x_a * w^2) - (y - y_a * w^3)
+	result.coefficients[0] = Fp2::mod(-_y);
+	result.add(lambda * _x, 1);
+	result.add(_a.y - lambda * _a.x, 3);
+	return result;
+}
+
+/// @returns the twisted point mapped by the Frobenius endomorphism.
+TwistPoint frobenius(TwistPoint const& _point)
+{
+	static bigint const p = altBN128().p;
+	static Fp2 const xFactor = Fp2{9, 1}.power((p - 1) / 3);
+	static Fp2 const yFactor = Fp2{9, 1}.power((p - 1) / 2);
+	return TwistPoint{_point.x.conjugate() * xFactor, _point.y.conjugate() * yFactor};
+}
+
+Fp12 millerLoop(TwistPoint const& _q, Point const& _p)
+{
+	static bigint const ateLoopCount("29793968203157093288");
+	Fp12 f = Fp12::one();
+	TwistPoint r = _q;
+	for (int i = 63; i >= 0; --i)
+	{
+		f = f * f * lineFunction(r, r, _p.x, _p.y);
+		r = twistAdd(r, r);
+		if (bit_test(ateLoopCount, unsigned(i)))
+		{
+			f = f * lineFunction(r, _q, _p.x, _p.y);
+			r = twistAdd(r, _q);
+		}
+	}
+	TwistPoint q1 = frobenius(_q);
+	TwistPoint q2 = frobenius(q1);
+	q2.y = Fp2{} - q2.y;
+	f = f * lineFunction(r, q1, _p.x, _p.y);
+	r = twistAdd(r, q1);
+	return f * lineFunction(r, q2, _p.x, _p.y);
+}
+
+boost::optional<bytes> bn128Pairing(bytesConstRef _input)
+{
+	static bigint const groupOrder("0x30644e72e131a029b85045b68181585d2833e84879b9709143e1f593f0000001");
+	if (_input.size() % 192 != 0)
+		return boost::none;
+	bigint const& p = altBN128().p;
+
+	Fp12 product = Fp12::one();
+	for (size_t offset = 0; offset < _input.size(); offset += 192)
+	{
+		Point a{readNumber(_input, offset), readNumber(_input, offset + 32)};
+		// The imaginary parts come first.
+		TwistPoint b{
+			Fp2{readNumber(_input, offset + 96), readNumber(_input, offset + 64)},
+			Fp2{readNumber(_input, offset + 160), readNumber(_input, offset + 128)}
+		};
+		if (!altBN128().contains(a))
+			return boost::none;
+		if (b.x.a >= p || b.x.b >= p || b.y.a >= p || b.y.b >= p)
+			return boost::none;
+		b.infinity = b.x == Fp2{} && b.y == Fp2{};
+		if (!b.infinity)
+		{
+			if (b.y * b.y != b.x * b.x * b.x + twistB())
+				return boost::none;
+			TwistPoint multiple;
+			multiple.infinity = true;
+			for (int i = int(msb(groupOrder)); i >= 0; --i)
+			{
+				multiple = twistAdd(multiple, multiple);
+				if (bit_test(groupOrder, unsigned(i)))
+					multiple = twistAdd(multiple, b);
+			}
+			if (!multiple.infinity)
+				return boost::none;
+		}
+		if (!a.isInfinity() && !b.infinity)
+			product = product * millerLoop(b, a);
+	}
+
+	static bigint const finalExponent = (boost::multiprecision::pow(p, 12) - 1) / groupOrder;
+	Fp12 result = Fp12::one();
+	for (int i = int(msb(finalExponent)); i >= 0; --i)
+	{
+		result = result * result;
+		if (bit_test(finalExponent, unsigned(i)))
+			result = result * product;
+	}
+	return toBytes(result == Fp12::one() ? 1 : 0, 32);
+}
+
+}
+
+unsigned dev::test::precompiledContract(h160 const& _address, EVMVersion _evmVersion)
+{
+	u160 number = u160(_address);
+	if (number >= 1 && number <= 4)
+		return unsigned(number);
+	if (number >= 5 && number <= 8 && _evmVersion >= EVMVersion::byzantium())
+		return unsigned(number);
+	return 0;
+}
+
+bigint dev::test::precompiledContractGas(unsigned _number, bytesConstRef _input)
+{
+	bigint words = (bigint(_input.size()) + 31) / 32;
+	switch (_number)
+	{
+	case 1: return 3000;
+	case 2: return 60 + 12 * words;
+	case 3: return 600 + 120 * words;
+	case 4: return 15 + 3 * words;
+	case 5: return modExpGas(_input);
+	case 6: return 500;
+	case 7: return 40000;
+	case 8: return 100000 + 80000 * (_input.size() / 192);
+	default: return 0;
+	}
+}
+
+boost::optional<bytes> dev::test::runPrecompiledContract(unsigned _number, bytesConstRef _input)
+{
+	switch (_number)
+	{
+	case 1: return ecrecover(_input);
+	case 2: return sha256(_input);
+	case 3: return ripemd160(_input);
+	case 4: return _input.toBytes();
+	case 5: return modExp(_input);
+	case 6: return bn128Add(_input);
+	case 7: return bn128Multiply(_input);
+	case 8: return bn128Pairing(_input);
+	default: return boost::none;
+	}
+}
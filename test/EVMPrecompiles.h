@@ -0,0 +1,47 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Precompiled contracts of the in-process EVM.
+ */
+
+#pragma once
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+
+#include <boost/optional.hpp>
+
+namespace dev
+{
+namespace test
+{
+
+/// @returns the number of the precompiled contract at @a _address (which is also its address)
+/// or zero if there is none in the given EVM version.
+unsigned precompiledContract(h160 const& _address, langutil::EVMVersion _evmVersion);
+
+/// @returns the gas costs of calling the precompiled contract @a _number with @a _input.
+bigint precompiledContractGas(unsigned _number, bytesConstRef _input);
+
+/// Executes the precompiled contract @a _number.
+/// @returns its output or nothing if the input is invalid, in which case all gas is consumed.
+boost::optional<bytes> runPrecompiledContract(unsigned _number, bytesConstRef _input);
+
+}
+}
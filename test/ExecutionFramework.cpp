@@ -17,7 +17,7 @@
 /**
  * @author Christian <c@ethdev.com>
  * @date 2016
- * Framework for executing contracts and testing them using RPC.
+ * Framework for executing contracts and testing them using RPC or an in-process EVM.
  */
 
 #include <test/ExecutionFramework.h>
@@ -50,18 +50,30 @@ string getIPCSocketPath()
 }
 
 ExecutionFramework::ExecutionFramework():
-	ExecutionFramework(getIPCSocketPath(), dev::test::Options::get().evmVersion())
+	ExecutionFramework(
+		dev::test::Options::get().internalEVM ? string() : getIPCSocketPath(),
+		dev::test::Options::get().evmVersion(),
+		dev::test::Options::get().internalEVM
+	)
 {
 }
 
-ExecutionFramework::ExecutionFramework(string const& _ipcPath, langutil::EVMVersion _evmVersion):
-	m_rpc(RPCSession::instance(_ipcPath)),
+ExecutionFramework::ExecutionFramework(string const& _ipcPath, langutil::EVMVersion _evmVersion, bool _internalEVM):
 	m_evmVersion(_evmVersion),
 	m_optimiserSettings(dev::test::Options::get().optimize ? solidity::OptimiserSettings::standard() : solidity::OptimiserSettings::minimal()),
-	m_showMessages(dev::test::Options::get().showMessages),
-	m_sender(m_rpc.account(0))
+	m_showMessages(dev::test::Options::get().showMessages)
 {
-	m_rpc.test_rewindToBlock(0);
+	if (_internalEVM)
+	{
+		m_evmHost = make_unique<EVMHost>(_evmVersion);
+		m_sender = m_evmHost->account(0);
+	}
+	else
+	{
+		m_rpc = &RPCSession::instance(_ipcPath);
+		m_sender = Address(m_rpc->account(0));
+		m_rpc->test_rewindToBlock(0);
+	}
 }
 
 std::pair<bool, string> ExecutionFramework::compareAndCreateMessage(
@@ -92,18 +104,24 @@ std::pair<bool, string> ExecutionFramework::compareAndCreateMessage(
 
 u256 ExecutionFramework::gasLimit() const
 {
-	auto latestBlock = m_rpc.eth_getBlockByNumber("latest", false);
+	if (m_evmHost)
+		return m_evmHost->gasLimit();
+	auto latestBlock = m_rpc->eth_getBlockByNumber("latest", false);
 	return u256(latestBlock["gasLimit"].asString());
 }
 
 u256 ExecutionFramework::gasPrice() const
 {
-	return u256(m_rpc.eth_gasPrice());
+	if (m_evmHost)
+		return m_gasPrice;
+	return u256(m_rpc->eth_gasPrice());
 }
 
 u256 ExecutionFramework::blockHash(u256 const& _blockNumber) const
 {
-	return u256(m_rpc.eth_getBlockByNumber(toHex(_blockNumber, HexPrefix::Add), false)["hash"].asString());
+	if (m_evmHost)
+		return u256(m_evmHost->blockHash(_blockNumber));
+	return u256(m_rpc->eth_getBlockByNumber(toHex(_blockNumber, HexPrefix::Add), false)["hash"].asString());
 }
 
 void ExecutionFramework::sendMessage(bytes const& _data, bool _isCreation, u256 const& _value)
@@ -118,6 +136,36 @@ void ExecutionFramework::sendMessage(bytes const& _data, bool _isCreation, u256
 			cout << " value: " << _value << endl;
 		cout << " in:      " << toHex(_data) << endl;
 	}
+	if (m_evmHost)
+	{
+		if (!_isCreation)
+			BOOST_REQUIRE(!m_evmHost->code(m_contractAddress).empty());
+		EVMHost::TransactionResult result = m_evmHost->transact(
+			m_sender,
+			_isCreation ? boost::none : boost::make_optional(m_contractAddress),
+			_data,
+			_value,
+			m_gas,
+			m_gasPrice
+		);
+		m_blockNumber = m_evmHost->blockNumber();
+		if (_isCreation)
+		{
+			m_contractAddress = result.createdAddress;
+			m_output = m_evmHost->code(m_contractAddress);
+		}
+		else
+			m_output = std::move(result.output);
+		if (m_showMessages)
+			cout << " out:     " << toHex(m_output) << endl;
+
+		m_gasUsed = result.gasUsed;
+		m_logs.clear();
+		for (auto& log: result.logs)
+			m_logs.push_back(LogEntry{log.address, std::move(log.topics), std::move(log.data)});
+		m_transactionSuccessful = result.success;
+		return;
+	}
 	RPCSession::TransactionData d;
 	d.data = "0x" + toHex(_data);
 	d.from = "0x" + toString(m_sender);
@@ -127,14 +175,14 @@ void ExecutionFramework::sendMessage(bytes const& _data, bool _isCreation, u256
 	if (!_isCreation)
 	{
 		d.to = dev::toString(m_contractAddress);
-		BOOST_REQUIRE(m_rpc.eth_getCode(d.to, "pending").size() > 2);
+		BOOST_REQUIRE(m_rpc->eth_getCode(d.to, "pending").size() > 2);
 		// Use eth_call to get the output
-		m_output = fromHex(m_rpc.eth_call(d, "pending"), WhenError::Throw);
+		m_output = fromHex(m_rpc->eth_call(d, "pending"), WhenError::Throw);
 	}
 
-	string txHash = m_rpc.eth_sendTransaction(d);
-	m_rpc.test_mineBlocks(1);
-	RPCSession::TransactionReceipt receipt(m_rpc.eth_getTransactionReceipt(txHash));
+	string txHash = m_rpc->eth_sendTransaction(d);
+	m_rpc->test_mineBlocks(1);
+	RPCSession::TransactionReceipt receipt(m_rpc->eth_getTransactionReceipt(txHash));
 
 	m_blockNumber = u256(receipt.blockNumber);
 
@@ -142,7 +190,7 @@ void ExecutionFramework::sendMessage(bytes const& _data, bool _isCreation, u256
 	{
 		m_contractAddress = Address(receipt.contractAddress);
 		BOOST_REQUIRE(m_contractAddress);
-		string code = m_rpc.eth_getCode(receipt.contractAddress, "latest");
+		string code = m_rpc->eth_getCode(receipt.contractAddress, "latest");
 		m_output = fromHex(code, WhenError::Throw);
 	}
 
@@ -172,6 +220,11 @@ void ExecutionFramework::sendMessage(bytes const& _data, bool _isCreation, u256
 
 void ExecutionFramework::sendEther(Address const& _to, u256 const& _value)
 {
+	if (m_evmHost)
+	{
+		m_evmHost->transact(m_sender, _to, bytes(), _value, m_gas, m_gasPrice);
+		return;
+	}
 	RPCSession::TransactionData d;
 	d.data = "0x";
 	d.from = "0x" + toString(m_sender);
@@ -180,41 +233,77 @@ void ExecutionFramework::sendEther(Address const& _to, u256 const& _value)
 	d.value = toHex(_value, HexPrefix::Add);
 	d.to = dev::toString(_to);
 
-	string txHash = m_rpc.eth_sendTransaction(d);
-	m_rpc.test_mineBlocks(1);
+	string txHash = m_rpc->eth_sendTransaction(d);
+	m_rpc->test_mineBlocks(1);
 }
 
 size_t ExecutionFramework::currentTimestamp()
 {
-	auto latestBlock = m_rpc.eth_getBlockByNumber("latest", false);
+	if (m_evmHost)
+		return size_t(m_evmHost->blockTimestamp(m_evmHost->blockNumber()));
+	auto latestBlock = m_rpc->eth_getBlockByNumber("latest", false);
 	return size_t(u256(latestBlock.get("timestamp", "invalid").asString()));
 }
 
 size_t ExecutionFramework::blockTimestamp(u256 _number)
 {
-	auto latestBlock = m_rpc.eth_getBlockByNumber(toString(_number), false);
+	if (m_evmHost)
+		return size_t(m_evmHost->blockTimestamp(_number));
+	auto latestBlock = m_rpc->eth_getBlockByNumber(toString(_number), false);
 	return size_t(u256(latestBlock.get("timestamp", "invalid").asString()));
 }
 
+void ExecutionFramework::modifyTimestamp(size_t _timestamp)
+{
+	if (m_evmHost)
+		m_evmHost->setNextBlockTimestamp(_timestamp);
+	else
+		m_rpc->test_modifyTimestamp(_timestamp);
+}
+
+void ExecutionFramework::mineBlocks(unsigned _number)
+{
+	if (m_evmHost)
+		m_evmHost->mineBlocks(_number);
+	else
+		m_rpc->test_mineBlocks(int(_number));
+}
+
+void ExecutionFramework::setCoinbase(Address const& _coinbase)
+{
+	if (m_evmHost)
+		m_evmHost->setCoinbase(_coinbase);
+	else
+		BOOST_REQUIRE(m_rpc->rpcCall("miner_setEtherbase", {"\"0x" + toString(_coinbase) + "\""}).asBool());
+}
+
 Address ExecutionFramework::account(size_t _i)
 {
-	return Address(m_rpc.accountCreateIfNotExists(_i));
+	if (m_evmHost)
+		return m_evmHost->account(_i);
+	return Address(m_rpc->accountCreateIfNotExists(_i));
 }
 
 bool ExecutionFramework::addressHasCode(Address const& _addr)
 {
-	string code = m_rpc.eth_getCode(toString(_addr), "latest");
+	if (m_evmHost)
+		return !m_evmHost->code(_addr).empty();
+	string code = m_rpc->eth_getCode(toString(_addr), "latest");
 	return !code.empty() && code != "0x";
 }
 
 u256 ExecutionFramework::balanceAt(Address const& _addr)
 {
-	return u256(m_rpc.eth_getBalance(toString(_addr), "latest"));
+	if (m_evmHost)
+		return m_evmHost->balance(_addr);
+	return u256(m_rpc->eth_getBalance(toString(_addr), "latest"));
 }
 
 bool ExecutionFramework::storageEmpty(Address const& _addr)
 {
-	h256 root(m_rpc.eth_getStorageRoot(toString(_addr), "latest"));
+	if (m_evmHost)
+		return m_evmHost->storageEmpty(_addr);
+	h256 root(m_rpc->eth_getStorageRoot(toString(_addr), "latest"));
 	BOOST_CHECK(root);
 	return root == EmptyTrie;
 }
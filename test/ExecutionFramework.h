@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <test/EVMHost.h>
 #include <test/Options.h>
 #include <test/RPCSession.h>
 
@@ -33,6 +34,7 @@
 #include <libdevcore/Keccak256.h>
 
 #include <functional>
+#include <memory>
 
 namespace dev
 {
@@ -55,7 +57,9 @@ class ExecutionFramework
 
 public:
 	ExecutionFramework();
-	explicit ExecutionFramework(std::string const& _ipcPath, langutil::EVMVersion _evmVersion);
+	/// Executes the transactions in an in-process EVM if @a _internalEVM is set and
+	/// uses the client at @a _ipcPath otherwise.
+	explicit ExecutionFramework(std::string const& _ipcPath, langutil::EVMVersion _evmVersion, bool _internalEVM = false);
 	virtual ~ExecutionFramework() = default;
 
 	virtual bytes const& compileAndRunWithoutCheck(
@@ -249,6 +253,11 @@ protected:
 	void sendEther(Address const& _to, u256 const& _value);
 	size_t currentTimestamp();
 	size_t blockTimestamp(u256 _number);
+	/// Sets the timestamp of the block of the next transaction.
+	void modifyTimestamp(size_t _timestamp);
+	void mineBlocks(unsigned _number);
+	/// Sets the beneficiary of the blocks of the following transactions.
+	void setCoinbase(Address const& _coinbase);
 
 	/// @returns the (potentially newly created) _ith address.
 	Address account(size_t _i);
@@ -257,7 +266,9 @@ protected:
 	bool storageEmpty(Address const& _addr);
 	bool addressHasCode(Address const& _addr);
 
-	RPCSession& m_rpc;
+	/// Exactly one of them is set.
+	RPCSession* m_rpc = nullptr;
+	std::unique_ptr<EVMHost> m_evmHost;
 
 	struct LogEntry
 	{
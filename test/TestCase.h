@@ -51,6 +51,7 @@ public:
 		std::string filename;
 		std::string ipcPath;
 		langutil::EVMVersion evmVersion;
+		bool internalEVM = false;
 	};
 
 	using TestCaseCreator = std::unique_ptr<TestCase>(*)(Config const&);
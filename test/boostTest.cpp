@@ -80,7 +80,12 @@ int registerTests(
 {
 	int numTestsAdded = 0;
 	fs::path fullpath = _basepath / _path;
-	TestCase::Config config{fullpath.string(), _ipcPath, dev::test::Options::get().evmVersion()};
+	TestCase::Config config{
+		fullpath.string(),
+		_ipcPath,
+		dev::test::Options::get().evmVersion(),
+		dev::test::Options::get().internalEVM
+	};
 	if (fs::is_directory(fullpath))
 	{
 		test_suite* sub_suite = BOOST_TEST_SUITE(_path.filename().string());
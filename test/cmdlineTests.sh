@@ -117,7 +117,12 @@ function test_solc_behaviour()
     exitCode=$?
     set -e
 
-    if [[ "$solc_args" == *"--standard-json"* ]]
+    if [[ "$solc_args" == *"--server"* ]]
+    then
+        # Put each response on its own line.
+        sed -i -e 's/Content-Length: [0-9]*\r$//' -e '/^\r\{0,1\}$/d' "$stdout_path"
+    fi
+    if [[ "$solc_args" == *"--standard-json"* || "$solc_args" == *"--server"* ]]
     then
         sed -i -e 's/{[^{]*Warning: This is a pre-release compiler version[^}]*},\{0,1\}//' "$stdout_path"
         sed -i -e 's/"errors":\[\],\{0,1\}//' "$stdout_path"
@@ -230,6 +235,12 @@ printTask "Running general commandline tests..."
             stdin="${tdir}/input.json"
             stdout=$(cat ${tdir}/output.json 2>/dev/null || true)
             args="--standard-json "$(cat ${tdir}/args 2>/dev/null || true)
+        elif [ -e "${tdir}/requests" ]
+        then
+            inputFile=""
+            stdin="${tdir}/requests"
+            stdout=$(cat ${tdir}/output 2>/dev/null || true)
+            args="--server "$(cat ${tdir}/args 2>/dev/null || true)
         else
             inputFile="${tdir}input.sol"
             stdin=""
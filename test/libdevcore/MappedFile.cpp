@@ -0,0 +1,111 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for memory-mapped files and character streams reading from them.
+ */
+
+#include <libdevcore/MappedFile.h>
+#include <liblangutil/CharStream.h>
+
+#include <test/Options.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <memory>
+
+using namespace std;
+using namespace langutil;
+
+namespace fs = boost::filesystem;
+
+namespace dev
+{
+namespace test
+{
+
+namespace
+{
+
+/// Writes @a _contents to a new temporary file and removes it again on destruction.
+class TemporaryFile
+{
+public:
+	explicit TemporaryFile(string const& _contents):
+		m_path(fs::temp_directory_path() / fs::unique_path())
+	{
+		ofstream(m_path.string(), ios::binary) << _contents;
+	}
+	~TemporaryFile() { boost::system::error_code error; fs::remove(m_path, error); }
+	string path() const { return m_path.string(); }
+
+private:
+	fs::path m_path;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(MappedFileTest)
+
+BOOST_AUTO_TEST_CASE(contents)
+{
+	for (size_t size: {size_t(0), size_t(1), size_t(100), size_t(4096), size_t(65536), size_t(70000)})
+	{
+		string contents(size, 'x');
+		for (size_t i = 0; i < size; i += 7)
+			contents[i] = '\n';
+		TemporaryFile file(contents);
+		MappedFile mapped(file.path());
+		BOOST_REQUIRE_EQUAL(mapped.size(), size);
+		BOOST_CHECK(string(mapped.data(), mapped.size()) == contents);
+		BOOST_CHECK_EQUAL(mapped.data()[size], 0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(missing_file)
+{
+	MappedFile mapped((fs::temp_directory_path() / fs::unique_path()).string());
+	BOOST_CHECK_EQUAL(mapped.size(), 0);
+	BOOST_CHECK_EQUAL(mapped.data()[0], 0);
+}
+
+BOOST_AUTO_TEST_CASE(char_stream)
+{
+	string contents = "contract C {\n\tfunction f() public {}\n}";
+	TemporaryFile file(contents);
+	CharStream fromFile(make_shared<MappedFile const>(file.path()), "a.sol");
+	CharStream fromString(contents, "a.sol");
+	BOOST_CHECK_EQUAL(fromFile.source(), contents);
+	BOOST_CHECK_EQUAL(fromFile.size(), contents.size());
+	for (int position: {0, 5, 13, 14, 20, 37, 38, 100})
+	{
+		BOOST_CHECK_EQUAL(fromFile.lineAtPosition(position), fromString.lineAtPosition(position));
+		BOOST_CHECK(fromFile.translatePositionToLineColumn(position) == fromString.translatePositionToLineColumn(position));
+	}
+	BOOST_CHECK_EQUAL(fromFile.lineAtPosition(20), "\tfunction f() public {}");
+
+	CharStream copy = fromFile;
+	BOOST_CHECK_EQUAL(copy.data(), fromFile.data());
+	copy.advanceAndGet(3);
+	BOOST_CHECK_EQUAL(copy.position(), 3);
+	BOOST_CHECK_EQUAL(fromFile.position(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
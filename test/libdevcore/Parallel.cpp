@@ -0,0 +1,120 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the parallelFor function and the thread pool
+ */
+
+#include <libdevcore/Parallel.h>
+
+#include <test/Options.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(Parallel)
+
+BOOST_AUTO_TEST_CASE(all_indices_once)
+{
+	for (size_t threads: {0, 1, 2, 8})
+	{
+		vector<atomic<size_t>> calls(100);
+		parallelFor(calls.size(), threads, [&](size_t _index) { calls[_index]++; });
+		for (auto const& count: calls)
+			BOOST_CHECK_EQUAL(count, 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(no_tasks)
+{
+	parallelFor(0, 4, [](size_t) { BOOST_FAIL("Task called."); });
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_smallest_index)
+{
+	for (size_t threads: {1, 4})
+	{
+		string message;
+		try
+		{
+			parallelFor(50, threads, [](size_t _index) {
+				if (_index % 10 == 7)
+					throw runtime_error(to_string(_index));
+			});
+		}
+		catch (runtime_error const& _error)
+		{
+			message = _error.what();
+		}
+		BOOST_CHECK_EQUAL(message, "7");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(workers_are_reused)
+{
+	ThreadPool pool;
+	mutex threadsMutex;
+	set<thread::id> threads;
+	for (size_t round = 0; round < 20; ++round)
+		pool.parallelFor(16, 3, [&](size_t) {
+			lock_guard<mutex> lock(threadsMutex);
+			threads.insert(this_thread::get_id());
+		});
+	// The calling thread and at most two workers.
+	BOOST_CHECK_LE(threads.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(nested_calls)
+{
+	ThreadPool pool;
+	vector<atomic<size_t>> calls(8 * 8);
+	pool.parallelFor(8, 4, [&](size_t _outer) {
+		pool.parallelFor(8, 4, [&](size_t _inner) { calls[_outer * 8 + _inner]++; });
+	});
+	for (auto const& count: calls)
+		BOOST_CHECK_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(nested_calls_do_not_grow_the_pool)
+{
+	ThreadPool pool;
+	mutex threadsMutex;
+	set<thread::id> threads;
+	pool.parallelFor(4, 4, [&](size_t) {
+		pool.parallelFor(16, 4, [&](size_t) {
+			lock_guard<mutex> lock(threadsMutex);
+			threads.insert(this_thread::get_id());
+		});
+	});
+	// The calling thread and at most three workers.
+	BOOST_CHECK_LE(threads.size(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
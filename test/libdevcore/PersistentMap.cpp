@@ -0,0 +1,219 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the PersistentMap container.
+ */
+
+#include <libdevcore/PersistentMap.h>
+
+#include <test/Options.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+namespace
+{
+
+/// Spreads the keys over the whole hash range.
+struct SpreadHash
+{
+	uint64_t operator()(unsigned _key) const { return uint64_t(_key) * 0x9E3779B97F4A7C15u; }
+};
+
+/// Lets the keys collide in groups of four and share long hash prefixes.
+struct CollidingHash
+{
+	uint64_t operator()(unsigned _key) const { return uint64_t(_key / 4); }
+};
+
+template <class Hash>
+map<unsigned, int> entries(PersistentMap<unsigned, int, Hash> const& _map)
+{
+	map<unsigned, int> result;
+	_map.forEach([&](unsigned _key, int _value) {
+		BOOST_CHECK(result.emplace(_key, _value).second);
+	});
+	return result;
+}
+
+template <class Hash>
+void checkEqual(PersistentMap<unsigned, int, Hash> const& _map, map<unsigned, int> const& _expectation)
+{
+	BOOST_CHECK(entries(_map) == _expectation);
+	BOOST_CHECK_EQUAL(_map.empty(), _expectation.empty());
+	for (auto const& entry: _expectation)
+	{
+		int const* value = _map.find(entry.first);
+		BOOST_REQUIRE(value);
+		BOOST_CHECK_EQUAL(*value, entry.second);
+	}
+}
+
+template <class Hash>
+void randomOperations(unsigned _keyRange)
+{
+	mt19937 random(1);
+	vector<PersistentMap<unsigned, int, Hash>> maps(1);
+	vector<map<unsigned, int>> expectations(1);
+	for (size_t step = 0; step < 3000; ++step)
+	{
+		size_t const index = random() % maps.size();
+		unsigned const key = random() % _keyRange;
+		switch (random() % 6)
+		{
+		case 0:
+		case 1:
+			maps[index][key] = int(step);
+			expectations[index][key] = int(step);
+			break;
+		case 2:
+			maps[index].erase(key);
+			expectations[index].erase(key);
+			break;
+		case 3:
+			maps.push_back(maps[index]);
+			expectations.push_back(expectations[index]);
+			break;
+		case 4:
+		{
+			size_t const other = random() % maps.size();
+			maps[index].merge(maps[other], [](int& _a, int const& _b) { _a = max(_a, _b); });
+			for (auto const& entry: expectations[other])
+			{
+				auto it = expectations[index].find(entry.first);
+				if (it == expectations[index].end())
+					expectations[index].insert(entry);
+				else
+					it->second = max(it->second, entry.second);
+			}
+			break;
+		}
+		case 5:
+			BOOST_CHECK_EQUAL(maps[index].find(key) != nullptr, expectations[index].count(key) > 0);
+			break;
+		}
+	}
+	for (size_t i = 0; i < maps.size(); ++i)
+		checkEqual(maps[i], expectations[i]);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(PersistentMapTest)
+
+BOOST_AUTO_TEST_CASE(insert_find_erase)
+{
+	PersistentMap<unsigned, int, SpreadHash> m;
+	BOOST_CHECK(m.empty());
+	BOOST_CHECK(!m.find(7));
+	m[7] = 1;
+	m[9] = 2;
+	m[7] += 10;
+	checkEqual(m, {{7, 11}, {9, 2}});
+	m.erase(7);
+	m.erase(8);
+	checkEqual(m, {{9, 2}});
+	m.erase(9);
+	BOOST_CHECK(m.empty());
+}
+
+BOOST_AUTO_TEST_CASE(copies_are_independent)
+{
+	PersistentMap<unsigned, int, CollidingHash> a;
+	for (unsigned i = 0; i < 100; ++i)
+		a[i] = int(i);
+	auto b = a;
+	b[5] = -1;
+	b.erase(6);
+	b[1000] = 1000;
+	a[7] = -2;
+
+	map<unsigned, int> expectationA;
+	for (unsigned i = 0; i < 100; ++i)
+		expectationA[i] = int(i);
+	auto expectationB = expectationA;
+	expectationA[7] = -2;
+	expectationB[5] = -1;
+	expectationB.erase(6);
+	expectationB[1000] = 1000;
+	checkEqual(a, expectationA);
+	checkEqual(b, expectationB);
+}
+
+BOOST_AUTO_TEST_CASE(merge_joins_common_keys)
+{
+	PersistentMap<unsigned, int, CollidingHash> base;
+	for (unsigned i = 0; i < 20; ++i)
+		base[i] = 0;
+	auto branch = base;
+	branch[3] = 5;
+	branch[100] = 7;
+	base[4] = 2;
+	base.merge(branch, [](int& _a, int const& _b) { _a += _b; });
+
+	map<unsigned, int> expectation;
+	for (unsigned i = 0; i < 20; ++i)
+		expectation[i] = 0;
+	expectation[3] = 5;
+	expectation[4] = 2;
+	expectation[100] = 7;
+	checkEqual(base, expectation);
+}
+
+BOOST_AUTO_TEST_CASE(merge_skips_shared_entries)
+{
+	PersistentMap<unsigned, int, SpreadHash> base;
+	for (unsigned i = 0; i < 1000; ++i)
+		base[i] = 0;
+	auto branch = base;
+	branch[10] = 1;
+	size_t joins = 0;
+	base.merge(branch, [&](int& _a, int const& _b) { ++joins; _a = max(_a, _b); });
+	BOOST_CHECK_EQUAL(joins, 1);
+	BOOST_CHECK_EQUAL(*base.find(10), 1);
+}
+
+BOOST_AUTO_TEST_CASE(iteration_order)
+{
+	PersistentMap<unsigned, int, CollidingHash> m;
+	for (unsigned key: {9u, 1u, 6u, 0u, 3u, 12u, 2u})
+		m[key] = 0;
+	vector<unsigned> keys;
+	m.forEach([&](unsigned _key, int) { keys.push_back(_key); });
+	BOOST_CHECK(keys == vector<unsigned>({0, 1, 2, 3, 6, 9, 12}));
+}
+
+BOOST_AUTO_TEST_CASE(random_operations)
+{
+	randomOperations<SpreadHash>(200);
+	randomOperations<CollidingHash>(200);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -121,6 +121,42 @@ BOOST_AUTO_TEST_CASE(parameter_collision)
 	BOOST_CHECK_THROW(m.render(), WhiskersError);
 }
 
+BOOST_AUTO_TEST_CASE(unterminated_list)
+{
+	string templ = "a <#b> <c> </c> </x>";
+	string result = Whiskers(templ)("c", "C").render();
+	BOOST_CHECK_EQUAL(result, "a <#b> C </c> </x>");
+}
+
+BOOST_AUTO_TEST_CASE(nested_list)
+{
+	string templ = "<#a><#b></b></a>";
+	vector<map<string, string>> list(1);
+	Whiskers m(templ);
+	m("a", list)("b", list);
+	BOOST_CHECK_THROW(m.render(), WhiskersError);
+}
+
+BOOST_AUTO_TEST_CASE(tag_unavailable_in_list)
+{
+	string templ = "<#b>(<a>)</b>";
+	vector<map<string, string>> list(1);
+	Whiskers m(templ);
+	m("b", list);
+	BOOST_CHECK_THROW(m.render(), WhiskersError);
+}
+
+BOOST_AUTO_TEST_CASE(same_template_different_values)
+{
+	string templ = "<a><#b>[<c>]</b>";
+	vector<map<string, string>> list(2);
+	list[0]["c"] = "1";
+	list[1]["c"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "x")("b", list).render(), "x[1][2]");
+	list.resize(1);
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "y")("b", list).render(), "y[1]");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
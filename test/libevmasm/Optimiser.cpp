@@ -903,9 +903,45 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 		Instruction::POP
 	};
 	PeepholeOptimiser peepOpt(items);
-	for (size_t i = 0; i < 3; i++)
-		BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK(peepOpt.optimise());
 	BOOST_CHECK(items.empty());
+	BOOST_CHECK(!peepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_revisit_neighbourhood)
+{
+	AssemblyItems items{
+		AssemblyItem(Tag, 1),
+		u256(1),
+		u256(2),
+		Instruction::SWAP1,
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::POP,
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		u256(3),
+		AssemblyItem(Tag, 2),
+		Instruction::CALLVALUE,
+		Instruction::ISZERO,
+		Instruction::ISZERO,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI
+	};
+	AssemblyItems expectation{
+		AssemblyItem(Tag, 1),
+		AssemblyItem(Tag, 2),
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!peepOpt.optimise());
 }
 
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
@@ -0,0 +1,121 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the bulk character searches used by the scanner.
+ */
+
+#include <liblangutil/CharacterRuns.h>
+#include <liblangutil/Common.h>
+
+#include <test/Options.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+using namespace std;
+
+namespace langutil
+{
+namespace test
+{
+
+namespace
+{
+
+/// Checks @a _find against @a _matches for each character value at each position of
+/// inputs that are long enough to be processed in vectors.
+void checkAgainstReference(
+	function<char const*(char const*, char const*)> const& _find,
+	function<bool(char)> const& _matches,
+	char _filler
+)
+{
+	BOOST_REQUIRE(!_matches(_filler));
+	string const uniform(70, _filler);
+	BOOST_CHECK(_find(uniform.data(), uniform.data() + uniform.size()) == uniform.data() + uniform.size());
+	for (int value = 0; value < 256; value++)
+		for (size_t position: {0, 1, 15, 16, 17, 31, 32, 33, 47, 63, 64, 69})
+		{
+			string input(70, _filler);
+			input[position] = char(value);
+			char const* expected = input.data() + (_matches(char(value)) ? position : input.size());
+			BOOST_CHECK(_find(input.data(), input.data() + input.size()) == expected);
+			// The end of the range is respected.
+			BOOST_CHECK(_find(input.data(), input.data() + position) == input.data() + position);
+		}
+}
+
+bool isLineBreakCandidate(char _c)
+{
+	return ('\n' <= _c && _c <= '\r') || uint8_t(_c) == 0xc2 || uint8_t(_c) == 0xe2;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CharacterRunsTest)
+
+BOOST_AUTO_TEST_CASE(end_of_whitespace)
+{
+	checkAgainstReference(findEndOfWhitespace, [](char _c) { return !isWhiteSpace(_c); }, ' ');
+	checkAgainstReference(findEndOfWhitespace, [](char _c) { return !isWhiteSpace(_c); }, '\n');
+}
+
+BOOST_AUTO_TEST_CASE(end_of_identifier)
+{
+	checkAgainstReference(findEndOfIdentifier, [](char _c) { return !isIdentifierPart(_c); }, 'a');
+	checkAgainstReference(findEndOfIdentifier, [](char _c) { return !isIdentifierPart(_c); }, '_');
+}
+
+BOOST_AUTO_TEST_CASE(end_of_hex_digits)
+{
+	checkAgainstReference(findEndOfHexDigits, [](char _c) { return !isHexDigit(_c); }, 'F');
+}
+
+BOOST_AUTO_TEST_CASE(line_break_candidate)
+{
+	checkAgainstReference(findLineBreakCandidate, isLineBreakCandidate, 'x');
+}
+
+BOOST_AUTO_TEST_CASE(string_literal_special)
+{
+	for (char quote: {'"', '\''})
+		checkAgainstReference(
+			[&](char const* _begin, char const* _end) { return findStringLiteralSpecial(_begin, _end, quote); },
+			[&](char _c) { return _c == quote || _c == '\\' || isLineBreakCandidate(_c); },
+			'x'
+		);
+}
+
+BOOST_AUTO_TEST_CASE(single_characters)
+{
+	checkAgainstReference(
+		[](char const* _begin, char const* _end) { return findCharacter(_begin, _end, '*'); },
+		[](char _c) { return _c == '*'; },
+		'x'
+	);
+	checkAgainstReference(
+		[](char const* _begin, char const* _end) { return findEither(_begin, _end, '\n', '*'); },
+		[](char _c) { return _c == '\n' || _c == '*'; },
+		'x'
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the cache of generated inline assembly blocks.
+ */
+
+#include <libsolidity/codegen/CompilerContext.h>
+#include <libsolidity/codegen/GeneratedAssemblyCache.h>
+
+#include <libyul/YulString.h>
+
+#include <test/Options.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+string const c_assembly = R"({
+	function f(a) -> b { b := add(mul(a, 2), 1) }
+	mstore(0, f(calldataload(0)))
+	mstore(32, f(calldataload(32)))
+})";
+
+string generate(GeneratedAssemblyCache* _cache, OptimiserSettings const& _settings)
+{
+	CompilerContext context(dev::test::Options::get().evmVersion());
+	context.setGeneratedAssemblyCache(_cache);
+	context.appendInlineAssembly(c_assembly, {}, {}, false, _settings);
+	return context.assemblyString();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(GeneratedAssemblyCacheTest)
+
+BOOST_AUTO_TEST_CASE(hit_produces_identical_code)
+{
+	for (auto const& settings: {OptimiserSettings::minimal(), OptimiserSettings::full()})
+	{
+		GeneratedAssemblyCache cache;
+		string uncached = generate(nullptr, settings);
+		BOOST_CHECK_EQUAL(generate(&cache, settings), uncached);
+		BOOST_CHECK_EQUAL(cache.size(), 1);
+		BOOST_CHECK_EQUAL(cache.hits(), 0);
+		BOOST_CHECK_EQUAL(generate(&cache, settings), uncached);
+		BOOST_CHECK_EQUAL(cache.size(), 1);
+		BOOST_CHECK_EQUAL(cache.hits(), 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(emptied_for_other_repository)
+{
+	GeneratedAssemblyCache cache;
+	generate(&cache, OptimiserSettings::full());
+	BOOST_CHECK_EQUAL(cache.size(), 1);
+	{
+		yul::YulStringRepository::Scope scope;
+		generate(&cache, OptimiserSettings::full());
+		BOOST_CHECK_EQUAL(cache.size(), 1);
+		BOOST_CHECK_EQUAL(cache.hits(), 0);
+		// Drop the blocks that refer to the scoped repository.
+		cache.clear();
+	}
+	generate(&cache, OptimiserSettings::full());
+	BOOST_CHECK_EQUAL(cache.size(), 1);
+	BOOST_CHECK_EQUAL(cache.hits(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(emptied_for_repository_at_reused_address)
+{
+	GeneratedAssemblyCache cache;
+	for (size_t i = 0; i < 2; ++i)
+	{
+		// The second repository is usually allocated where the first one was.
+		yul::YulStringRepository::Scope scope;
+		generate(&cache, OptimiserSettings::full());
+		BOOST_CHECK_EQUAL(cache.size(), 1);
+		BOOST_CHECK_EQUAL(cache.hits(), 0);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
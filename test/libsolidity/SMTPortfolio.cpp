@@ -0,0 +1,272 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the portfolio of SMT solvers, using solvers that answer after a delay.
+ */
+
+#include <libsolidity/formal/SMTPortfolio.h>
+
+#include <libdevcore/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/// Solver that gives a fixed answer after a delay unless it is interrupted.
+/// Like the real solvers, it ignores interrupts while it is not checking.
+class DelayedSolver: public smt::SolverInterface
+{
+public:
+	DelayedSolver(smt::CheckResult _answer, chrono::milliseconds _delay): m_answer(_answer), m_delay(_delay) {}
+
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(string const&, smt::SortPointer const&) override {}
+	void addAssertion(smt::Expression const&) override {}
+
+	pair<smt::CheckResult, vector<string>> check(vector<smt::Expression> const&) override
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_checking = true;
+		m_interrupted = false;
+		checks++;
+		bool interrupted = m_interrupt.wait_for(lock, m_delay, [&]() { return m_interrupted; });
+		m_checking = false;
+		if (interrupted)
+		{
+			interrupts++;
+			return {smt::CheckResult::UNKNOWN, {}};
+		}
+		return {m_answer, {}};
+	}
+
+	void interrupt() override
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (!m_checking)
+			return;
+		m_interrupted = true;
+		m_interrupt.notify_all();
+	}
+
+	unsigned checks = 0;
+	unsigned interrupts = 0;
+
+private:
+	smt::CheckResult m_answer;
+	chrono::milliseconds m_delay;
+	mutex m_mutex;
+	condition_variable m_interrupt;
+	bool m_checking = false;
+	bool m_interrupted = false;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest)
+
+BOOST_AUTO_TEST_CASE(fixed_order_by_default)
+{
+	map<h256, string> responses;
+	auto slow = make_shared<DelayedSolver>(smt::CheckResult::SATISFIABLE, chrono::milliseconds(20));
+	auto fast = make_shared<DelayedSolver>(smt::CheckResult::SATISFIABLE, chrono::milliseconds(0));
+	smt::SMTPortfolio portfolio(responses, smt::SolverSettings{}, {{"slow", "", slow}, {"fast", "", fast}});
+
+	// The answer of the first solver is used, regardless of which one is faster.
+	BOOST_CHECK(portfolio.check({}).first == smt::CheckResult::SATISFIABLE);
+	BOOST_CHECK_EQUAL(slow->checks, 1);
+	BOOST_CHECK_EQUAL(fast->checks, 1);
+	BOOST_CHECK_EQUAL(portfolio.statistics().at(1).firstAnswers, 1);
+	BOOST_CHECK_EQUAL(portfolio.statistics().at(2).firstAnswers, 0);
+}
+
+BOOST_AUTO_TEST_CASE(first_answer_wins)
+{
+	map<h256, string> responses;
+	smt::SolverSettings settings;
+	settings.race = true;
+	auto start = chrono::steady_clock::now();
+	for (size_t round = 0; round < 50; ++round)
+	{
+		auto fast = make_shared<DelayedSolver>(smt::CheckResult::SATISFIABLE, chrono::milliseconds(0));
+		auto slow = make_shared<DelayedSolver>(smt::CheckResult::UNSATISFIABLE, chrono::milliseconds(60000));
+		smt::SMTPortfolio portfolio(responses, settings, {{"fast", "", fast}, {"slow", "", slow}});
+
+		BOOST_CHECK(portfolio.check({}).first == smt::CheckResult::SATISFIABLE);
+		// The slow solver is either not started or interrupted.
+		BOOST_CHECK_EQUAL(slow->checks, slow->interrupts);
+		BOOST_CHECK_EQUAL(portfolio.statistics().at(1).firstAnswers, 1);
+		BOOST_CHECK_EQUAL(portfolio.statistics().at(2).firstAnswers, 0);
+	}
+	BOOST_CHECK(chrono::steady_clock::now() - start < chrono::seconds(30));
+}
+
+BOOST_AUTO_TEST_CASE(no_answer)
+{
+	map<h256, string> responses;
+	auto first = make_shared<DelayedSolver>(smt::CheckResult::UNKNOWN, chrono::milliseconds(0));
+	auto second = make_shared<DelayedSolver>(smt::CheckResult::ERROR, chrono::milliseconds(10));
+	smt::SMTPortfolio portfolio(responses, smt::SolverSettings{}, {{"first", "", first}, {"second", "", second}});
+
+	BOOST_CHECK(portfolio.check({}).first == smt::CheckResult::UNKNOWN);
+	BOOST_CHECK_EQUAL(first->checks, 1);
+	BOOST_CHECK_EQUAL(second->checks, 1);
+	BOOST_CHECK_EQUAL(first->interrupts + second->interrupts, 0);
+}
+
+BOOST_AUTO_TEST_CASE(smtlib2_outside_race)
+{
+	map<h256, string> responses;
+	smt::SolverSettings settings;
+	settings.race = true;
+	auto fast = make_shared<DelayedSolver>(smt::CheckResult::SATISFIABLE, chrono::milliseconds(0));
+	auto other = make_shared<DelayedSolver>(smt::CheckResult::SATISFIABLE, chrono::milliseconds(0));
+	smt::SMTPortfolio portfolio(responses, settings, {{"fast", "", fast}, {"other", "", other}});
+
+	// The query is reported as unhandled even though another solver answered it.
+	BOOST_CHECK(portfolio.check({}).first == smt::CheckResult::SATISFIABLE);
+	vector<string> unhandled = portfolio.unhandledQueries();
+	BOOST_REQUIRE_EQUAL(unhandled.size(), 1);
+
+	// A response to the query is used without asking the other solvers.
+	responses[keccak256(unhandled.front())] = "unsat\n";
+	auto unused = make_shared<DelayedSolver>(smt::CheckResult::SATISFIABLE, chrono::milliseconds(0));
+	smt::SMTPortfolio answered(responses, settings, {{"unused", "", unused}, {"other", "", other}});
+	BOOST_CHECK(answered.check({}).first == smt::CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(answered.unhandledQueries().empty());
+	BOOST_CHECK_EQUAL(unused->checks, 0);
+}
+
+BOOST_AUTO_TEST_CASE(cache)
+{
+	map<h256, string> responses;
+	smt::SolverSettings settings;
+	settings.cacheDirectory = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+	auto check = [&](string const& _variable, shared_ptr<DelayedSolver> const& _solver) {
+		smt::SMTPortfolio portfolio(responses, settings, {{"solver", "", _solver}});
+		smt::Expression x = portfolio.newVariable(_variable, make_shared<smt::Sort>(smt::Kind::Int));
+		portfolio.addAssertion(x > 0);
+		return portfolio.check({}).first;
+	};
+
+	auto solver = make_shared<DelayedSolver>(smt::CheckResult::SATISFIABLE, chrono::milliseconds(0));
+	BOOST_CHECK(check("x", solver) == smt::CheckResult::SATISFIABLE);
+	BOOST_CHECK_EQUAL(solver->checks, 1);
+
+	// The answer is found in the cache, also if the variable is renamed.
+	for (string variable: {"x", "y"})
+	{
+		auto unused = make_shared<DelayedSolver>(smt::CheckResult::UNSATISFIABLE, chrono::milliseconds(0));
+		BOOST_CHECK(check(variable, unused) == smt::CheckResult::SATISFIABLE);
+		BOOST_CHECK_EQUAL(unused->checks, 0);
+	}
+
+	boost::filesystem::remove_all(settings.cacheDirectory);
+}
+
+BOOST_AUTO_TEST_CASE(smtlib2_answers_not_cached)
+{
+	map<h256, string> responses;
+	smt::SolverSettings settings;
+	settings.cacheDirectory = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+	auto unknown = make_shared<DelayedSolver>(smt::CheckResult::UNKNOWN, chrono::milliseconds(0));
+
+	smt::SMTPortfolio first(responses, settings, {{"solver", "", unknown}});
+	BOOST_CHECK(first.check({}).first == smt::CheckResult::UNKNOWN);
+	BOOST_REQUIRE_EQUAL(first.unhandledQueries().size(), 1);
+	responses[keccak256(first.unhandledQueries().front())] = "unsat\n";
+
+	smt::SMTPortfolio answered(responses, settings, {{"solver", "", unknown}});
+	BOOST_CHECK(answered.check({}).first == smt::CheckResult::UNSATISFIABLE);
+
+	// Without the responses, the query is not answered.
+	responses.clear();
+	smt::SMTPortfolio uncached(responses, settings, {{"solver", "", unknown}});
+	BOOST_CHECK(uncached.check({}).first == smt::CheckResult::UNKNOWN);
+	BOOST_CHECK_EQUAL(uncached.unhandledQueries().size(), 1);
+
+	boost::filesystem::remove_all(settings.cacheDirectory);
+}
+
+BOOST_AUTO_TEST_CASE(independent_queries_on_kept_portfolios)
+{
+	// The SMT-LIB2 interface reports the queries it was asked, including the declarations
+	// and assertions they were checked with, so they show the state of the worker portfolios.
+	auto run = [](unsigned _threads)
+	{
+		map<h256, string> responses;
+		smt::SolverSettings settings;
+		settings.threads = _threads;
+		smt::SMTPortfolio portfolio(responses, settings);
+		auto sort = make_shared<smt::Sort>(smt::Kind::Int);
+		auto checkQueries = [&](smt::Expression const& _expr)
+		{
+			vector<smt::SMTPortfolio::Query> queries;
+			for (size_t i = 0; i < 5; ++i)
+				queries.push_back({_expr > i, {}});
+			portfolio.checkIndependently(queries);
+		};
+
+		smt::Expression x = portfolio.newVariable("x", sort);
+		portfolio.addAssertion(x > 1);
+		checkQueries(x);
+		portfolio.push();
+		smt::Expression y = portfolio.newVariable("y", sort);
+		portfolio.addAssertion(y > x);
+		checkQueries(y);
+		portfolio.push();
+		portfolio.addAssertion(y < 10);
+		checkQueries(x + y);
+		portfolio.pop();
+		portfolio.pop();
+		portfolio.addAssertion(x < 5);
+		checkQueries(x);
+		portfolio.push();
+		portfolio.addAssertion(x != 3);
+		checkQueries(x);
+		portfolio.reset();
+		smt::Expression z = portfolio.newVariable("z", sort);
+		checkQueries(z);
+		return portfolio.unhandledQueries();
+	};
+
+	vector<string> sequential = run(1);
+	BOOST_CHECK_EQUAL(sequential.size(), 30);
+	BOOST_CHECK(run(3) == sequential);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
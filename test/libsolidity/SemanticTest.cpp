@@ -36,8 +36,13 @@ using namespace boost::unit_test;
 namespace fs = boost::filesystem;
 
 
-SemanticTest::SemanticTest(string const& _filename, string const& _ipcPath, langutil::EVMVersion _evmVersion):
-	SolidityExecutionFramework(_ipcPath, _evmVersion)
+SemanticTest::SemanticTest(
+	string const& _filename,
+	string const& _ipcPath,
+	langutil::EVMVersion _evmVersion,
+	bool _internalEVM
+):
+	SolidityExecutionFramework(_ipcPath, _evmVersion, _internalEVM)
 {
 	ifstream file(_filename);
 	soltestAssert(file, "Cannot open test contract: \"" + _filename + "\".");
@@ -44,9 +44,14 @@ class SemanticTest: public SolidityExecutionFramework, public TestCase
 {
 public:
 	static std::unique_ptr<TestCase> create(Config const& _options)
-	{ return std::make_unique<SemanticTest>(_options.filename, _options.ipcPath, _options.evmVersion); }
+	{ return std::make_unique<SemanticTest>(_options.filename, _options.ipcPath, _options.evmVersion, _options.internalEVM); }
 
-	explicit SemanticTest(std::string const& _filename, std::string const& _ipcPath, langutil::EVMVersion _evmVersion);
+	explicit SemanticTest(
+		std::string const& _filename,
+		std::string const& _ipcPath,
+		langutil::EVMVersion _evmVersion,
+		bool _internalEVM = false
+	);
 
 	bool run(std::ostream& _stream, std::string const& _linePrefix = "", bool _formatted = false) override;
 	void printSource(std::ostream &_stream, std::string const& _linePrefix = "", bool _formatted = false) const override;
@@ -33,7 +33,11 @@ SolidityExecutionFramework::SolidityExecutionFramework():
 {
 }
 
-SolidityExecutionFramework::SolidityExecutionFramework(std::string const& _ipcPath, langutil::EVMVersion _evmVersion):
-	ExecutionFramework(_ipcPath, _evmVersion)
+SolidityExecutionFramework::SolidityExecutionFramework(
+	std::string const& _ipcPath,
+	langutil::EVMVersion _evmVersion,
+	bool _internalEVM
+):
+	ExecutionFramework(_ipcPath, _evmVersion, _internalEVM)
 {
 }
@@ -648,6 +648,46 @@ BOOST_AUTO_TEST_CASE(irregular_line_breaks_in_strings)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(long_tokens)
+{
+	// Tokens and comments of all lengths around the sizes the scanner processes in bulk.
+	for (size_t length = 0; length < 80; length++)
+	{
+		string const padding(length, 'a');
+		Scanner scanner(CharStream(
+			"x" + padding + " " + string(length, ' ') + string(length, '\n') +
+			"\"" + padding + "\\n" + padding + "\" " +
+			"hex\"" + string(2 * length, 'f') + "\" " +
+			"// " + padding + "\xc2\x80" + padding + "*/\n" +
+			"/* " + padding + "**" + padding + "*/ " +
+			"/// " + padding + "\n" +
+			"y" + padding,
+			""
+		));
+		BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), "x" + padding);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), padding + "\n" + padding);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), string(length, '\xff'));
+		BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), "y" + padding);
+		BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), padding);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(long_multiline_documentation_comment)
+{
+	for (size_t length = 1; length < 80; length++)
+	{
+		string const padding(length, 'a');
+		Scanner scanner(CharStream("/** " + padding + " * " + padding + "\n * " + padding + "*/ x", ""));
+		BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+		BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), padding + " * " + padding + "\n" + padding);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
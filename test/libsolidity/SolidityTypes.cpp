@@ -21,6 +21,7 @@
  */
 
 #include <libsolidity/ast/Types.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/AST.h>
 #include <libdevcore/Keccak256.h>
 #include <boost/test/unit_test.hpp>
@@ -287,6 +288,29 @@ BOOST_AUTO_TEST_CASE(helper_string_result)
 	BOOST_REQUIRE_EQUAL(r1.message(), "Failure");
 }
 
+BOOST_AUTO_TEST_CASE(type_provider_scope)
+{
+	// Without a provider, every call returns a new type.
+	BOOST_CHECK(TypeProvider::uint256() != TypeProvider::uint256());
+
+	TypeProvider provider;
+	shared_ptr<IntegerType const> shared;
+	{
+		TypeProvider::Scope scope{provider};
+		shared = TypeProvider::uint256();
+		BOOST_CHECK(TypeProvider::integer(256) == shared);
+		BOOST_CHECK(TypeProvider::stringMemory() == TypeProvider::stringMemory());
+		{
+			TypeProvider other;
+			TypeProvider::Scope innerScope{other};
+			BOOST_CHECK(TypeProvider::uint256() != shared);
+		}
+		BOOST_CHECK(TypeProvider::uint256() == shared);
+	}
+	BOOST_CHECK(TypeProvider::uint256() != shared);
+	BOOST_CHECK(*TypeProvider::uint256() == *shared);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
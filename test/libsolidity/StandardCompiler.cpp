@@ -25,6 +25,8 @@
 #include <libdevcore/JSON.h>
 #include <test/Metadata.h>
 
+#include <boost/filesystem.hpp>
+
 using namespace std;
 using namespace dev::eth;
 
@@ -1156,6 +1158,279 @@ BOOST_AUTO_TEST_CASE(use_stack_optimization)
 	BOOST_CHECK(result["errors"][0]["type"] == "InternalCompilerError");
 }
 
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": {
+					"A": [ "evm.bytecode.object" ]
+				}
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "import \"lib.sol\"; contract A { function f() public pure returns (uint) { return L.g(); } }"
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(jsonParseStrict(input, parsedInput));
+
+	string library = "library L { function g() internal pure returns (uint) { return 1; } }";
+	size_t reads = 0;
+	auto readFile = [&](string const& _path) {
+		reads++;
+		if (_path == "lib.sol")
+			return ReadCallback::Result{true, library};
+		return ReadCallback::Result{false, "File not found."};
+	};
+	boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+
+	dev::solidity::StandardCompiler compiler(readFile);
+	compiler.setCacheDirectory(directory.string());
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK_EQUAL(reads, 1);
+
+	// Cache hit: the imported file is only read to check its hash.
+	BOOST_CHECK_EQUAL(jsonCompactPrint(compiler.compile(parsedInput)), jsonCompactPrint(result));
+	BOOST_CHECK_EQUAL(reads, 2);
+
+	// A different process shares the cache.
+	dev::solidity::StandardCompiler otherCompiler(readFile);
+	otherCompiler.setCacheDirectory(directory.string());
+	BOOST_CHECK_EQUAL(jsonCompactPrint(otherCompiler.compile(parsedInput)), jsonCompactPrint(result));
+	BOOST_CHECK_EQUAL(reads, 3);
+
+	// Changing the imported file invalidates the entry.
+	library = "library L { function g() internal pure returns (uint) { return 2; } }";
+	Json::Value changedResult = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(changedResult));
+	BOOST_CHECK(jsonCompactPrint(changedResult) != jsonCompactPrint(result));
+	BOOST_CHECK_EQUAL(reads, 5);
+
+	boost::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(smt_checker_statistics)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"smtChecker": { "timeout": 1000, "portfolio": "consensus", "statistics": true }
+		},
+		"sources": {
+			"fileA": {
+				"content": "pragma experimental SMTChecker; contract A { function f(uint x) public pure { assert(x > 0); } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& solvers = result["smtChecker"]["solvers"];
+	BOOST_REQUIRE(solvers.isObject());
+	BOOST_REQUIRE(solvers.isMember("smtlib2"));
+	BOOST_CHECK(solvers["smtlib2"]["queries"].asUInt() > 0);
+	BOOST_CHECK(solvers["smtlib2"]["time"].isIntegral());
+}
+
+BOOST_AUTO_TEST_CASE(smt_checker_threads)
+{
+	auto input = [](unsigned _threads) {
+		return R"(
+		{
+			"language": "Solidity",
+			"settings": {
+				"smtChecker": { "threads": )" + to_string(_threads) + R"( }
+			},
+			"sources": {
+				"fileA": {
+					"content": "pragma experimental SMTChecker; contract A { function f(uint x, uint y) public pure returns (uint) { if (x > y) return x - y; return x * y + y; } }"
+				}
+			}
+		}
+		)";
+	};
+	// Queries checked on other threads are the same as the ones checked sequentially.
+	Json::Value result = compile(input(1));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& queries = result["auxiliaryInputRequested"]["smtlib2queries"];
+	BOOST_REQUIRE(queries.isObject());
+	BOOST_CHECK(queries.size() > 2);
+	BOOST_CHECK_EQUAL(
+		jsonCompactPrint(compile(input(4))["auxiliaryInputRequested"]),
+		jsonCompactPrint(result["auxiliaryInputRequested"])
+	);
+}
+
+BOOST_AUTO_TEST_CASE(parallelism)
+{
+	// Contracts that create each other, also through base contracts, share library functions
+	// bound to types, and use inline assembly and the ABI coder version 2.
+	auto input = [](bool _optimize, unsigned _parallelism) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["settings"]["optimizer"]["enabled"] = _optimize;
+		input["settings"]["parallelism"] = _parallelism;
+		input["settings"]["outputSelection"]["*"]["*"][0] = "*";
+		input["sources"]["a.sol"]["content"] = R"(
+			pragma solidity >=0.0;
+			library L {
+				function twice(uint x) internal pure returns (uint) { return 2 * x; }
+				function thrice(uint x) public pure returns (uint) { return 3 * x; }
+			}
+			contract Base {
+				using L for uint;
+				uint public value;
+				event Changed(uint);
+				function set(uint x) public { value = x.twice(); emit Changed(value); }
+			}
+			contract A is Base {
+				constructor(uint x) public { set(x); }
+			}
+		)";
+		input["sources"]["b.sol"]["content"] = R"(
+			pragma solidity >=0.0;
+			pragma experimental ABIEncoderV2;
+			import "a.sol";
+			contract B is Base {
+				struct S { uint a; uint[] b; }
+				A public a = new A(1);
+				function f(S memory s) public returns (S memory, A) { return (s, new A(s.a)); }
+			}
+			contract C {
+				B b = new B();
+				function g() public returns (A) { return new A(L.thrice(b.value())); }
+				function h() public pure returns (bytes memory) { return type(B).creationCode; }
+			}
+		)";
+		input["sources"]["c.sol"]["content"] = R"(
+			pragma solidity >=0.0;
+			interface I { function f(uint) external returns (uint); }
+			contract D { function f(uint x) public pure returns (uint r) { assembly { r := mul(x, 7) } } }
+			contract E is D { function g(I i) public returns (uint) { return i.f(f(2)); } }
+		)";
+		input["sources"]["d.sol"]["content"] = R"(
+			pragma solidity >=0.0;
+			import "a.sol";
+			contract F {
+				function make() internal returns (A);
+				function create() public returns (A) { return new A(3); }
+			}
+			contract G is F { function make() internal returns (A) { return create(); } }
+		)";
+		return jsonCompactPrint(input);
+	};
+
+	for (bool optimize: {false, true})
+	{
+		Json::Value result = compile(input(optimize, 1));
+		BOOST_CHECK(containsAtMostWarnings(result));
+		BOOST_REQUIRE(result["contracts"]["b.sol"]["C"]["evm"]["bytecode"]["object"].isString());
+		BOOST_CHECK_EQUAL(jsonCompactPrint(compile(input(optimize, 4))), jsonCompactPrint(result));
+	}
+
+	Json::Value result = compile(R"({"language": "Solidity", "settings": {"parallelism": 0}, "sources": {"": {"content": ""}}})");
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be a positive number."));
+}
+
+BOOST_AUTO_TEST_CASE(source_map_of_created_contract)
+{
+	// Optimising B must not change the assembly of A, which B creates.
+	string const contractA = R"(
+		contract A {
+			uint[] data;
+			function f(uint x) public returns (uint) {
+				data.push(x * 0x100000000000000000000000000000000);
+				return data.length + 0xfffffffffffffffffffffffffffffffffffffffffff;
+			}
+		}
+	)";
+	auto runtimeSourceMap = [](string const& _source) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["settings"]["optimizer"]["enabled"] = true;
+		input["settings"]["outputSelection"]["*"]["*"][0] = "evm.deployedBytecode.sourceMap";
+		input["sources"]["fileA"]["content"] = _source;
+		Json::Value result = compile(jsonCompactPrint(input));
+		BOOST_CHECK(containsAtMostWarnings(result));
+		Json::Value contract = getContractResult(result, "fileA", "A");
+		BOOST_REQUIRE(contract["evm"]["deployedBytecode"]["sourceMap"].isString());
+		return contract["evm"]["deployedBytecode"]["sourceMap"].asString();
+	};
+	BOOST_CHECK_EQUAL(
+		runtimeSourceMap(contractA + "contract B { function g() public returns (A) { return new A(); } }"),
+		runtimeSourceMap(contractA)
+	);
+}
+
+BOOST_AUTO_TEST_CASE(smt_checker_cache)
+{
+	boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	auto input = [&](string const& _variable, Json::Value const& _responses) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["settings"]["smtChecker"]["cacheDirectory"] = directory.string();
+		input["settings"]["smtChecker"]["statistics"] = true;
+		input["sources"]["fileA"]["content"] =
+			"pragma experimental SMTChecker; contract A { function f(uint " + _variable + ") public pure { assert(" + _variable + " > 0); } }";
+		if (_responses.isObject())
+			input["auxiliaryInput"]["smtlib2responses"] = _responses;
+		return jsonCompactPrint(input);
+	};
+
+	Json::Value result = compile(input("x", Json::nullValue));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& queries = result["auxiliaryInputRequested"]["smtlib2queries"];
+	BOOST_REQUIRE(queries.isObject());
+	BOOST_REQUIRE(queries.size() > 0);
+	BOOST_CHECK_EQUAL(result["smtChecker"]["solvers"]["cache"]["answers"], 0);
+
+	// Unanswered queries are not cached.
+	Json::Value repeated = compile(input("x", Json::nullValue));
+	BOOST_CHECK_EQUAL(jsonCompactPrint(repeated["auxiliaryInputRequested"]), jsonCompactPrint(result["auxiliaryInputRequested"]));
+	BOOST_CHECK_EQUAL(repeated["smtChecker"]["solvers"]["cache"]["answers"], 0);
+
+	Json::Value responses(Json::objectValue);
+	for (auto const& hash: queries.getMemberNames())
+		responses[hash] = "unsat\n";
+	Json::Value answered = compile(input("x", responses));
+	BOOST_CHECK(containsAtMostWarnings(answered));
+	BOOST_CHECK(!answered.isMember("auxiliaryInputRequested"));
+
+	// Answers taken from the responses are not cached, since the responses are not part of the key.
+	Json::Value uncached = compile(input("x", Json::nullValue));
+	BOOST_CHECK_EQUAL(jsonCompactPrint(uncached["auxiliaryInputRequested"]), jsonCompactPrint(result["auxiliaryInputRequested"]));
+	BOOST_CHECK_EQUAL(uncached["smtChecker"]["solvers"]["cache"]["answers"], 0);
+
+	boost::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(smt_checker_invalid_settings)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"smtChecker": { "portfolio": "fastest" }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.smtChecker.portfolio\" must be \"race\" or \"consensus\"."));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
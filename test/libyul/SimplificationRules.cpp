@@ -0,0 +1,177 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the lookup of simplification rules.
+ */
+
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmData.h>
+#include <libyul/AsmPrinter.h>
+
+#include <libevmasm/Instruction.h>
+#include <libevmasm/RuleList.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <random>
+#include <set>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace langutil;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+/// Rule list that is searched linearly, without the operand shape index.
+class LinearRules
+{
+public:
+	LinearRules()
+	{
+		Pattern A(PatternKind::Constant);
+		Pattern B(PatternKind::Constant);
+		Pattern C(PatternKind::Constant);
+		Pattern X;
+		Pattern Y;
+		A.setMatchGroup(1, m_matchGroups);
+		B.setMatchGroup(2, m_matchGroups);
+		C.setMatchGroup(3, m_matchGroups);
+		X.setMatchGroup(4, m_matchGroups);
+		Y.setMatchGroup(5, m_matchGroups);
+		m_rules = simplificationRuleList(A, B, C, X, Y);
+	}
+
+	SimplificationRule<Pattern> const* findFirstMatch(
+		Expression const& _expr,
+		Dialect const& _dialect,
+		map<YulString, Expression const*> const& _ssaValues
+	)
+	{
+		if (_expr.type() != typeid(FunctionalInstruction))
+			return nullptr;
+		for (auto const& rule: m_rules)
+		{
+			if (rule.pattern.instruction() != boost::get<FunctionalInstruction>(_expr).instruction)
+				continue;
+			m_matchGroups.clear();
+			if (rule.pattern.matches(_expr, _dialect, _ssaValues) && (!rule.feasible || rule.feasible()))
+				return &rule;
+		}
+		return nullptr;
+	}
+
+	/// @returns the instructions that are the root of at least one rule.
+	vector<eth::Instruction> roots() const
+	{
+		set<eth::Instruction> instructions;
+		for (auto const& rule: m_rules)
+			instructions.insert(rule.pattern.instruction());
+		return {instructions.begin(), instructions.end()};
+	}
+
+private:
+	map<unsigned, Expression const*> m_matchGroups;
+	vector<SimplificationRule<Pattern>> m_rules;
+};
+
+/// Generates random expressions from the root instructions of the rules, number literals
+/// that often occur in the rules and variables, some of which have known values.
+class ExpressionGenerator
+{
+public:
+	explicit ExpressionGenerator(vector<eth::Instruction> _instructions): m_instructions(move(_instructions)) {}
+
+	Expression generate(size_t _depth)
+	{
+		if (_depth > 0 && m_random() % 3 != 0)
+		{
+			eth::Instruction instruction = m_instructions[m_random() % m_instructions.size()];
+			FunctionalInstruction expression{{}, instruction, {}};
+			for (int i = 0; i < instructionInfo(instruction).args; ++i)
+				expression.arguments.emplace_back(generate(_depth - 1));
+			return expression;
+		}
+		else if (m_random() % 2 == 0)
+		{
+			static vector<u256> const values{0, 1, 2, 3, 31, 32, 255, 256, u256(1) << 160, u256(1) << 255, ~u256(0)};
+			u256 value = values[m_random() % values.size()];
+			return Literal{{}, LiteralKind::Number, YulString{toCompactHexWithPrefix(value)}, {}};
+		}
+		else
+		{
+			static vector<string> const names{"x", "y", "c", "e"};
+			return Identifier{{}, YulString{names[m_random() % names.size()]}};
+		}
+	}
+
+private:
+	vector<eth::Instruction> m_instructions;
+	mt19937 m_random{1};
+};
+
+string applyRule(SimplificationRule<Pattern> const* _rule)
+{
+	if (!_rule)
+		return "no match";
+	return boost::apply_visitor(AsmPrinter{}, _rule->action().toExpression({}));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulSimplificationRules)
+
+BOOST_AUTO_TEST_CASE(index_equals_linear_scan)
+{
+	shared_ptr<Dialect> dialect = EVMDialect::strictAssemblyForEVM(EVMVersion());
+	LinearRules linearRules;
+	ExpressionGenerator generator(linearRules.roots());
+
+	// "c" has a constant value and "e" is the value of an operation, "x" and "y" are unknown.
+	Expression constant = Literal{{}, LiteralKind::Number, YulString{"7"}, {}};
+	Expression operation = FunctionalInstruction{{}, eth::Instruction::CALLER, {}};
+	map<YulString, Expression const*> ssaValues{{YulString{"c"}, &constant}, {YulString{"e"}, &operation}};
+
+	size_t matches = 0;
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		Expression expression = generator.generate(3);
+		string expectation = applyRule(linearRules.findFirstMatch(expression, *dialect, ssaValues));
+		string result = applyRule(SimplificationRules::findFirstMatch(expression, *dialect, ssaValues));
+		BOOST_REQUIRE_MESSAGE(
+			result == expectation,
+			"Different rule for " + boost::apply_visitor(AsmPrinter{}, expression) + ": " + result + " instead of " + expectation
+		);
+		if (expectation != "no match")
+			matches++;
+	}
+	// Make sure that the expressions exercise the rules.
+	BOOST_CHECK_GT(matches, 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -38,6 +38,7 @@
 #include <libyul/optimiser/UnusedPruner.h>
 #include <libyul/optimiser/ExpressionJoiner.h>
 #include <libyul/optimiser/SSAReverser.h>
+#include <libyul/optimiser/StableFunctions.h>
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
@@ -156,6 +157,30 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 		disambiguate();
 		ExpressionInliner(*m_dialect, *m_ast).run();
 	}
+	else if (m_optimizerStep == "stableFunctions")
+	{
+		disambiguate();
+		(FunctionHoister{})(*m_ast);
+		NameDispenser nameDispenser{*m_dialect, *m_ast};
+		StableFunctions stableFunctions;
+		// Functions the simplifier does not change become stable.
+		for (size_t round = 0; round < 2; ++round)
+		{
+			stableFunctions.startRound(*m_ast);
+			stableFunctions.runOnUnstable(*m_ast, nameDispenser, 1, [&](Block& _ast, NameDispenser&) {
+				ExpressionSimplifier::run(*m_dialect, _ast);
+			});
+			stableFunctions.endRound(*m_ast);
+		}
+		// Steps across functions can change stable functions.
+		ExpressionInliner(*m_dialect, *m_ast).run();
+		UnusedPruner::runUntilStabilised(*m_dialect, *m_ast);
+		stableFunctions.checkForChanges(*m_ast);
+		// Only the functions that are not stable are split.
+		stableFunctions.runOnUnstable(*m_ast, nameDispenser, 1, [&](Block& _ast, NameDispenser& _dispenser) {
+			ExpressionSplitter{*m_dialect, _dispenser}(_ast);
+		});
+	}
 	else if (m_optimizerStep == "fullInliner")
 	{
 		disambiguate();
@@ -252,7 +277,24 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 		(BlockFlattener{})(*m_ast);
 	}
 	else if (m_optimizerStep == "fullSuite")
+	{
+		// The result must not depend on the number of threads, so optimise a second copy in parallel.
+		shared_ptr<Block> ast = m_ast;
+		shared_ptr<AsmAnalysisInfo> analysisInfo = m_analysisInfo;
+		if (!parse(_stream, _linePrefix, _formatted))
+			return false;
+		OptimiserSuite::run(m_dialect, *m_ast, *m_analysisInfo, true, {}, 4);
+		string parallelResult = AsmPrinter{m_yul}(*m_ast);
+		m_ast = ast;
+		m_analysisInfo = analysisInfo;
 		OptimiserSuite::run(m_dialect, *m_ast, *m_analysisInfo, true);
+		if (AsmPrinter{m_yul}(*m_ast) != parallelResult)
+		{
+			AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Result differs when using four threads:" << endl;
+			printIndented(_stream, parallelResult, _linePrefix + "  ");
+			return false;
+		}
+	}
 	else
 	{
 		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Invalid optimizer step: " << m_optimizerStep << endl;
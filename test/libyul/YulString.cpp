@@ -0,0 +1,113 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace yul
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(identity)
+{
+	YulString a{"abc"};
+	YulString b{string("ab") + "c"};
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != YulString{"abd"});
+	BOOST_CHECK_EQUAL(a.str(), "abc");
+	BOOST_CHECK(YulString{}.empty());
+	BOOST_CHECK(YulString{""}.empty());
+	BOOST_CHECK(!a.empty());
+}
+
+BOOST_AUTO_TEST_CASE(many_strings)
+{
+	vector<YulString> strings;
+	for (size_t i = 0; i < 5000; ++i)
+		strings.emplace_back("many_strings_" + to_string(i));
+	for (size_t i = 0; i < 5000; ++i)
+	{
+		BOOST_CHECK_EQUAL(strings[i].str(), "many_strings_" + to_string(i));
+		BOOST_CHECK(strings[i] == YulString{"many_strings_" + to_string(i)});
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_insertion)
+{
+	vector<vector<YulString>> results(4);
+	vector<thread> threads;
+	for (size_t t = 0; t < results.size(); ++t)
+		threads.emplace_back([&results, t]() {
+			for (size_t i = 0; i < 2000; ++i)
+				results[t].emplace_back("concurrent_" + to_string(i));
+		});
+	for (auto& t: threads)
+		t.join();
+	for (size_t i = 0; i < 2000; ++i)
+		for (size_t t = 0; t < results.size(); ++t)
+		{
+			BOOST_CHECK(results[t][i] == results[0][i]);
+			BOOST_CHECK_EQUAL(results[t][i].str(), "concurrent_" + to_string(i));
+		}
+}
+
+BOOST_AUTO_TEST_CASE(scope)
+{
+	YulString outer{"scoped_string"};
+	YulStringRepository const* outerRepository = &YulStringRepository::instance();
+	{
+		YulStringRepository::Scope scope;
+		BOOST_CHECK(&YulStringRepository::instance() != outerRepository);
+		YulString inner{"scoped_string"};
+		BOOST_CHECK_EQUAL(inner.str(), "scoped_string");
+		{
+			YulStringRepository::Scope nestedScope;
+			BOOST_CHECK_EQUAL(YulString{"nested"}.str(), "nested");
+		}
+		BOOST_CHECK(inner == YulString{"scoped_string"});
+	}
+	BOOST_CHECK(&YulStringRepository::instance() == outerRepository);
+	uint64_t generation = 0;
+	{
+		YulStringRepository::Scope scope;
+		generation = YulStringRepository::instance().generation();
+		BOOST_CHECK(generation > outerRepository->generation());
+	}
+	{
+		YulStringRepository::Scope scope;
+		BOOST_CHECK(YulStringRepository::instance().generation() > generation);
+	}
+	BOOST_CHECK(outer == YulString{"scoped_string"});
+	BOOST_CHECK_EQUAL(outer.str(), "scoped_string");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -20,8 +20,12 @@
 
 #include <test/tools/IsolTestOptions.h>
 #include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <string>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
 
 namespace fs = boost::filesystem;
 namespace po = boost::program_options;
@@ -53,7 +57,11 @@ IsolTestOptions::IsolTestOptions(std::string* _editor):
 	options.add_options()
 		("help", po::bool_switch(&showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor), "don't use colors")
-		("editor", po::value<std::string>(_editor)->default_value(editorPath()), "editor for opening test files");
+		("editor", po::value<std::string>(_editor)->default_value(editorPath()), "editor for opening test files")
+		("jobs,j", po::value<size_t>(&jobs)->default_value(1), "number of tests to run in parallel, 0 for one per CPU core")
+		("shard", po::value<std::string>(&shardString), "only run the i-th of n equal parts of every test suite, given as i/n")
+		("timing-report", po::value<std::string>(&timingReport), "write the wall time of every test as JSON to the given file")
+		("slowest", po::value<size_t>(&slowest)->default_value(10), "number of slowest tests listed in the timing report");
 
 }
 
@@ -67,6 +75,30 @@ bool IsolTestOptions::parse(int _argc, char const* const* _argv)
 		return false;
 	}
 
+	if (jobs == 0)
+		jobs = std::max(1u, std::thread::hardware_concurrency());
+
+	if (!shardString.empty())
+	{
+		size_t index = 0;
+		size_t count = 0;
+		auto slash = shardString.find('/');
+		try
+		{
+			if (slash != std::string::npos)
+			{
+				index = boost::lexical_cast<size_t>(shardString.substr(0, slash));
+				count = boost::lexical_cast<size_t>(shardString.substr(slash + 1));
+			}
+		}
+		catch (boost::bad_lexical_cast const&)
+		{
+		}
+		if (index == 0 || index > count)
+			throw std::runtime_error("Invalid shard: " + shardString + " (expected i/n with 1 <= i <= n)");
+		shard = TestShard{index - 1, count};
+	}
+
 	return res;
 }
 
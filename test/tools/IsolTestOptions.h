@@ -28,13 +28,32 @@ namespace dev
 namespace test
 {
 
+/// Part of every test suite that is run: the tests whose position modulo @a count is @a index.
+struct TestShard
+{
+	size_t index = 0;
+	size_t count = 1;
+
+	bool contains(size_t _position) const { return _position % count == index; }
+};
+
 struct IsolTestOptions: CommonOptions
 {
 	bool noColor = false;
 	bool showHelp = false;
+	/// Number of tests that are run concurrently.
+	size_t jobs = 1;
+	TestShard shard;
+	/// File the run times of the tests are written to, none if empty.
+	std::string timingReport;
+	/// Number of tests listed as the slowest ones in the timing report.
+	size_t slowest = 10;
 
 	IsolTestOptions(std::string* _editor);
 	bool parse(int _argc, char const* const* _argv) override;
+
+private:
+	std::string shardString;
 };
 }
 }
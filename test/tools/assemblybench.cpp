@@ -0,0 +1,233 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Measures the time spent in the optimiser and the assembler of libevmasm.
+ */
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libevmasm/Assembly.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace langutil;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Adds the Solidity files at or below @a _path to @a _sources.
+void collectSources(fs::path const& _path, StringMap& _sources)
+{
+	if (fs::is_directory(_path))
+	{
+		for (auto const& entry: fs::recursive_directory_iterator(_path))
+			if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+				_sources[entry.path().string()] = readFileAsString(entry.path().string());
+	}
+	else
+		_sources[_path.string()] = readFileAsString(_path.string());
+}
+
+/// Copy of an assembly that does not share its sub-assemblies with the original,
+/// so that it can be optimised without modifying the original.
+class AssemblyCopy: public eth::Assembly
+{
+public:
+	explicit AssemblyCopy(eth::Assembly const& _assembly): eth::Assembly(_assembly)
+	{
+		m_numberOfItems = m_items.size();
+		for (auto& sub: m_subs)
+		{
+			auto subCopy = make_shared<AssemblyCopy>(*sub);
+			m_numberOfItems += subCopy->numberOfItems();
+			sub = move(subCopy);
+		}
+	}
+
+	/// @returns the number of items of this assembly and all its sub-assemblies.
+	size_t numberOfItems() const { return m_numberOfItems; }
+
+private:
+	size_t m_numberOfItems = 0;
+};
+
+/// Compiles @a _contract and the contracts it creates without optimisation.
+/// The contract has to be deployable.
+shared_ptr<Compiler const> compile(
+	ContractDefinition const& _contract,
+	EVMVersion _evmVersion,
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _compilers
+)
+{
+	if (_compilers.count(&_contract))
+		return _compilers.at(&_contract);
+	// Contracts created in base contracts are only listed as dependencies of the base.
+	for (ContractDefinition const* base: _contract.annotation().linearizedBaseContracts)
+		for (ContractDefinition const* dependency: base->annotation().contractDependencies)
+			if (dependency->canBeDeployed())
+				compile(*dependency, _evmVersion, _compilers);
+	auto compiler = make_shared<Compiler>(_evmVersion, OptimiserSettings::none());
+	compiler->compileContract(_contract, _compilers, bytes());
+	_compilers[&_contract] = compiler;
+	return compiler;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(assemblybench, measures the speed of the EVM assembly optimiser and assembler.
+Usage: assemblybench [Options] <path>...
+Compiles all Solidity files at or below the given paths without optimisation and
+then optimises and assembles copies of the assemblies of all contracts repeatedly.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"input-path",
+			po::value<vector<string>>(),
+			"input file or directory"
+		)
+		(
+			"repeat",
+			po::value<unsigned>()->default_value(5),
+			"Number of times the assemblies are optimised and assembled."
+		)
+		(
+			"runs",
+			po::value<size_t>()->default_value(200),
+			"Expected number of executions per deployment used by the optimiser."
+		)
+		("peephole-only", "Only run the peephole optimiser.")
+		("help", "Show this help screen.");
+
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-path", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-path"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	StringMap sources;
+	for (string const& path: arguments["input-path"].as<vector<string>>())
+		collectSources(path, sources);
+
+	EVMVersion const evmVersion;
+	CompilerStack compilerStack([](string const& _path) {
+		try
+		{
+			return ReadCallback::Result{true, readFileAsString(_path)};
+		}
+		catch (...)
+		{
+			return ReadCallback::Result{false, "Could not read " + _path};
+		}
+	});
+	compilerStack.setSources(sources);
+	compilerStack.setEVMVersion(evmVersion);
+	if (!compilerStack.parseAndAnalyze())
+	{
+		SourceReferenceFormatter formatter(cerr);
+		for (auto const& error: compilerStack.errors())
+			formatter.printExceptionInformation(*error, "Error");
+		return 1;
+	}
+
+	map<ContractDefinition const*, shared_ptr<Compiler const>> compilers;
+	vector<shared_ptr<eth::Assembly>> assemblies;
+	for (string const& sourceName: compilerStack.sourceNames())
+		for (auto const* contract: ASTNode::filteredNodes<ContractDefinition>(compilerStack.ast(sourceName).nodes()))
+			if (contract->canBeDeployed())
+				assemblies.emplace_back(compile(*contract, evmVersion, compilers)->assemblyPtr());
+
+	eth::Assembly::OptimiserSettings settings;
+	settings.isCreation = true;
+	settings.runPeephole = true;
+	if (!arguments.count("peephole-only"))
+	{
+		settings.runJumpdestRemover = true;
+		settings.runDeduplicate = true;
+		settings.runCSE = true;
+		settings.runConstantOptimiser = true;
+	}
+	settings.evmVersion = evmVersion;
+	settings.expectedExecutionsPerDeployment = arguments["runs"].as<size_t>();
+
+	size_t items = 0;
+	double optimiseSeconds = 0;
+	double assembleSeconds = 0;
+	unsigned const repeat = arguments["repeat"].as<unsigned>();
+	for (unsigned i = 0; i < repeat; ++i)
+		for (auto const& assembly: assemblies)
+		{
+			AssemblyCopy copy(*assembly);
+			if (i == 0)
+				items += copy.numberOfItems();
+			auto start = chrono::steady_clock::now();
+			copy.optimise(settings);
+			auto optimised = chrono::steady_clock::now();
+			copy.assemble();
+			auto assembled = chrono::steady_clock::now();
+			optimiseSeconds += chrono::duration<double>(optimised - start).count();
+			assembleSeconds += chrono::duration<double>(assembled - optimised).count();
+		}
+
+	cout << assemblies.size() << " contracts, " << items << " assembly items" << endl;
+	cout << "Optimised and assembled " << repeat << " times." << endl;
+	cout << "Optimiser: " << (repeat > 0 ? optimiseSeconds / repeat * 1000 : 0) << " ms per run" << endl;
+	cout << "Assembler: " << (repeat > 0 ? assembleSeconds / repeat * 1000 : 0) << " ms per run" << endl;
+	return 0;
+}
@@ -17,6 +17,8 @@
 
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/AnsiColorized.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/Parallel.h>
 
 #include <test/Common.h>
 #include <test/tools/IsolTestOptions.h>
@@ -28,10 +30,16 @@
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <mutex>
 #include <queue>
+#include <thread>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -42,20 +50,32 @@ using namespace dev::solidity;
 using namespace dev::solidity::test;
 using namespace dev::formatting;
 using namespace std;
+using dev::test::TestShard;
 namespace po = boost::program_options;
 namespace fs = boost::filesystem;
 
+struct TestTiming
+{
+	string suite;
+	string path;
+	string result;
+	double milliseconds = 0;
+};
+
 struct TestStats
 {
 	int successCount = 0;
 	int testCount = 0;
 	int skippedCount = 0;
+	/// Wall time of the first run of every test that was run.
+	vector<TestTiming> timings;
 	operator bool() const noexcept { return successCount + skippedCount == testCount; }
-	TestStats& operator+=(TestStats const& _other) noexcept
+	TestStats& operator+=(TestStats const& _other)
 	{
 		successCount += _other.successCount;
 		testCount += _other.testCount;
 		skippedCount += _other.skippedCount;
+		timings += _other.timings;
 		return *this;
 	}
 };
@@ -68,9 +88,10 @@ public:
 		string const& _name,
 		fs::path const& _path,
 		string const& _ipcPath,
+		bool _internalEVM,
 		bool _formatted,
 		langutil::EVMVersion _evmVersion
-	): m_testCaseCreator(_testCaseCreator), m_name(_name), m_path(_path), m_ipcPath(_ipcPath), m_formatted(_formatted), m_evmVersion(_evmVersion)
+	): m_testCaseCreator(_testCaseCreator), m_name(_name), m_path(_path), m_ipcPath(_ipcPath), m_internalEVM(_internalEVM), m_formatted(_formatted), m_evmVersion(_evmVersion)
 	{}
 
 	enum class Result
@@ -81,15 +102,22 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test and writes its result to @a _stream.
+	Result process(ostream& _stream);
 
+	/// Runs the tests of @a _shard below @a _path, up to @a _jobs of them at the same time.
+	/// The results are printed in the order of the tests and failures are handled
+	/// interactively one after the other.
 	static TestStats processPath(
 		TestCase::TestCaseCreator _testCaseCreator,
 		fs::path const& _basepath,
 		fs::path const& _path,
 		string const& _ipcPath,
+		bool _internalEVM,
 		bool _formatted,
-		langutil::EVMVersion _evmVersion
+		langutil::EVMVersion _evmVersion,
+		size_t _jobs,
+		TestShard const& _shard
 	);
 
 	static string editor;
@@ -103,69 +131,79 @@ private:
 
 	Request handleResponse(bool _exception);
 
+	/// @returns the paths of the tests of @a _shard below @a _path relative to @a _basepath.
+	/// Directories are traversed breadth-first in sorted order, so that the shards do not
+	/// depend on the file system.
+	static vector<fs::path> collectTestPaths(
+		fs::path const& _basepath,
+		fs::path const& _path,
+		TestShard const& _shard
+	);
+
 	TestCase::TestCaseCreator m_testCaseCreator;
 	string const m_name;
 	fs::path const m_path;
 	string m_ipcPath;
+	bool const m_internalEVM = false;
 	bool const m_formatted = false;
 	langutil::EVMVersion const m_evmVersion;
 	unique_ptr<TestCase> m_test;
-	static bool m_exitRequested;
+	static atomic<bool> m_exitRequested;
 };
 
 string TestTool::editor;
-bool TestTool::m_exitRequested = false;
+atomic<bool> TestTool::m_exitRequested{false};
 
-TestTool::Result TestTool::process()
+TestTool::Result TestTool::process(ostream& _stream)
 {
 	bool success;
 	std::stringstream outputMessages;
 
-	(AnsiColorized(cout, m_formatted, {BOLD}) << m_name << ": ").flush();
+	(AnsiColorized(_stream, m_formatted, {BOLD}) << m_name << ": ").flush();
 
 	try
 	{
-		m_test = m_testCaseCreator(TestCase::Config{m_path.string(), m_ipcPath, m_evmVersion});
+		m_test = m_testCaseCreator(TestCase::Config{m_path.string(), m_ipcPath, m_evmVersion, m_internalEVM});
 		if (m_test->supportedForEVMVersion(m_evmVersion))
 			success = m_test->run(outputMessages, "  ", m_formatted);
 		else
 		{
-			AnsiColorized(cout, m_formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
+			AnsiColorized(_stream, m_formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 			return Result::Skipped;
 		}
 	}
 	catch(boost::exception const& _e)
 	{
-		AnsiColorized(cout, m_formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, m_formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, m_formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, m_formatted, {BOLD, RED}) <<
 			"Exception during test: " << _e.what() << endl;
 		return Result::Exception;
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, m_formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, m_formatted, {BOLD, RED}) <<
 			"Unknown exception during test." << endl;
 		return Result::Exception;
 	}
 
 	if (success)
 	{
-		AnsiColorized(cout, m_formatted, {BOLD, GREEN}) << "OK" << endl;
+		AnsiColorized(_stream, m_formatted, {BOLD, GREEN}) << "OK" << endl;
 		return Result::Success;
 	}
 	else
 	{
-		AnsiColorized(cout, m_formatted, {BOLD, RED}) << "FAIL" << endl;
+		AnsiColorized(_stream, m_formatted, {BOLD, RED}) << "FAIL" << endl;
 
-		AnsiColorized(cout, m_formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-		m_test->printSource(cout, "    ", m_formatted);
+		AnsiColorized(_stream, m_formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+		m_test->printSource(_stream, "    ", m_formatted);
 
-		cout << endl << outputMessages.str() << endl;
+		_stream << endl << outputMessages.str() << endl;
 		return Result::Failure;
 	}
 }
@@ -211,81 +249,162 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 	}
 }
 
-TestStats TestTool::processPath(
-	TestCase::TestCaseCreator _testCaseCreator,
+vector<fs::path> TestTool::collectTestPaths(
 	fs::path const& _basepath,
 	fs::path const& _path,
-	string const& _ipcPath,
-	bool _formatted,
-	langutil::EVMVersion _evmVersion
+	TestShard const& _shard
 )
 {
 	std::queue<fs::path> paths;
 	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-	int skippedCount = 0;
+	vector<fs::path> testPaths;
+	size_t position = 0;
 
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
+			vector<fs::path> entries;
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
 			))
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
-					paths.push(currentPath / entry.path().filename());
+					entries.push_back(entry.path().filename());
+			sort(entries.begin(), entries.end());
+			for (auto const& entry: entries)
+				paths.push(currentPath / entry);
 		}
-		else if (m_exitRequested)
+		else if (_shard.contains(position++))
+			testPaths.push_back(currentPath);
+	}
+
+	return testPaths;
+}
+
+TestStats TestTool::processPath(
+	TestCase::TestCaseCreator _testCaseCreator,
+	fs::path const& _basepath,
+	fs::path const& _path,
+	string const& _ipcPath,
+	bool _internalEVM,
+	bool _formatted,
+	langutil::EVMVersion _evmVersion,
+	size_t _jobs,
+	TestShard const& _shard
+)
+{
+	struct Run
+	{
+		unique_ptr<TestTool> testTool;
+		Result result = Result::Skipped;
+		/// Output of the test if it was run by the pool.
+		string output;
+		double milliseconds = 0;
+		bool finished = false;
+	};
+
+	vector<fs::path> const testPaths = collectTestPaths(_basepath, _path, _shard);
+	vector<Run> runs(testPaths.size());
+	mutex runsMutex;
+	condition_variable runFinished;
+
+	auto execute = [&](size_t _index, ostream& _stream)
+	{
+		Run& run = runs[_index];
+		run.testTool = make_unique<TestTool>(
+			_testCaseCreator,
+			testPaths[_index].string(),
+			_basepath / testPaths[_index],
+			_ipcPath,
+			_internalEVM,
+			_formatted,
+			_evmVersion
+		);
+		auto start = chrono::steady_clock::now();
+		run.result = run.testTool->process(_stream);
+		run.milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	};
+
+	// The pool runs the tests ahead of the loop below, which prints their results in order.
+	thread pool;
+	if (_jobs > 1)
+		pool = thread([&]() {
+			parallelFor(runs.size(), _jobs, [&](size_t _index) {
+				if (!m_exitRequested)
+				{
+					ostringstream output;
+					execute(_index, output);
+					runs[_index].output = output.str();
+				}
+				lock_guard<mutex> lock(runsMutex);
+				runs[_index].finished = true;
+				runFinished.notify_all();
+			});
+		});
+
+	TestStats stats;
+	for (size_t i = 0; i < runs.size(); ++i)
+	{
+		++stats.testCount;
+		if (m_exitRequested)
+			continue;
+
+		Run& run = runs[i];
+		if (pool.joinable())
 		{
-			++testCount;
-			paths.pop();
+			unique_lock<mutex> lock(runsMutex);
+			runFinished.wait(lock, [&]() { return run.finished; });
+			cout << run.output;
+			cout.flush();
 		}
 		else
+			execute(i, cout);
+
+		Result result = run.result;
+		stats.timings.push_back({
+			"",
+			testPaths[i].string(),
+			result == Result::Success ? "success" :
+			result == Result::Failure ? "failure" :
+			result == Result::Exception ? "exception" :
+			"skipped",
+			run.milliseconds
+		});
+
+		while (result == Result::Failure || result == Result::Exception)
 		{
-			++testCount;
-			TestTool testTool(_testCaseCreator, currentPath.string(), fullpath, _ipcPath, _formatted, _evmVersion);
-			auto result = testTool.process();
-
-			switch(result)
+			switch (run.testTool->handleResponse(result == Result::Exception))
 			{
-			case Result::Failure:
-			case Result::Exception:
-				switch(testTool.handleResponse(result == Result::Exception))
-				{
-				case Request::Quit:
-					paths.pop();
-					m_exitRequested = true;
-					break;
-				case Request::Rerun:
-					cout << "Re-running test case..." << endl;
-					--testCount;
-					break;
-				case Request::Skip:
-					paths.pop();
-					++skippedCount;
-					break;
-				}
-				break;
-			case Result::Success:
-				paths.pop();
-				++successCount;
+			case Request::Quit:
+				m_exitRequested = true;
 				break;
-			case Result::Skipped:
-				paths.pop();
-				++skippedCount;
+			case Request::Rerun:
+				cout << "Re-running test case..." << endl;
+				result = run.testTool->process(cout);
+				continue;
+			case Request::Skip:
+				++stats.skippedCount;
 				break;
 			}
+			break;
 		}
+
+		if (result == Result::Success)
+			++stats.successCount;
+		else if (result == Result::Skipped)
+			++stats.skippedCount;
+		run = Run{};
 	}
 
-	return { successCount, testCount, skippedCount };
+	if (pool.joinable())
+		pool.join();
 
+	return stats;
 }
 
 namespace
@@ -316,9 +435,12 @@ boost::optional<TestStats> runTestSuite(
 	fs::path const& _basePath,
 	fs::path const& _subdirectory,
 	string const& _ipcPath,
+	bool _internalEVM,
 	TestCase::TestCaseCreator _testCaseCreator,
 	bool _formatted,
-	langutil::EVMVersion _evmVersion
+	langutil::EVMVersion _evmVersion,
+	size_t _jobs,
+	TestShard const& _shard
 )
 {
 	fs::path testPath = _basePath / _subdirectory;
@@ -329,7 +451,19 @@ boost::optional<TestStats> runTestSuite(
 		return {};
 	}
 
-	TestStats stats = TestTool::processPath(_testCaseCreator, _basePath, _subdirectory, _ipcPath, _formatted, _evmVersion);
+	TestStats stats = TestTool::processPath(
+		_testCaseCreator,
+		_basePath,
+		_subdirectory,
+		_ipcPath,
+		_internalEVM,
+		_formatted,
+		_evmVersion,
+		_jobs,
+		_shard
+	);
+	for (auto& timing: stats.timings)
+		timing.suite = _name;
 
 	cout << endl << _name << " Test Summary: ";
 	AnsiColorized(cout, _formatted, {BOLD, stats ? GREEN : RED}) <<
@@ -348,6 +482,52 @@ boost::optional<TestStats> runTestSuite(
 	return stats;
 }
 
+Json::Value toJson(TestTiming const& _timing)
+{
+	Json::Value test(Json::objectValue);
+	test["suite"] = _timing.suite;
+	test["path"] = _timing.path;
+	test["result"] = _timing.result;
+	test["milliseconds"] = _timing.milliseconds;
+	return test;
+}
+
+bool writeTimingReport(
+	string const& _file,
+	vector<TestTiming> const& _timings,
+	double _totalMilliseconds,
+	dev::test::IsolTestOptions const& _options
+)
+{
+	Json::Value report(Json::objectValue);
+	report["jobs"] = Json::UInt64(_options.jobs);
+	report["shard"]["index"] = Json::UInt64(_options.shard.index + 1);
+	report["shard"]["count"] = Json::UInt64(_options.shard.count);
+	report["totalMilliseconds"] = _totalMilliseconds;
+
+	report["tests"] = Json::arrayValue;
+	for (auto const& timing: _timings)
+		report["tests"].append(toJson(timing));
+
+	vector<TestTiming const*> slowest;
+	for (auto const& timing: _timings)
+		slowest.push_back(&timing);
+	size_t const slowestCount = min(_options.slowest, slowest.size());
+	partial_sort(
+		slowest.begin(),
+		slowest.begin() + slowestCount,
+		slowest.end(),
+		[](TestTiming const* _a, TestTiming const* _b) { return _a->milliseconds > _b->milliseconds; }
+	);
+	report["slowest"] = Json::arrayValue;
+	for (size_t i = 0; i < slowestCount; ++i)
+		report["slowest"].append(toJson(*slowest[i]));
+
+	ofstream file(_file, ios::trunc);
+	file << jsonPrettyPrint(report) << endl;
+	return bool(file);
+}
+
 }
 
 int main(int argc, char const *argv[])
@@ -370,6 +550,7 @@ int main(int argc, char const *argv[])
 	}
 
 	TestStats global_stats{0, 0};
+	auto start = chrono::steady_clock::now();
 
 	// Actually run the tests.
 	// Interactive tests are added in InteractiveTests.h
@@ -381,7 +562,19 @@ int main(int argc, char const *argv[])
 		if (ts.smt && options.disableSMT)
 			continue;
 
-		if (auto stats = runTestSuite(ts.title, options.testPath / ts.path, ts.subpath, options.ipcPath.string(), ts.testCaseCreator, !options.noColor, options.evmVersion()))
+		if (auto stats = runTestSuite(
+			ts.title,
+			options.testPath / ts.path,
+			ts.subpath,
+			options.ipcPath.string(),
+			options.internalEVM,
+			ts.testCaseCreator,
+			!options.noColor,
+			options.evmVersion(),
+			// The tests using the external client share its chain and cannot run concurrently.
+			ts.ipc && !options.internalEVM ? 1 : options.jobs,
+			options.shard
+		))
 			global_stats += *stats;
 		else
 			return 1;
@@ -399,5 +592,15 @@ int main(int argc, char const *argv[])
 	}
 	cout << "." << endl;
 
+	if (!options.timingReport.empty())
+	{
+		double totalMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		if (!writeTimingReport(options.timingReport, global_stats.timings, totalMilliseconds, options))
+		{
+			cerr << "Could not write the timing report to " << options.timingReport << "." << endl;
+			return 1;
+		}
+	}
+
 	return global_stats ? 0 : 1;
 }
@@ -0,0 +1,253 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Counts the pattern matches tried when looking up simplification rules for the expressions
+ * of strict assembly code, with the operand shape index and with a linear scan over the
+ * rules of the root instruction.
+ */
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/AsmData.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/optimiser/SimplificationRules.h>
+
+#include <libevmasm/RuleList.h>
+#include <libevmasm/SimplificationRuleIndex.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::solidity;
+using namespace langutil;
+using namespace yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+OperandShape operandShape(yul::Pattern const& _pattern)
+{
+	switch (_pattern.kind())
+	{
+	case PatternKind::Operation:
+		return OperandShape::operation(_pattern.instruction());
+	case PatternKind::Constant:
+		return OperandShape::constant();
+	default:
+		return OperandShape::any();
+	}
+}
+
+/// @returns the shape of @a _expr in the same way as the Yul simplification rules.
+OperandShape operandShape(Expression const& _expr, map<YulString, Expression const*> const& _ssaValues)
+{
+	Expression const* expr = &_expr;
+	if (_expr.type() == typeid(Identifier))
+	{
+		auto value = _ssaValues.find(boost::get<Identifier>(_expr).name);
+		if (value != _ssaValues.end() && value->second)
+			expr = value->second;
+	}
+	if (expr->type() == typeid(Literal) && boost::get<Literal>(*expr).kind == LiteralKind::Number)
+		return OperandShape::constant();
+	else if (expr->type() == typeid(FunctionalInstruction))
+		return OperandShape::operation(boost::get<FunctionalInstruction>(*expr).instruction);
+	else
+		return OperandShape::any();
+}
+
+/// Looks up the rules for every operation in the code, once through the index and once by
+/// trying all rules for the root instruction in order, and counts the pattern matches tried.
+class RuleCounter: public ASTWalker, boost::noncopyable
+{
+public:
+	using ASTWalker::operator();
+
+	explicit RuleCounter(Dialect const& _dialect): m_dialect(_dialect)
+	{
+		yul::Pattern A(PatternKind::Constant);
+		yul::Pattern B(PatternKind::Constant);
+		yul::Pattern C(PatternKind::Constant);
+		yul::Pattern X;
+		yul::Pattern Y;
+		A.setMatchGroup(1, m_matchGroups);
+		B.setMatchGroup(2, m_matchGroups);
+		C.setMatchGroup(3, m_matchGroups);
+		X.setMatchGroup(4, m_matchGroups);
+		Y.setMatchGroup(5, m_matchGroups);
+		for (auto const& rule: simplificationRuleList(A, B, C, X, Y))
+		{
+			SimplificationRuleIndex<yul::Pattern>::Shapes operands;
+			vector<yul::Pattern> arguments = rule.pattern.arguments();
+			for (size_t i = 0; i < arguments.size(); ++i)
+				operands[i] = operandShape(arguments[i]);
+			m_index.add(rule.pattern.instruction(), rule, operands);
+			m_linear[uint8_t(rule.pattern.instruction())].push_back(rule);
+		}
+	}
+
+	void count(Block const& _block)
+	{
+		SSAValueTracker ssaValues;
+		ssaValues(_block);
+		m_ssaValues = &ssaValues.values();
+		(*this)(_block);
+		m_ssaValues = nullptr;
+	}
+
+	void operator()(FunctionalInstruction const& _instruction) override
+	{
+		ASTWalker::operator()(_instruction);
+
+		Expression expression = _instruction;
+		auto tryRule = [&](SimplificationRule<yul::Pattern> const& _rule) {
+			m_matchGroups.clear();
+			return _rule.pattern.matches(expression, m_dialect, *m_ssaValues) && (!_rule.feasible || _rule.feasible());
+		};
+
+		lookups++;
+		SimplificationRuleIndex<yul::Pattern>::Shapes operands;
+		for (size_t i = 0; i < _instruction.arguments.size() && i < operands.size(); ++i)
+			operands[i] = operandShape(_instruction.arguments[i], *m_ssaValues);
+		bool indexMatch = m_index.findFirst(_instruction.instruction, operands, [&](SimplificationRule<yul::Pattern> const& _rule) {
+			indexAttempts++;
+			return tryRule(_rule);
+		}) != nullptr;
+
+		bool linearMatch = false;
+		for (auto const& rule: m_linear[uint8_t(_instruction.instruction)])
+		{
+			linearAttempts++;
+			if ((linearMatch = tryRule(rule)))
+				break;
+		}
+		if (indexMatch != linearMatch)
+			mismatches++;
+		if (indexMatch)
+			matches++;
+	}
+
+	size_t lookups = 0;
+	size_t matches = 0;
+	size_t mismatches = 0;
+	size_t indexAttempts = 0;
+	size_t linearAttempts = 0;
+
+private:
+	Dialect const& m_dialect;
+	map<unsigned, Expression const*> m_matchGroups;
+	SimplificationRuleIndex<yul::Pattern> m_index;
+	vector<SimplificationRule<yul::Pattern>> m_linear[256];
+	map<YulString, Expression const*> const* m_ssaValues = nullptr;
+};
+
+void countObject(Object const& _object, Dialect const& _dialect, RuleCounter& _counter)
+{
+	Block code = boost::get<Block>(Disambiguator(_dialect, *_object.analysisInfo)(*_object.code));
+	_counter.count(code);
+	for (auto const& subNode: _object.subObjects)
+		if (auto subObject = dynamic_pointer_cast<Object>(subNode))
+			countObject(*subObject, _dialect, _counter);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(rulematchbench, counts the pattern matches tried to find simplification rules.
+Usage: rulematchbench [Options] <file>...
+Parses and analyses the given strict assembly files and looks up the simplification rules
+for every operation, using the operand shape index and a linear scan over all rules of the
+instruction. Files that are not valid strict assembly are skipped.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"input-file",
+			po::value<vector<string>>(),
+			"input file"
+		)
+		("help", "Show this help screen.");
+
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	EVMVersion const evmVersion;
+	shared_ptr<EVMDialect> dialect = EVMDialect::strictAssemblyForEVMObjects(evmVersion);
+	RuleCounter counter(*dialect);
+	size_t files = 0;
+	size_t skipped = 0;
+	for (string const& path: arguments["input-file"].as<vector<string>>())
+	{
+		AssemblyStack stack(evmVersion, AssemblyStack::Language::StrictAssembly, OptimiserSettings::none());
+		if (!stack.parseAndAnalyze(path, readFileAsString(path)))
+		{
+			skipped++;
+			continue;
+		}
+		files++;
+		countObject(*stack.parserResult(), *dialect, counter);
+	}
+
+	cout << files << " files (" << skipped << " skipped), " << counter.lookups << " lookups, ";
+	cout << counter.matches << " matching" << endl;
+	cout << "Pattern matches tried with index: " << counter.indexAttempts << endl;
+	cout << "Pattern matches tried with linear scan: " << counter.linearAttempts << endl;
+	if (counter.mismatches > 0)
+	{
+		cerr << counter.mismatches << " lookups found a rule only with one of the methods." << endl;
+		return 1;
+	}
+	return 0;
+}
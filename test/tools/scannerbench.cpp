@@ -0,0 +1,129 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Measures the throughput of the scanner.
+ */
+
+#include <libdevcore/CommonIO.h>
+#include <liblangutil/Scanner.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace langutil;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Adds the Solidity files at or below @a _path to @a _sources.
+void collectSources(fs::path const& _path, vector<pair<string, string>>& _sources)
+{
+	if (fs::is_directory(_path))
+	{
+		for (auto const& entry: fs::recursive_directory_iterator(_path))
+			if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+				_sources.emplace_back(entry.path().string(), readFileAsString(entry.path().string()));
+	}
+	else
+		_sources.emplace_back(_path.string(), readFileAsString(_path.string()));
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(scannerbench, measures the throughput of the Solidity scanner.
+Usage: scannerbench [Options] <path>...
+Scans all Solidity files at or below the given paths repeatedly
+and reports the number of bytes and tokens processed per second.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"input-path",
+			po::value<vector<string>>(),
+			"input file or directory"
+		)
+		(
+			"repeat",
+			po::value<unsigned>()->default_value(20),
+			"Number of times the sources are scanned."
+		)
+		("help", "Show this help screen.");
+
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-path", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-path"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<pair<string, string>> sources;
+	for (string const& path: arguments["input-path"].as<vector<string>>())
+		collectSources(path, sources);
+
+	size_t bytes = 0;
+	size_t tokens = 0;
+	unsigned const repeat = arguments["repeat"].as<unsigned>();
+	auto start = chrono::steady_clock::now();
+	for (unsigned i = 0; i < repeat; ++i)
+		for (auto const& source: sources)
+		{
+			Scanner scanner(CharStream(source.second, source.first));
+			while (scanner.currentToken() != Token::EOS)
+			{
+				scanner.next();
+				tokens++;
+			}
+			bytes += source.second.size();
+		}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	cout << sources.size() << " files, " << bytes / repeat << " bytes, " << tokens / repeat << " tokens" << endl;
+	cout << "Scanned " << repeat << " times in " << seconds << " s: ";
+	cout << (seconds > 0 ? double(bytes) / seconds / 1e6 : 0) << " MB/s, ";
+	cout << (seconds > 0 ? double(tokens) / seconds / 1e6 : 0) << " million tokens/s" << endl;
+	return 0;
+}
@@ -0,0 +1,170 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Measures the time spent in the code transform from strict assembly to EVM assembly.
+ */
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/AsmCodeGen.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMObjectCompiler.h>
+
+#include <libevmasm/Assembly.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace langutil;
+using namespace yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// @returns strict assembly code consisting of @a _functions functions that call each
+/// other and use variables, switches and loops.
+string generateCode(unsigned _functions)
+{
+	string code = "{\n";
+	for (unsigned i = 0; i < _functions; ++i)
+	{
+		string const index = to_string(i);
+		code +=
+			"\tfunction f" + index + "(a, b) -> r {\n"
+			"\t\tlet x := add(a, " + index + ")\n"
+			"\t\tlet y := mul(x, b)\n"
+			"\t\tswitch and(y, 3)\n" +
+			(i > 0 ? "\t\tcase 0 { r := f" + to_string(i - 1) + "(x, y) }\n" : string()) +
+			"\t\tcase 1 { r := sub(y, x) }\n"
+			"\t\tdefault { for { let j := 0 } lt(j, a) { j := add(j, 1) } { r := add(r, j) } }\n"
+			"\t}\n";
+	}
+	if (_functions > 0)
+		code += "\tmstore(0, f" + to_string(_functions - 1) + "(calldataload(0), calldataload(32)))\n";
+	code += "}\n";
+	return code;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yulcodegenbench, measures the speed of the code generation from strict assembly to EVM assembly.
+Usage: yulcodegenbench [Options] [<file>...]
+Parses and analyses the given files, or generated code if no files are given,
+and translates them to EVM assembly repeatedly.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"input-file",
+			po::value<vector<string>>(),
+			"input file"
+		)
+		(
+			"functions",
+			po::value<unsigned>()->default_value(5000),
+			"Number of functions in the generated code."
+		)
+		(
+			"repeat",
+			po::value<unsigned>()->default_value(10),
+			"Number of times the code is translated."
+		)
+		("optimize-stack-allocation", "Reuse stack slots of variables that are no longer used.")
+		("help", "Show this help screen.");
+
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<pair<string, string>> sources;
+	if (arguments.count("input-file"))
+		for (string const& path: arguments["input-file"].as<vector<string>>())
+			sources.emplace_back(path, readFileAsString(path));
+	else
+		sources.emplace_back("<generated>", generateCode(arguments["functions"].as<unsigned>()));
+
+	EVMVersion const evmVersion;
+	bool const optimizeStackAllocation = arguments.count("optimize-stack-allocation");
+	vector<shared_ptr<Object>> objects;
+	for (auto const& source: sources)
+	{
+		AssemblyStack stack(evmVersion, AssemblyStack::Language::StrictAssembly, OptimiserSettings::none());
+		if (!stack.parseAndAnalyze(source.first, source.second))
+		{
+			SourceReferenceFormatter formatter(cerr);
+			for (auto const& error: stack.errors())
+				formatter.printExceptionInformation(*error, "Error");
+			return 1;
+		}
+		objects.emplace_back(stack.parserResult());
+	}
+
+	size_t items = 0;
+	unsigned const repeat = arguments["repeat"].as<unsigned>();
+	auto start = chrono::steady_clock::now();
+	for (unsigned i = 0; i < repeat; ++i)
+		for (auto const& object: objects)
+		{
+			shared_ptr<EVMDialect> dialect = EVMDialect::strictAssemblyForEVMObjects(evmVersion);
+			eth::Assembly assembly;
+			EthAssemblyAdapter adapter(assembly);
+			EVMObjectCompiler::compile(*object, adapter, *dialect, false, optimizeStackAllocation);
+			items += assembly.items().size();
+		}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	cout << objects.size() << " objects, " << items / max(repeat, 1u) << " assembly items" << endl;
+	cout << "Translated " << repeat << " times in " << seconds << " s: ";
+	cout << (repeat > 0 ? seconds / repeat * 1000 : 0) << " ms per translation" << endl;
+	return 0;
+}